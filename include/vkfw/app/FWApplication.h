@@ -9,8 +9,15 @@
 #pragma once
 
 #include <app/ApplicationBase.h>
-#include "app/SimpleScene.h"
-#include "app/RaytracingScene.h"
+#include "app/Scene.h"
+#include "app/MeshCache.h"
+#include "app/TextureCache.h"
+#include "app/RenderTarget.h"
+#include "gfx/GPUTimeline.h"
+#include "gfx/PipelineCache.h"
+
+#include <array>
+#include <memory>
 
 namespace vkfw_core::gfx {
     class UserControlledCamera;
@@ -18,6 +25,9 @@ namespace vkfw_core::gfx {
 
 namespace vkfw_app {
 
+    /** Returns the device features chain needed by the scenes of this application. */
+    void* GetDeviceFeaturesNextChain();
+
     class FWApplication final : public vkfw_core::ApplicationBase
     {
     public:
@@ -30,12 +40,41 @@ namespace vkfw_app {
         void Resize(const glm::uvec2& screenSize, vkfw_core::VKWindow* window) override;
 
     private:
+        /** The number of selectable scenes. */
+        static constexpr std::size_t NUM_SCENES = 2;
+
+        /** Returns the scene with the given index (see m_scene_to_render), the scene is created on first use. */
+        scene::Scene* GetScene(int sceneIndex);
+        /** Destroys all scenes but the active one, the CPU side mesh data stays in the mesh cache. */
+        void EvictInactiveScenes();
+        /** Applies the minimal update for a change of scene or parameters. */
+        void ApplySceneChange(scene::SceneChange change, vkfw_core::VKWindow* window);
+        /** Records the primary command buffers of the window for the current scene. */
+        void RecordCommandBuffers(vkfw_core::VKWindow* window);
+
         /** The camera model used. */
         std::unique_ptr<vkfw_core::gfx::UserControlledCamera> m_camera;
 
+        /** The render target wrapping the main windows swapchain. */
+        WindowRenderTarget m_windowTarget;
+        /** The GPU timeline regions of the scenes are recorded to. */
+        std::unique_ptr<gfx::GPUTimeline> m_gpuTimeline;
+        /** The pipeline cache shared by all scenes, saved on exit. */
+        std::unique_ptr<gfx::PipelineCache> m_pipelineCache;
+
+        /** The imported meshes shared by all scenes. */
+        scene::MeshCache m_meshCache;
+        /** The precompiled textures shared by all scenes. */
+        scene::TextureCache m_textureCache;
         int m_scene_to_render = 1;
-        scene::simple::SimpleScene m_simple_scene;
-        scene::rt::RaytracingScene m_rt_scene;
+        /** The scenes, only created when they are activated. */
+        std::array<std::unique_ptr<scene::Scene>, NUM_SCENES> m_scenes;
+        /** Whether inactive scenes release their GPU resources. */
+        bool m_evictInactiveScenes = true;
+        /** The current size of the main windows framebuffers. */
+        glm::uvec2 m_screenSize = glm::uvec2{0};
+        /** The screen size the pipelines of each scene were created for (zero if not created). */
+        std::array<glm::uvec2, NUM_SCENES> m_scenePipelineSizes = {glm::uvec2{0}, glm::uvec2{0}};
 
     protected:
         void FrameMove(float time, float elapsed, vkfw_core::VKWindow* window) override;
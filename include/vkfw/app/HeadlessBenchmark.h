@@ -0,0 +1,158 @@
+/**
+ * @file   HeadlessBenchmark.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Renders a scene without window or swapchain for a fixed number of frames and reports timings.
+ */
+
+#pragma once
+
+#include "app/OffscreenRenderTarget.h"
+#include "app/MeshCache.h"
+#include "app/StressScene.h"
+#include "app/TextureCache.h"
+#include "gfx/GPUTimeline.h"
+#include "gfx/PipelineCache.h"
+
+#include <glm/vec2.hpp>
+#include <vulkan/vulkan.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vkfw_core::gfx {
+    class LogicalDevice;
+    class UserControlledCamera;
+}
+
+namespace vkfw_app::scene {
+    class Scene;
+}
+
+namespace vkfw_app::scene::rt {
+    class RaytracingScene;
+}
+
+namespace vkfw_app {
+
+    enum class BenchmarkScene
+    {
+        Simple,
+        RayTracing
+    };
+
+    enum class BenchmarkIntegrator
+    {
+        AmbientOcclusion,
+        PathTracingMegakernel,
+        PathTracingWavefront,
+        AmbientOcclusionRayQuery
+    };
+
+    enum class BenchmarkSampler
+    {
+        Random,
+        Sobol,
+        BlueNoise
+    };
+
+    enum class BenchmarkRenderScale
+    {
+        Full,
+        TwoThirds,
+        Half,
+        Checkerboard
+    };
+
+    struct BenchmarkSettings
+    {
+        /** The scene to render. */
+        BenchmarkScene m_scene = BenchmarkScene::RayTracing;
+        /** The resolution of the offscreen target. */
+        glm::uvec2 m_resolution = glm::uvec2{1920, 1080};
+        /** The number of frames measured. */
+        std::size_t m_frames = 100;
+        /** The number of frames rendered before measuring. */
+        std::size_t m_warmupFrames = 10;
+        /** Whether the ray tracing scene selects texture LODs by ray cones (otherwise the base level is sampled). */
+        bool m_rayConeTextureLod = true;
+        /** Whether converged pixels of the ray tracing scene stop tracing and hand their rays to the remaining ones. */
+        bool m_adaptiveSampling = true;
+        /** Whether the path tracer samples the emissive triangles directly (next event estimation). */
+        bool m_lightSampling = true;
+        /** Whether the ray tracing geometry uses the compact vertex layout. */
+        bool m_compactVertices = false;
+        /** The integrator of the ray tracing scene. */
+        BenchmarkIntegrator m_integrator = BenchmarkIntegrator::AmbientOcclusion;
+        /** The sample generator of the ray tracing integrators. */
+        BenchmarkSampler m_sampler = BenchmarkSampler::Sobol;
+        /** The number of a-trous denoising iterations before compositing (0 disables the denoiser). */
+        std::uint32_t m_denoiseIterations = 0;
+        /** The density of the traced pixels of the ray tracing scene. */
+        BenchmarkRenderScale m_renderScale = BenchmarkRenderScale::Full;
+        /** The generated instances added to the ray tracing scene (none by default). */
+        scene::rt::StressSceneSettings m_stressScene;
+        /** The file the JSON results are written to. */
+        std::filesystem::path m_outputFile = "benchmark.json";
+        /** The file a Chrome trace of the CPU/GPU timeline is written to (no trace is recorded if empty, also used without --benchmark). */
+        std::filesystem::path m_traceFile;
+
+        /**
+         *  Parses the benchmark settings from the command line.
+         *  @return true if the benchmark mode (--benchmark) was requested.
+         */
+        static bool ParseCommandLine(int argc, const char** argv, BenchmarkSettings& settings);
+    };
+
+    class HeadlessBenchmark
+    {
+    public:
+        explicit HeadlessBenchmark(const BenchmarkSettings& settings);
+        ~HeadlessBenchmark();
+
+        void Run();
+
+    private:
+        struct FrameTiming
+        {
+            double m_cpuTime = 0.0;
+            double m_gpuTime = 0.0;
+            double m_frameTime = 0.0;
+            /** The rays traced by the frame (only counted by the path tracing integrators). */
+            std::uint64_t m_rays = 0;
+        };
+
+        void InitializeVulkan();
+        void WriteResults() const;
+
+        /** The benchmark settings. */
+        BenchmarkSettings m_settings;
+        /** The Vulkan instance (without any surface extensions). */
+        vk::UniqueInstance m_instance;
+        /** The logical device rendered on. */
+        std::unique_ptr<vkfw_core::gfx::LogicalDevice> m_device;
+        /** The fixed camera. */
+        std::unique_ptr<vkfw_core::gfx::UserControlledCamera> m_camera;
+        /** The offscreen target rendered to. */
+        std::unique_ptr<OffscreenRenderTarget> m_target;
+        /** The imported meshes. */
+        std::unique_ptr<scene::MeshCache> m_meshCache;
+        /** The precompiled textures. */
+        std::unique_ptr<scene::TextureCache> m_textureCache;
+        /** The GPU timeline regions of the scene are recorded to. */
+        std::unique_ptr<gfx::GPUTimeline> m_gpuTimeline;
+        /** The pipeline cache, saved when the benchmark is destroyed. */
+        std::unique_ptr<gfx::PipelineCache> m_pipelineCache;
+        /** The scene rendered. */
+        std::unique_ptr<scene::Scene> m_scene;
+        /** The scene as ray tracing scene (nullptr for other scenes), used to query the traced rays. */
+        scene::rt::RaytracingScene* m_rtScene = nullptr;
+        /** The measured timings of all frames (without warm-up). */
+        std::vector<FrameTiming> m_timings;
+        /** The complete wall clock time of the measured frames. */
+        double m_totalTime = 0.0;
+    };
+}
@@ -0,0 +1,49 @@
+/**
+ * @file   MeshCache.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Retains imported meshes (CPU side) over the lifetime of scenes.
+ */
+
+#pragma once
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace vkfw_core::gfx {
+    class AssImpScene;
+}
+
+namespace vkfw_app::scene {
+
+    /**
+     *  Caches imported meshes by file name, so that scenes sharing a mesh do not need to import it again.
+     *  Meshes no remaining scene uses are released when scenes are evicted, an evicted scene imports them again on its next activation.
+     *  Meshes are imported on worker threads, each requested mesh is imported in parallel. The workers only parse the files into
+     *  the CPU side mesh info (vertices, indices, sub meshes and materials referencing their textures by file name) and get no
+     *  device, all buffers, textures and acceleration structures are created from the mesh info on the render thread.
+     */
+    class MeshCache
+    {
+    public:
+        using MeshFuture = std::shared_future<std::shared_ptr<vkfw_core::gfx::AssImpScene>>;
+
+        /** Starts the import of a mesh on a worker thread (if not requested before) and returns the future result. */
+        MeshFuture RequestMesh(const std::string& meshFilename);
+        /** Returns the mesh for the file name, blocks until it is imported. */
+        std::shared_ptr<vkfw_core::gfx::AssImpScene> GetMesh(const std::string& meshFilename) { return RequestMesh(meshFilename).get(); }
+        /** Releases all imported meshes not in usedMeshes, meshes that are still importing are kept. */
+        void ReleaseUnusedMeshes(const std::set<std::string>& usedMeshes);
+
+    private:
+        /** Protects the mesh map. */
+        std::mutex m_meshesMutex;
+        /** The imported (or currently importing) meshes. */
+        std::map<std::string, MeshFuture> m_meshes;
+    };
+}
@@ -0,0 +1,91 @@
+/**
+ * @file   OffscreenRenderTarget.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Render target without swapchain used for headless rendering.
+ */
+
+#pragma once
+
+#include "app/RenderTarget.h"
+
+#include <gfx/vk/textures/DeviceTexture.h>
+#include <gfx/vk/wrappers/CommandBuffer.h>
+#include <gfx/vk/wrappers/CommandPool.h>
+#include <gfx/vk/wrappers/RenderPass.h>
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace vkfw_app {
+
+    class OffscreenRenderTarget final : public RenderTarget
+    {
+    public:
+        static constexpr vk::Format COLOR_FORMAT = vk::Format::eR8G8B8A8Unorm;
+        static constexpr vk::Format DEPTH_FORMAT = vk::Format::eD32Sfloat;
+
+        OffscreenRenderTarget(vkfw_core::gfx::LogicalDevice* device, std::string_view name, const glm::uvec2& size, std::size_t numFramebuffers);
+        ~OffscreenRenderTarget() override;
+
+        glm::uvec2 GetSize() const override { return m_size; }
+        std::size_t GetNumberOfFramebuffers() const override { return m_framebuffers.size(); }
+        std::size_t GetCurrentlyRenderedImageIndex() const override { return m_currentImageIndex; }
+        const vkfw_core::gfx::RenderPass& GetRenderPass() const override { return m_renderPass; }
+        vk::Semaphore GetDataAvailableSemaphore() const override { return *m_dataAvailableSemaphore; }
+        vk::Semaphore GetRenderingFinishedSemaphore() const override { return *m_renderingFinishedSemaphore; }
+
+        void BeginRenderPass(std::size_t cmdBufferIndex, std::span<vkfw_core::gfx::DescriptorSet*> descriptorSets,
+                             std::span<vkfw_core::gfx::VertexInputResources*> vertexInputs) override;
+        void EndRenderPass(std::size_t cmdBufferIndex) override;
+
+        /** Records all primary command buffers, wrapping the recorded commands in GPU timestamps. */
+        void UpdatePrimaryCommandBuffers(const std::function<void(vkfw_core::gfx::CommandBuffer& commandBuffer, std::size_t cmdBufferIndex)>& fillFunc);
+        /** Advances to the next image, FrameMove of the scene has to be called after this. */
+        void AcquireNextImage();
+        /**
+         *  Submits the command buffer of the current image and waits for it to finish.
+         *  @param signalRenderingFinished signal the rendering finished semaphore (only if somebody waits on it).
+         *  @return the GPU time of the frame in milliseconds.
+         */
+        double SubmitFrame(bool signalRenderingFinished);
+
+    private:
+        void CreateRenderPass();
+        void CreateFramebuffers(std::size_t numFramebuffers);
+
+        /** The device the target was created on. */
+        vkfw_core::gfx::LogicalDevice* m_device;
+        /** The name of the target. */
+        std::string m_name;
+        /** The size of the images. */
+        glm::uvec2 m_size;
+        /** The render pass used to render into the offscreen images. */
+        vkfw_core::gfx::RenderPass m_renderPass;
+        /** The color images. */
+        std::vector<vkfw_core::gfx::DeviceTexture> m_colorImages;
+        /** The depth images. */
+        std::vector<vkfw_core::gfx::DeviceTexture> m_depthImages;
+        /** The framebuffers. */
+        std::vector<vk::UniqueFramebuffer> m_framebuffers;
+
+        /** The command pool for the primary command buffers. */
+        vkfw_core::gfx::CommandPool m_commandPool;
+        /** The primary command buffers, one per image. */
+        std::vector<vkfw_core::gfx::CommandBuffer> m_commandBuffers;
+        /** Fence to wait for a frame to finish. */
+        vk::UniqueFence m_frameFence;
+        /** Query pool containing a begin and end time stamp per image. */
+        vk::UniqueQueryPool m_timestampQueryPool;
+        /** Nanoseconds per time stamp tick. */
+        double m_timestampPeriod = 1.0;
+
+        vk::UniqueSemaphore m_dataAvailableSemaphore;
+        vk::UniqueSemaphore m_renderingFinishedSemaphore;
+
+        /** The image index rendered in the current frame. */
+        std::size_t m_currentImageIndex = 0;
+    };
+}
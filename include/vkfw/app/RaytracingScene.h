@@ -9,18 +9,26 @@
 #pragma once
 
 #include "app/Scene.h"
+#include "app/MeshCache.h"
+#include "app/StressScene.h"
 
 #include <gfx/vk/UniformBufferObject.h>
 #include <gfx/vk/rt/AccelerationStructureGeometry.h>
 #include <gfx/vk/pipeline/DescriptorSetLayout.h>
 #include <gfx/vk/wrappers/PipelineLayout.h>
-#include <gfx/renderer/FullscreenQuad.h>
 #include "rt/rt_sample_host_interface.h"
 #include "rt/ao/ao_composite_shader_interface.h"
 #include "gfx/Materials.h"
+#include "gfx/CompositingPipeline.h"
+#include "gfx/LightSampler.h"
+#include "gfx/SamplerTables.h"
+#include "gfx/TriangleOpacity.h"
 
 #include <glm/mat4x4.hpp>
 
+#include <chrono>
+#include <utility>
+
 namespace vkfw_core::gfx {
     class Shader;
     class DeviceTexture;
@@ -32,22 +40,76 @@ namespace vkfw_core::gfx {
 
 namespace vkfw_app::gfx::rt {
     class RTIntegrator;
+    class Denoiser;
 }
 
 namespace vkfw_app::scene::rt {
 
+    enum class IntegratorType
+    {
+        AmbientOcclusion,
+        PathTracingMegakernel,
+        PathTracingWavefront,
+        /** Ambient occlusion traced with ray queries from a compute shader. */
+        AmbientOcclusionRayQuery
+    };
+
+    /** The density of the traced pixels, the compositing pass reconstructs the output resolution. */
+    enum class RenderScale
+    {
+        Full,
+        TwoThirds,
+        Half,
+        /** Full resolution images, but every frame only traces half of the pixels in a checkerboard pattern. */
+        Checkerboard
+    };
+
     class RaytracingScene : public Scene
     {
     public:
-        RaytracingScene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera,
-                    std::size_t num_framebuffers);
+        RaytracingScene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera, MeshCache* t_meshCache,
+                    TextureCache* t_textureCache, std::size_t num_framebuffers);
         ~RaytracingScene();
 
-        void CreatePipeline(const glm::uvec2& screenSize, vkfw_core::VKWindow* window) override;
-        void RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, vkfw_core::VKWindow* window) override;
-        void FrameMove(float time, float elapsed, bool cameraChanged, const vkfw_core::VKWindow* window) override;
-        void RenderScene(const vkfw_core::VKWindow* window) override;
-        bool RenderGUI(const vkfw_core::VKWindow* window) override;
+        void CreatePipeline(const glm::uvec2& screenSize, RenderTarget* target) override;
+        void RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, RenderTarget* target) override;
+        void FrameMove(float time, float elapsed, bool cameraChanged, const RenderTarget* target) override;
+        void RenderScene(const RenderTarget* target) override;
+        SceneChange RenderGUI(const vkfw_core::VKWindow* window) override;
+        bool WaitsOnRenderingFinished() const override { return true; }
+        SceneChange UpdateStreamedResources() override;
+        bool IsFullyLoaded() const override;
+
+        /** Selects the texture LOD in the hit shaders by ray cones (default) or always samples the base level. */
+        void SetRayConeTextureLod(bool enabled);
+        /** Lets converged pixels of the AO integrator stop tracing and spends their rays on the remaining ones (default). */
+        void SetAdaptiveSampling(bool enabled);
+        /** Lets the path tracer sample the emissive triangles directly (default), otherwise they are only found by the bounces. */
+        void SetLightSampling(bool enabled);
+        /** Selects the sample generator of the integrators (Owen scrambled Sobol by default). */
+        void SetSamplerType(SamplerType samplerType);
+        /** The number of a-trous iterations filtering the convergence image before compositing, 0 composites it unfiltered. */
+        void SetDenoiseIterations(std::uint32_t iterations);
+        /** The number of a-trous iterations after clamping to MaxDenoiseIterations. */
+        std::uint32_t GetDenoiseIterations() const { return m_denoiseIterations; }
+        /** Lets the AO integrator reproject its accumulation on camera changes (default), otherwise it restarts. */
+        void SetTemporalReprojection(bool enabled);
+        /** Traces the integrators at a reduced density, the images are recreated when the pipeline is created the next time. */
+        void SetRenderScale(RenderScale renderScale);
+        /**
+         *  Stores the geometry as CompactRayTracingVertex (octahedral normals, half float texture coordinates, no color) instead
+         *  of RayTracingVertex, the acceleration structure is rebuilt when the pipeline is created the next time.
+         */
+        void SetCompactVertices(bool enabled);
+        /**
+         *  Adds the instances of a generated stress scene to the default scene, they are streamed in like the other meshes.
+         *  Every instance is a separate geometry of the acceleration structure, the import and the opacity classes are shared.
+         */
+        void AddStressScene(const StressSceneSettings& settings);
+        /** Selects the integrator, it is switched when the pipeline is created the next time. */
+        void SetIntegrator(IntegratorType integrator);
+        /** The number of rays traced by the last finished frame of the command buffer (0 if the integrator does not count rays). */
+        std::uint64_t GetTracedRays(std::size_t cmdBufferIndex) const;
 
     private:
         constexpr static std::uint32_t indexRaygen = 0;
@@ -55,18 +117,76 @@ namespace vkfw_app::scene::rt {
         constexpr static std::uint32_t indexClosestHit = 2;
         constexpr static std::uint32_t shaderGroupCount = 3;
 
+        enum class MeshState
+        {
+            Loading,
+            Added,
+            Failed
+        };
+
+        struct SceneMesh
+        {
+            /** The file name the mesh is requested with. */
+            std::string m_meshFilename;
+            /** The (possibly still importing) mesh. */
+            MeshCache::MeshFuture m_mesh;
+            /** The world matrix of the mesh. */
+            glm::mat4 m_worldMatrix = glm::mat4{1.0f};
+            /** Whether the mesh is part of the acceleration structure. */
+            MeshState m_state = MeshState::Loading;
+            /** The opacity classes of the triangles, classified on a worker thread after the import. */
+            std::shared_future<gfx::TriangleOpacity> m_opacity;
+        };
+
+        void CreateIntegrator();
         void InitializeScene();
+        /** Requests the mesh and its triangle classification, both are shared with other instances of the same mesh. */
+        void RequestSceneMesh(const std::string& meshFilename, const glm::mat4& worldMatrix);
+        void BuildAccelerationStructure();
+        /** Returns the number of vertex / index buffers and of textures of the acceleration structure geometry. */
+        std::pair<std::size_t, std::size_t> GetGeometryDescriptorCounts() const;
         void InitializeDescriptorSets();
+        void InitializeLightSampler();
+        void InitializeTriangleOpacity();
 
-        void InitializeStorageImage(const glm::uvec2& screenSize, const vkfw_core::VKWindow* window);
+        void InitializeStorageImage(const glm::uvec2& screenSize, const RenderTarget* target);
         void FillDescriptorSets();
+        void RecordAdaptiveSamplingCounterReset(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex);
 
         /** Holds the memory for the world and camera UBOs. */
         vkfw_core::gfx::MemoryGroup m_memGroup;
         /** The uniform buffer object for the camera matrices. */
         vkfw_core::gfx::UniformBufferObject m_cameraUBO;
-        /** The acceleration structure. */
-        vkfw_core::gfx::rt::AccelerationStructureGeometry m_asGeometry;
+        /** The acceleration structure (rebuilt when streamed in meshes are added). */
+        std::unique_ptr<vkfw_core::gfx::rt::AccelerationStructureGeometry> m_asGeometry;
+        /** The buffer holding the demo triangle. */
+        unsigned int m_triangleBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        /** The number of vertices of the demo triangle. */
+        std::size_t m_numTriangleVertices = 0;
+        /** The buffer holding the area light (vertices and indices in the same layout as the triangle). */
+        unsigned int m_areaLightBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        /** The number of vertices of the area light. */
+        std::size_t m_numAreaLightVertices = 0;
+        /** The demo triangle and the area light in the compact vertex layout. */
+        unsigned int m_compactTriangleBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        unsigned int m_compactAreaLightBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        /** Whether the geometry in the acceleration structure uses the compact vertex layout. */
+        bool m_compactVertices = false;
+        /** The vertex layout requested by the GUI or SetCompactVertices. */
+        bool m_requestedCompactVertices = false;
+        /** The emissive triangles of the scene in world space. */
+        std::vector<gfx::EmissiveTriangle> m_emissiveTriangles;
+        /** The buffer holding the Sobol direction numbers and the blue noise tile. */
+        unsigned int m_samplerTablesBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        /** Holds the light triangles and alias table (recreated with the acceleration structure). */
+        std::unique_ptr<vkfw_core::gfx::MemoryGroup> m_lightMemGroup;
+        /** The buffer indices of the light triangles and the alias table. */
+        unsigned int m_lightTrianglesBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        unsigned int m_lightAliasTableBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        /** Holds the triangle opacity classes of all geometry (recreated with the acceleration structure). */
+        std::unique_ptr<vkfw_core::gfx::MemoryGroup> m_opacityMemGroup;
+        /** The buffer index of the triangle opacity classes. */
+        unsigned int m_triangleOpacityBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
 
         /** The command pool for the transfer cmd buffers. */
         vkfw_core::gfx::CommandPool m_transferCmdPool;
@@ -75,11 +195,22 @@ namespace vkfw_app::scene::rt {
 
         /** The texture to store raytracing results. */
         std::vector<vkfw_core::gfx::DeviceTexture> m_rayTracingConvergenceImages;
+        /** The normals and camera distances of the first diffuse hits (one per convergence image). */
+        std::vector<vkfw_core::gfx::DeviceTexture> m_gBufferImages;
+        /** Holds the adaptive sampling counters (recreated with the convergence images). */
+        std::unique_ptr<vkfw_core::gfx::MemoryGroup> m_adaptiveSamplingMemGroup;
+        /** The buffer holding the adaptive sampling counters of all convergence images. */
+        unsigned int m_adaptiveSamplingBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        /** The aligned size of the counters of one convergence image. */
+        std::size_t m_adaptiveSamplingStatsSize = 0;
         /** The sampler for material textures */
         vkfw_core::gfx::Sampler m_sampler;
 
         /** Holds the descriptor set layouts for the raytracing pipeline and geometry / material resources. */
         vkfw_core::gfx::DescriptorSetLayout m_rtResourcesDescriptorSetLayout;
+        /** The array sizes of the geometry buffer and texture bindings, unused entries repeat the first descriptor. */
+        std::uint32_t m_geometryBufferCapacity = 0;
+        std::uint32_t m_textureCapacity = 0;
         /** Holds the descriptor set layouts for the convergence image. */
         vkfw_core::gfx::DescriptorSetLayout m_convergenceImageDescriptorSetLayout;
         /** Holds the pipeline layout for raytracing. */
@@ -91,7 +222,14 @@ namespace vkfw_app::scene::rt {
         /** The descriptor set for the convergence image. */
         std::vector<vkfw_core::gfx::DescriptorSet> m_convergenceImageDescriptorSets;
 
+        /** The integrator used for rendering. */
         std::unique_ptr<gfx::rt::RTIntegrator> m_integrator;
+        /** Whether the pipelines of the integrator match its pipeline layout, they do not depend on the screen size and survive resizes. */
+        bool m_integratorPipelineValid = false;
+        /** The type of the current integrator. */
+        IntegratorType m_integratorType = IntegratorType::AmbientOcclusion;
+        /** The integrator requested by the GUI or SetIntegrator. */
+        IntegratorType m_requestedIntegratorType = IntegratorType::AmbientOcclusion;
 
         /** Holds the texture sampler for the accumulated result. */
         vkfw_core::gfx::Sampler m_accumulatedResultSampler;
@@ -101,16 +239,37 @@ namespace vkfw_app::scene::rt {
         std::vector<vkfw_core::gfx::DescriptorSet> m_accumulatedResultImageDescriptorSets;
         /** Holds the pipeline layout for compositing. */
         vkfw_core::gfx::PipelineLayout m_compositingPipelineLayout;
-        /** The fullscreen quad for compositing. */
-        vkfw_core::gfx::FullscreenQuad m_compositingFullscreenQuad;
+        /** The fullscreen pipeline for compositing, it is kept across resizes. */
+        gfx::CompositingPipeline m_compositingPipeline;
+        /** Filters the convergence image before compositing. */
+        std::unique_ptr<gfx::rt::Denoiser> m_denoiser;
+        /** The number of denoising iterations, 0 disables the denoiser. */
+        std::uint32_t m_denoiseIterations = 0;
 
         vkfw_app::gfx::MirrorMaterialInfo m_triangleMaterial;
-        /** Holds the AssImp demo models. */
-        std::shared_ptr<vkfw_core::gfx::AssImpScene> m_teapotMeshInfo;
-        std::shared_ptr<vkfw_core::gfx::AssImpScene> m_sponzaMeshInfo;
+        vkfw_app::gfx::EmissiveMaterialInfo m_areaLightMaterial;
+        /** The time of the last acceleration structure rebuild for streamed in meshes. */
+        std::chrono::steady_clock::time_point m_lastStreamingRebuild = std::chrono::steady_clock::now();
+        /** Holds the AssImp demo models, they are added to the acceleration structure as soon as they are imported. */
+        std::vector<SceneMesh> m_sceneMeshes;
 
         CameraParameters m_cameraProperties;
+        /** The screen size the pipeline was created for. */
+        glm::uvec2 m_screenSize = glm::uvec2{0};
+        /** The size of the convergence images, the screen size reduced by the render scale. */
+        glm::uvec2 m_traceSize = glm::uvec2{0};
+        /** The density of the traced pixels. */
+        RenderScale m_renderScale = RenderScale::Full;
+        /** The half of the checkerboard traced by the next frame of each convergence image. */
+        std::vector<std::uint32_t> m_checkerboardPhases;
         std::size_t m_lastMoveFrame = static_cast<std::size_t>(-1);
         bool m_guiChanged = true;
+        /** The first transfer submit of the scene has no rendering to wait for (also after the scene was evicted and recreated). */
+        bool m_firstFrame = true;
+        /** The view projection matrix and camera position of the last frame, the next frame reprojects from them. */
+        glm::mat4 m_lastViewProj = glm::mat4{1.0f};
+        glm::vec4 m_lastCameraPosition = glm::vec4{0.0f};
+        /** Whether camera changes reproject the AO accumulation instead of restarting it. */
+        bool m_temporalReprojection = true;
     };
 }
@@ -0,0 +1,75 @@
+/**
+ * @file   RenderTarget.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Abstraction of the images a scene renders into (swapchain or offscreen).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <glm/vec2.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace vkfw_core {
+    class VKWindow;
+}
+
+namespace vkfw_core::gfx {
+    class LogicalDevice;
+    class RenderPass;
+    class DescriptorSet;
+    class VertexInputResources;
+}
+
+namespace vkfw_app {
+
+    class RenderTarget
+    {
+    public:
+        virtual ~RenderTarget() = default;
+
+        /** Returns the size of the images rendered to. */
+        virtual glm::uvec2 GetSize() const = 0;
+        /** Returns the number of images (and primary command buffers) of this target. */
+        virtual std::size_t GetNumberOfFramebuffers() const = 0;
+        /** Returns the index of the image rendered in the current frame. */
+        virtual std::size_t GetCurrentlyRenderedImageIndex() const = 0;
+        /** Returns the render pass compatible with the framebuffers of this target. */
+        virtual const vkfw_core::gfx::RenderPass& GetRenderPass() const = 0;
+        /** Semaphore the per frame data upload signals before rendering may start. */
+        virtual vk::Semaphore GetDataAvailableSemaphore() const = 0;
+        /** Semaphore signaled when the rendering of a frame is finished. */
+        virtual vk::Semaphore GetRenderingFinishedSemaphore() const = 0;
+
+        virtual void BeginRenderPass(std::size_t cmdBufferIndex, std::span<vkfw_core::gfx::DescriptorSet*> descriptorSets,
+                                     std::span<vkfw_core::gfx::VertexInputResources*> vertexInputs) = 0;
+        virtual void EndRenderPass(std::size_t cmdBufferIndex) = 0;
+    };
+
+    /** Render target forwarding to the swapchain of a window. */
+    class WindowRenderTarget final : public RenderTarget
+    {
+    public:
+        explicit WindowRenderTarget(vkfw_core::VKWindow* window) : m_window{window} {}
+
+        glm::uvec2 GetSize() const override;
+        std::size_t GetNumberOfFramebuffers() const override;
+        std::size_t GetCurrentlyRenderedImageIndex() const override;
+        const vkfw_core::gfx::RenderPass& GetRenderPass() const override;
+        vk::Semaphore GetDataAvailableSemaphore() const override;
+        vk::Semaphore GetRenderingFinishedSemaphore() const override;
+
+        void BeginRenderPass(std::size_t cmdBufferIndex, std::span<vkfw_core::gfx::DescriptorSet*> descriptorSets,
+                             std::span<vkfw_core::gfx::VertexInputResources*> vertexInputs) override;
+        void EndRenderPass(std::size_t cmdBufferIndex) override;
+
+        vkfw_core::VKWindow* GetWindow() const { return m_window; }
+
+    private:
+        /** The window whose swapchain is rendered to. */
+        vkfw_core::VKWindow* m_window;
+    };
+}
@@ -9,9 +9,14 @@
 #pragma once
 
 #include <cstddef>
+#include <set>
+#include <string>
 #include <glm/vec2.hpp>
 #include <vulkan/vulkan.hpp>
 #include <gfx/vk/wrappers/CommandBuffer.h>
+#include "app/MeshCache.h"
+#include "app/RenderTarget.h"
+#include "gfx/GPUTimeline.h"
 
 namespace vkfw_core {
     class VKWindow;
@@ -22,25 +27,68 @@ namespace vkfw_core::gfx {
     class UserControlledCamera;
 }
 
+namespace vkfw_app::gfx {
+    class PipelineCache;
+}
+
 namespace vkfw_app::scene {
 
+    class TextureCache;
+
+    /** The kind of update a change (e.g., of a GUI parameter) requires, ordered by cost. */
+    enum class SceneChange
+    {
+        /** Nothing changed. */
+        None,
+        /** Only uniform data changed, it is uploaded with the next FrameMove. */
+        Parameters,
+        /** The recorded commands changed, the primary command buffers need to be re-recorded. */
+        CommandStream,
+        /** Pipelines and screen sized resources need to be recreated. */
+        Resize
+    };
+
     class Scene
     {
     public:
-        Scene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera,
-              std::size_t t_num_framebuffers);
+        Scene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera, MeshCache* t_meshCache,
+              TextureCache* t_textureCache, std::size_t t_num_framebuffers);
         virtual ~Scene() = default;
 
-        virtual void CreatePipeline(const glm::uvec2& screenSize, vkfw_core::VKWindow* window) = 0;
-        virtual void RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, vkfw_core::VKWindow* window) = 0;
-        virtual void FrameMove(float time, float elapsed, bool cameraChanged, const vkfw_core::VKWindow* window) = 0;
-        virtual void RenderScene(const vkfw_core::VKWindow* window) = 0;
-        virtual bool RenderGUI(const vkfw_core::VKWindow* window);
+        virtual void CreatePipeline(const glm::uvec2& screenSize, RenderTarget* target) = 0;
+        virtual void RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, RenderTarget* target) = 0;
+        virtual void FrameMove(float time, float elapsed, bool cameraChanged, const RenderTarget* target) = 0;
+        virtual void RenderScene(const RenderTarget* target) = 0;
+        /** Renders the scenes GUI and returns the update needed by the changes made. */
+        virtual SceneChange RenderGUI(const vkfw_core::VKWindow* window);
+        /** Adds streamed in resources (e.g., asynchronously imported meshes) to the scene, called regularly on the render thread. */
+        virtual SceneChange UpdateStreamedResources() { return SceneChange::None; }
+        /** Returns if all streamed resources have been added to the scene. */
+        virtual bool IsFullyLoaded() const { return true; }
+        /** Returns if the per frame upload of the scene waits on the rendering finished semaphore of the target. */
+        virtual bool WaitsOnRenderingFinished() const { return false; }
+
+        /** Sets the GPU timeline used to record regions into the command buffers (may be nullptr). */
+        void SetGPUTimeline(gfx::GPUTimeline* timeline) { m_gpuTimeline = timeline; }
+        gfx::GPUTimeline* GetGPUTimeline() const { return m_gpuTimeline; }
+        /** Sets the pipeline cache the scenes own pipelines are created through (may be nullptr), has to be set before CreatePipeline. */
+        void SetPipelineCache(gfx::PipelineCache* pipelineCache) { m_pipelineCache = pipelineCache; }
+        gfx::PipelineCache* GetPipelineCache() const { return m_pipelineCache; }
+        /** Returns the file names of all meshes the scene requested from the mesh cache. */
+        const std::set<std::string>& GetMeshFilenames() const { return m_meshFilenames; }
 
     protected:
         vkfw_core::gfx::LogicalDevice* GetDevice() const { return m_device; }
         vkfw_core::gfx::UserControlledCamera* GetCamera() const { return m_camera; }
+        MeshCache* GetMeshCache() const { return m_meshCache; }
+        TextureCache* GetTextureCache() const { return m_textureCache; }
+        /** Requests a mesh from the mesh cache and remembers it as used by this scene. */
+        MeshCache::MeshFuture RequestMesh(const std::string& meshFilename);
         std::size_t GetNumberOfFramebuffers() const { return m_num_framebuffers; }
+        gfx::GPUTimelineRegion GPURegion(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const char* name) const
+        {
+            return gfx::GPUTimelineRegion{m_gpuTimeline, cmdBuffer, cmdBufferIndex, name};
+        }
 
         // The queue indices for the current configuration.
         constexpr static unsigned int GRAPHICS_QUEUE = 0;
@@ -52,7 +100,17 @@ namespace vkfw_app::scene {
         vkfw_core::gfx::LogicalDevice* m_device;
         /** The camera to render the scene into. */
         vkfw_core::gfx::UserControlledCamera* m_camera;
+        /** The cache for imported meshes (outlives the scene). */
+        MeshCache* m_meshCache;
+        /** The meshes requested from the mesh cache, the cache keeps them while the scene exists. */
+        std::set<std::string> m_meshFilenames;
+        /** The cache for precompiled textures (outlives the scene). */
+        TextureCache* m_textureCache;
         /** The number of frame buffers used to render this scene. */
         std::size_t m_num_framebuffers;
+        /** The GPU timeline to record regions in (optional). */
+        gfx::GPUTimeline* m_gpuTimeline = nullptr;
+        /** The persistent pipeline cache (optional, outlives the scene). */
+        gfx::PipelineCache* m_pipelineCache = nullptr;
     };
 }
@@ -40,14 +40,14 @@ namespace vkfw_app::scene::simple {
     class SimpleScene : public Scene
     {
     public:
-        SimpleScene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera,
-                    std::size_t num_framebuffers);
+        SimpleScene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera, MeshCache* t_meshCache,
+                    TextureCache* t_textureCache, std::size_t num_framebuffers);
         ~SimpleScene();
 
-        void CreatePipeline(const glm::uvec2& screenSize, vkfw_core::VKWindow* window) override;
-        void RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, vkfw_core::VKWindow* window) override;
-        void FrameMove(float time, float elapsed, bool cameraChanged, const vkfw_core::VKWindow* window) override;
-        void RenderScene(const vkfw_core::VKWindow* window) override;
+        void CreatePipeline(const glm::uvec2& screenSize, RenderTarget* target) override;
+        void RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, RenderTarget* target) override;
+        void FrameMove(float time, float elapsed, bool cameraChanged, const RenderTarget* target) override;
+        void RenderScene(const RenderTarget* target) override;
 
  private:
         void InitializeScene();
@@ -69,6 +69,8 @@ namespace vkfw_app::scene::simple {
         std::unique_ptr<vkfw_core::gfx::GraphicsPipeline> m_demoPipeline;
         /** Holds the graphics pipeline for transparent demo rendering. */
         std::unique_ptr<vkfw_core::gfx::GraphicsPipeline> m_demoTransparentPipeline;
+        /** The render pass the pipelines were created for. */
+        vk::RenderPass m_pipelineRenderPass;
         /** Holds vertex information. */
         std::vector<mesh_sample::SimpleVertex> m_vertices;
         /** Holds index information. */
@@ -94,8 +96,8 @@ namespace vkfw_app::scene::simple {
         /** Holds the command buffers for transferring the uniform buffers. */
         std::vector<vkfw_core::gfx::CommandBuffer> m_transferCommandBuffers;
 
-        /** Holds the texture used. */
-        std::shared_ptr<vkfw_core::gfx::Texture2D> m_demoTexture;
+        /** Holds the memory group index of the (precompiled) texture used. */
+        unsigned int m_demoTextureIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
         /** Holds the texture sampler. */
         vkfw_core::gfx::Sampler m_demoSampler;
 
@@ -0,0 +1,54 @@
+/**
+ * @file   StressScene.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Deterministic placement of many mesh instances for scaling measurements.
+ */
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace vkfw_app::scene::rt {
+
+    enum class StressLayout
+    {
+        Grid,
+        Scatter
+    };
+
+    enum class StressMesh
+    {
+        Teapot,
+        Sponza
+    };
+
+    struct StressSceneSettings
+    {
+        /** The number of teapot instances. */
+        std::size_t m_numTeapots = 0;
+        /** The number of Sponza instances. */
+        std::size_t m_numSponzas = 0;
+        /** Whether the instances are placed in a square grid or scattered randomly over the same area. */
+        StressLayout m_layout = StressLayout::Grid;
+        /** The seed of the rotations, scales and scattered positions. */
+        std::uint32_t m_seed = 1;
+    };
+
+    struct StressInstance
+    {
+        StressMesh m_mesh = StressMesh::Teapot;
+        /** The world matrix applied on top of the base transform of the mesh (scale and orientation of the default scene). */
+        glm::mat4 m_worldMatrix = glm::mat4{1.0f};
+    };
+
+    /**
+     *  Places the instances of a stress scene in the ground plane around the origin, each mesh on its own square area
+     *  with a spacing of its footprint. The result only depends on the settings (same seed, same scene on every platform).
+     */
+    [[nodiscard]] std::vector<StressInstance> GenerateStressInstances(const StressSceneSettings& settings);
+}
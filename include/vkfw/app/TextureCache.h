@@ -0,0 +1,48 @@
+/**
+ * @file   TextureCache.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Cache of precompiled (mip mapped and block compressed) textures.
+ */
+
+#pragma once
+
+#include "gfx/CompressedTexture.h"
+
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace vkfw_app::scene {
+
+    /**
+     *  Caches compressed textures by file name. On the first request a texture is decoded, its mip chain is generated and
+     *  all levels are block compressed on a worker thread. The result is written to a KTX file that is read directly on later runs.
+     *  Material textures of imported meshes are loaded by vkfw_core and do not pass through this cache.
+     */
+    class TextureCache
+    {
+    public:
+        using TextureFuture = std::shared_future<std::shared_ptr<const gfx::CompressedTexture>>;
+
+        /** Starts loading a texture on a worker thread (if not requested before) and returns the future result. */
+        TextureFuture RequestTexture(const std::string& textureFilename);
+        /** Returns the texture for the file name, blocks until it is loaded. */
+        std::shared_ptr<const gfx::CompressedTexture> GetTexture(const std::string& textureFilename) { return RequestTexture(textureFilename).get(); }
+
+        /** Returns the file name of the precompiled texture. */
+        static std::filesystem::path GetCacheFilename(const std::string& textureFilename);
+        /** Guesses the role of a texture from its file name (e.g., "_bump" or "_ddn" suffixes). */
+        static gfx::TextureRole GuessTextureRole(const std::string& textureFilename);
+
+    private:
+        /** Protects the texture map. */
+        std::mutex m_texturesMutex;
+        /** The loaded (or currently loading) textures. */
+        std::map<std::string, TextureFuture> m_textures;
+    };
+}
@@ -0,0 +1,114 @@
+/**
+ * @file   AsyncLogSink.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Asynchronous spdlog sink with lock-free per thread buffers.
+ */
+
+#pragma once
+
+#include "core/SPSCRingBuffer.h"
+
+#include <spdlog/sinks/sink.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vkfw_app::core {
+
+    /**
+     *  Sink that copies log messages to a lock-free ring buffer of the calling thread. A background thread drains all buffers
+     *  and forwards the messages to the wrapped (blocking) sinks, so logging never waits on I/O.
+     *  No message is lost or shortened: text that does not fit into a slot is spilled to the heap and a full ring buffer
+     *  overflows into a locked queue of the thread until the next drain.
+     */
+    class AsyncLogSink : public spdlog::sinks::sink
+    {
+    public:
+        /** Number of messages each thread can buffer between two drains. */
+        static constexpr std::size_t MESSAGES_PER_THREAD = 1024;
+        /** The size of a buffered message, logger name and payload of longer messages are allocated separately. */
+        static constexpr std::size_t MESSAGE_SIZE = 256;
+        /** Interval the background thread drains the buffers in. */
+        static constexpr std::chrono::milliseconds DRAIN_INTERVAL{2};
+
+        explicit AsyncLogSink(std::vector<spdlog::sink_ptr> sinks);
+        ~AsyncLogSink() override;
+        AsyncLogSink(const AsyncLogSink&) = delete;
+        AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+        void log(const spdlog::details::log_msg& msg) override;
+        /** Blocks until all messages logged before are written and flushes the wrapped sinks. */
+        void flush() override;
+        /** Formatting is done by the wrapped sinks, patterns have to be set there. */
+        void set_pattern(const std::string&) override {}
+        void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    private:
+        struct Message
+        {
+            spdlog::log_clock::time_point m_time;
+            std::size_t m_threadId = 0;
+            spdlog::level::level_enum m_level = spdlog::level::off;
+            std::uint32_t m_loggerNameLength = 0;
+            std::uint32_t m_payloadLength = 0;
+            /** Logger name and payload if they do not fit into m_text (owned by the message, freed after it was written). */
+            char* m_spilledText = nullptr;
+            /** The logger name followed by the payload. */
+            std::array<char, MESSAGE_SIZE - 40> m_text;
+
+            [[nodiscard]] const char* GetText() const { return m_spilledText != nullptr ? m_spilledText : m_text.data(); }
+        };
+        static_assert(sizeof(Message) == MESSAGE_SIZE, "Log messages should fill a fixed slot.");
+
+        struct ThreadBuffer
+        {
+            /** The buffered messages. */
+            SPSCRingBuffer<Message, MESSAGES_PER_THREAD> m_messages;
+            /** Protects the overflow queue. */
+            std::mutex m_overflowMutex;
+            /** Messages logged while the ring buffer was full, all later messages go here too until it is drained to keep their order. */
+            std::vector<Message> m_overflow;
+            /** Whether the overflow queue holds messages. */
+            std::atomic<bool> m_overflowing = false;
+            /** Set when the owning thread exits, the buffer is released after it is drained. */
+            std::atomic<bool> m_retired = false;
+        };
+
+        ThreadBuffer& GetThreadBuffer();
+        void DrainThread();
+        /** Writes all buffered messages to the wrapped sinks (only called by the drain thread). */
+        void Drain();
+        void WriteToSinks(const spdlog::details::log_msg& msg);
+
+        /** Identifies the sink in the thread local buffer lookup. */
+        std::uint64_t m_id;
+        /** The sinks the messages are forwarded to. */
+        std::vector<spdlog::sink_ptr> m_sinks;
+        /** Protects the thread buffer list and the wakeup of the drain thread. */
+        std::mutex m_mutex;
+        /** Wakes the drain thread early (e.g., for flushes or buffers getting full). */
+        std::condition_variable m_drainCondition;
+        /** Signals finished drains to flushing threads. */
+        std::condition_variable m_flushedCondition;
+        /** The buffers of all threads that logged. */
+        std::vector<std::shared_ptr<ThreadBuffer>> m_threadBuffers;
+        /** The messages of the current drain (reused to avoid allocations). */
+        std::vector<Message> m_drainedMessages;
+        /** Number of requested and completed flushes. */
+        std::uint64_t m_requestedFlushes = 0;
+        std::uint64_t m_completedFlushes = 0;
+        /** Whether the drain thread should exit. */
+        bool m_stop = false;
+        /** The background thread. */
+        std::thread m_drainThread;
+    };
+}
@@ -0,0 +1,62 @@
+/**
+ * @file   SPSCRingBuffer.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Lock-free single producer / single consumer ring buffer.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+
+namespace vkfw_app::core {
+
+    /**
+     *  Bounded ring buffer that is safe for exactly one producer thread and one consumer thread.
+     *  Neither TryPush nor TryPop ever block, a full buffer rejects the element.
+     */
+    template<typename T, std::size_t Capacity> class SPSCRingBuffer
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity of SPSCRingBuffer has to be a power of two.");
+
+    public:
+        /** Called by the producer, returns false if the buffer is full. */
+        bool TryPush(const T& element)
+        {
+            auto head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) == Capacity) { return false; }
+            m_elements[head & (Capacity - 1)] = element;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /** Called by the consumer, returns an empty optional if the buffer is empty. */
+        std::optional<T> TryPop()
+        {
+            auto tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire)) { return std::nullopt; }
+            std::optional<T> result{std::move(m_elements[tail & (Capacity - 1)])};
+            m_tail.store(tail + 1, std::memory_order_release);
+            return result;
+        }
+
+        /** Approximation of the number of elements, exact only if called by producer or consumer while the other is idle. */
+        std::size_t Size() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+        bool Empty() const { return Size() == 0; }
+
+    private:
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        /** The write position (only written by the producer). */
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head = 0;
+        /** The read position (only written by the consumer). */
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail = 0;
+        /** The elements. */
+        alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_elements;
+    };
+}
@@ -0,0 +1,131 @@
+/**
+ * @file   Timeline.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  CPU/GPU timeline recording with Chrome trace (Perfetto) export.
+ */
+
+#pragma once
+
+#include "core/SPSCRingBuffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vkfw_app::core {
+
+    struct TimelineEvent
+    {
+        /** The name of the event, has to be a string with static storage duration. */
+        const char* m_name = nullptr;
+        /** Begin of the event in nanoseconds since timeline creation. */
+        std::uint64_t m_begin = 0;
+        /** End of the event in nanoseconds since timeline creation. */
+        std::uint64_t m_end = 0;
+        /** The track (thread or GPU queue) the event belongs to. */
+        std::uint32_t m_track = 0;
+    };
+
+    class Timeline
+    {
+    public:
+        /** The track used for GPU events. */
+        static constexpr std::uint32_t GPU_TRACK = 1000;
+        /** The track of the first thread buffer, thread tracks are numbered upwards from here and never collide with the GPU track. */
+        static constexpr std::uint32_t FIRST_THREAD_TRACK = GPU_TRACK + 1;
+        /** Number of events each thread can buffer between two drains. */
+        static constexpr std::size_t EVENTS_PER_THREAD = 1 << 14;
+
+        static Timeline& Instance();
+
+        void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+        bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+        /** Returns the current time in nanoseconds since the creation of the timeline. */
+        std::uint64_t Now() const;
+        /** Records an event on the track of the calling thread. */
+        void Record(const char* name, std::uint64_t begin, std::uint64_t end);
+        /** Records an event on an explicit track (e.g., GPU_TRACK), the event is buffered by the calling thread. */
+        void RecordOnTrack(std::uint32_t track, const char* name, std::uint64_t begin, std::uint64_t end);
+
+        /** Moves all buffered events of all threads to the timeline, should be called regularly (e.g., once per frame). */
+        void Drain();
+        /** Drains and writes all events in Chrome trace event format (readable by chrome://tracing and Perfetto). */
+        void WriteChromeTrace(const std::filesystem::path& filename);
+
+        std::uint64_t GetDroppedEvents() const { return m_droppedEvents.load(std::memory_order_relaxed); }
+
+    private:
+        using EventBuffer = SPSCRingBuffer<TimelineEvent, EVENTS_PER_THREAD>;
+
+        struct ThreadBuffer
+        {
+            /** The track id of the thread. */
+            std::uint32_t m_track = 0;
+            /** The buffered events. */
+            EventBuffer m_events;
+        };
+
+        /** Returns the buffer of a thread to the free list when the thread exits. */
+        class ThreadBufferOwner
+        {
+        public:
+            ThreadBufferOwner() = default;
+            ~ThreadBufferOwner();
+            ThreadBufferOwner(const ThreadBufferOwner&) = delete;
+            ThreadBufferOwner& operator=(const ThreadBufferOwner&) = delete;
+
+            ThreadBuffer* m_buffer = nullptr;
+        };
+
+        Timeline();
+        ThreadBuffer& GetThreadBuffer();
+        void ReleaseThreadBuffer(ThreadBuffer* buffer);
+
+        /** The timeline is only recorded if enabled. */
+        std::atomic<bool> m_enabled = false;
+        /** The start time of the timeline. */
+        std::uint64_t m_epoch;
+        /** Protects registration of new threads and draining (never taken while recording). */
+        std::mutex m_threadsMutex;
+        /** The buffers of all threads that recorded events, buffers of exited threads are kept until their events are drained. */
+        std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+        /** Buffers of exited threads that are handed to the next new thread (with their track). */
+        std::vector<ThreadBuffer*> m_freeThreadBuffers;
+        /** All drained events. */
+        std::vector<TimelineEvent> m_events;
+        /** Number of events dropped because a thread buffer was full. */
+        std::atomic<std::uint64_t> m_droppedEvents = 0;
+    };
+
+    /** Records the lifetime of the object as event on the calling threads track. */
+    class TimelineScope
+    {
+    public:
+        explicit TimelineScope(const char* name) : m_name{name}
+        {
+            if (Timeline::Instance().IsEnabled()) { m_begin = Timeline::Instance().Now(); }
+        }
+        ~TimelineScope()
+        {
+            if (m_begin != NOT_RECORDED) { Timeline::Instance().Record(m_name, m_begin, Timeline::Instance().Now()); }
+        }
+        TimelineScope(const TimelineScope&) = delete;
+        TimelineScope& operator=(const TimelineScope&) = delete;
+
+    private:
+        static constexpr std::uint64_t NOT_RECORDED = static_cast<std::uint64_t>(-1);
+
+        const char* m_name;
+        std::uint64_t m_begin = NOT_RECORDED;
+    };
+}
+
+#define TIMELINE_CONCAT_IMPL(a, b) a##b
+#define TIMELINE_CONCAT(a, b) TIMELINE_CONCAT_IMPL(a, b)
+#define TIMELINE_SCOPE(name) const ::vkfw_app::core::TimelineScope TIMELINE_CONCAT(timelineScope, __LINE__){name}
@@ -0,0 +1,37 @@
+/**
+ * @file   AOQueryIntegrator.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Class for the ambient occlusion integrator using ray queries.
+ */
+
+#pragma once
+
+#include "gfx/RTIntegrator.h"
+
+namespace vkfw_app::gfx::rt {
+
+    /**
+     *  Ambient occlusion traced with inline ray queries from a compute shader (same results as the AOIntegrator).
+     *  Alpha testing and mirrors are handled in the traversal loop instead of any hit and closest hit shaders.
+     */
+    class AOQueryIntegrator : public RTIntegrator
+    {
+    public:
+        AOQueryIntegrator(vkfw_core::gfx::LogicalDevice* device);
+        ~AOQueryIntegrator() override;
+
+        void InitializePipeline(const vkfw_core::gfx::PipelineLayout& pipelineLayout) override;
+        void TraceRays(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const glm::u32vec4& rtGroups) override;
+
+    private:
+        /** No ray tracing pipeline is created, the integrator has no shader binding table. */
+        std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> GetShaders() const override { return {}; }
+
+        /** The pipeline layout shared with the ray tracing integrators. */
+        const vkfw_core::gfx::PipelineLayout* m_pipelineLayout = nullptr;
+        /** The compute pipeline tracing the ray queries. */
+        vk::UniquePipeline m_pipeline;
+    };
+}
@@ -0,0 +1,37 @@
+/**
+ * @file   BlockCompression.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  CPU encoders for GPU block compressed texture formats (BC1, BC3, BC4, BC5).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkfw_app::gfx {
+
+    enum class BlockFormat
+    {
+        /** RGB, 4 bits per texel. */
+        BC1,
+        /** RGBA (interpolated alpha), 8 bits per texel. */
+        BC3,
+        /** single channel (red), 4 bits per texel. */
+        BC4,
+        /** two channels (red, green), 8 bits per texel. */
+        BC5
+    };
+
+    /** Returns the size of a 4x4 block in bytes. */
+    constexpr std::size_t GetBlockSize(BlockFormat format) { return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16; }
+
+    /**
+     *  Compresses an RGBA8 image to the block format, image borders that do not fill a complete block are clamped.
+     *  The encoders use a bounding box endpoint fit, which is fast enough to run at load time.
+     */
+    std::vector<std::byte> CompressImage(BlockFormat format, const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file   CompositingPipeline.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Fullscreen graphics pipeline with dynamic viewport and scissor.
+ */
+
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vkfw_core::gfx {
+    class LogicalDevice;
+    class CommandBuffer;
+    class RenderPass;
+    class PipelineLayout;
+}
+
+namespace vkfw_app::gfx {
+    class PipelineCache;
+
+    /**
+     *  Draws a single triangle covering the render target with a fragment shader, used to composite the ray traced images.
+     *  Viewport and scissor are dynamic state, so the pipeline survives resizes and is only created again if the fragment
+     *  shader, the render pass or the pipeline layout change.
+     */
+    class CompositingPipeline
+    {
+    public:
+        explicit CompositingPipeline(vkfw_core::gfx::LogicalDevice* device) : m_device{device} {}
+
+        /** Creates the pipeline if it does not exist yet or one of the parameters changed, returns whether it was created. */
+        bool CreatePipeline(std::string_view fragmentShader, const vkfw_core::gfx::RenderPass& renderPass, std::uint32_t subpass,
+                            const vkfw_core::gfx::PipelineLayout& pipelineLayout, PipelineCache* pipelineCache);
+        /** Records the draw into the current render pass, covering the given size from the top left corner. */
+        void Render(vkfw_core::gfx::CommandBuffer& cmdBuffer, const glm::uvec2& size) const;
+
+    private:
+        /** The device. */
+        vkfw_core::gfx::LogicalDevice* m_device;
+        /** The fragment shader, render pass, subpass and layout the pipeline was created for. */
+        std::string m_fragmentShader;
+        vk::RenderPass m_renderPass;
+        std::uint32_t m_subpass = 0;
+        vk::PipelineLayout m_pipelineLayout;
+        /** The pipeline. */
+        vk::UniquePipeline m_pipeline;
+    };
+}
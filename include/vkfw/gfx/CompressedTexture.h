@@ -0,0 +1,78 @@
+/**
+ * @file   CompressedTexture.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Block compressed texture with a complete mip chain, stored in a KTX (version 1) container.
+ */
+
+#pragma once
+
+#include "gfx/BlockCompression.h"
+
+#include <glm/vec2.hpp>
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vkfw_core::gfx {
+    class MemoryGroup;
+}
+
+namespace vkfw_app::gfx {
+
+    /** The role of a texture in a material, decides the block format. */
+    enum class TextureRole
+    {
+        /** sRGB color, BC1 (or BC3 if the texture has alpha). */
+        Color,
+        /** tangent space normal map, BC5 (x and y, z is reconstructed). */
+        Normal,
+        /** single linear channel (e.g., bump, specular, mask), BC4. */
+        Scalar
+    };
+
+    class CompressedTexture
+    {
+    public:
+        /** Version of the cache content, stored as key/value pair in the container, increase if the encoding changes. */
+        static constexpr std::string_view CACHE_VERSION = "1";
+
+        /** Generates the mip chain of an RGBA8 image and compresses all levels. */
+        static std::unique_ptr<CompressedTexture> Compress(TextureRole role, const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height);
+        /** Reads a KTX file written by WriteKTX, returns nullptr if the file is not valid. */
+        static std::unique_ptr<CompressedTexture> ReadKTX(const std::filesystem::path& filename);
+        /** Writes the texture as KTX file. */
+        void WriteKTX(const std::filesystem::path& filename) const;
+
+        /**
+         *  Adds the texture (with all mip levels) to a memory group, the data is uploaded with the groups next transfer.
+         *  @return the index of the texture in the memory group.
+         */
+        unsigned int AddToMemoryGroup(vkfw_core::gfx::MemoryGroup& memGroup, std::string_view name, const std::vector<std::uint32_t>& queueFamilyIndices) const;
+
+        [[nodiscard]] BlockFormat GetBlockFormat() const { return m_format; }
+        [[nodiscard]] bool IsSRGB() const { return m_sRGB; }
+        [[nodiscard]] vk::Format GetFormat() const;
+        [[nodiscard]] glm::uvec2 GetSize() const { return m_size; }
+        [[nodiscard]] std::uint32_t GetNumberOfMipLevels() const { return static_cast<std::uint32_t>(m_mipLevels.size()); }
+        /** Returns the size of all mip levels in bytes. */
+        [[nodiscard]] std::size_t GetByteSize() const;
+
+    private:
+        CompressedTexture(BlockFormat format, bool sRGB, const glm::uvec2& size) : m_format{format}, m_sRGB{sRGB}, m_size{size} {}
+
+        /** The block format. */
+        BlockFormat m_format;
+        /** Whether the color channels are sRGB encoded. */
+        bool m_sRGB;
+        /** The size of mip level 0. */
+        glm::uvec2 m_size;
+        /** The compressed blocks of all mip levels. */
+        std::vector<std::vector<std::byte>> m_mipLevels;
+    };
+}
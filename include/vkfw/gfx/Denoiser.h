@@ -0,0 +1,101 @@
+/**
+ * @file   Denoiser.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Edge avoiding a-trous denoiser for the ray tracing convergence images.
+ */
+
+#pragma once
+
+#include "rt/denoise/denoise_host_interface.h"
+
+#include <gfx/vk/pipeline/DescriptorSetLayout.h>
+#include <gfx/vk/textures/DeviceTexture.h>
+#include <gfx/vk/wrappers/DescriptorPool.h>
+#include <gfx/vk/wrappers/DescriptorSet.h>
+#include <gfx/vk/wrappers/PipelineLayout.h>
+#include <glm/vec2.hpp>
+
+#include <span>
+#include <vector>
+
+namespace vkfw_core::gfx {
+    class LogicalDevice;
+    class CommandBuffer;
+}
+
+namespace vkfw_app::gfx {
+    class PipelineCache;
+}
+
+namespace vkfw_app::gfx::rt {
+
+    /**
+     *  Filters the convergence image of each frame by a number of a-trous wavelet iterations in compute shaders, guided by the
+     *  normals and camera distances the integrators write to the G-buffer. The convergence image itself is not changed, so the
+     *  accumulation continues unfiltered; the result is written to a separate image that is composited instead.
+     */
+    class Denoiser
+    {
+    public:
+        explicit Denoiser(vkfw_core::gfx::LogicalDevice* device);
+        ~Denoiser();
+
+        /** Creates the filter images and descriptor sets for the convergence and G-buffer images of each frame, the pipeline only once. */
+        void InitializeResources(const glm::uvec2& screenSize, std::span<vkfw_core::gfx::DeviceTexture> convergenceImages,
+                                 std::span<vkfw_core::gfx::DeviceTexture> gBufferImages);
+        /** Records the filter iterations for the convergence image of the command buffer. */
+        void RecordDenoise(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex);
+
+        /** The number of a-trous iterations, each doubles the filter footprint (1 to MaxDenoiseIterations). */
+        void SetIterations(std::uint32_t iterations);
+        [[nodiscard]] std::uint32_t GetIterations() const { return m_iterations; }
+        /** The cache the filter pipeline is created through (may be nullptr), set before InitializeResources. */
+        void SetPipelineCache(PipelineCache* pipelineCache) { m_pipelineCache = pipelineCache; }
+        /** The AO integrator only stores its result in the red channel of the convergence image. */
+        void SetMonochrome(bool monochrome) { m_monochrome = monochrome; }
+        /** The filtered image of the command buffer, holds the color in rgb and 1 in alpha (like a convergence image with a single sample). */
+        [[nodiscard]] vkfw_core::gfx::DeviceTexture& GetResultImage(std::size_t cmdBufferIndex) { return m_filterImages[2 * cmdBufferIndex]; }
+
+    private:
+        /** The descriptor sets of one frame, the source and target images alternate between the iterations. */
+        enum class FilterPass
+        {
+            ConvergenceToFirst,
+            ConvergenceToSecond,
+            SecondToFirst,
+            FirstToSecond,
+            Count
+        };
+        static constexpr std::size_t NUM_FILTER_PASSES = static_cast<std::size_t>(FilterPass::Count);
+
+        vkfw_core::gfx::DescriptorSet& GetDescriptorSet(std::size_t cmdBufferIndex, FilterPass pass);
+
+        /** The device. */
+        vkfw_core::gfx::LogicalDevice* m_device;
+        /** The persistent pipeline cache (optional). */
+        PipelineCache* m_pipelineCache = nullptr;
+        /** The number of a-trous iterations. */
+        std::uint32_t m_iterations = 4;
+        /** Whether only the red channel of the convergence images is filtered. */
+        bool m_monochrome = false;
+        /** The size of the images. */
+        glm::uvec2 m_screenSize = glm::uvec2{0};
+
+        /** Two ping-pong images per frame, the last iteration always writes the first one. */
+        std::vector<vkfw_core::gfx::DeviceTexture> m_filterImages;
+        /** The layout of the filter descriptor set (source, target and G-buffer image). */
+        vkfw_core::gfx::DescriptorSetLayout m_descriptorSetLayout;
+        /** The handle of the filter descriptor set layout. */
+        vk::DescriptorSetLayout m_descriptorSetLayoutHandle;
+        /** The descriptor pool for the filter descriptor sets. */
+        vkfw_core::gfx::DescriptorPool m_descriptorPool;
+        /** The filter descriptor sets, FilterPass::Count per frame. */
+        std::vector<vkfw_core::gfx::DescriptorSet> m_descriptorSets;
+        /** The pipeline layout with the iteration parameters as push constants. */
+        vkfw_core::gfx::PipelineLayout m_pipelineLayout;
+        /** The compute pipeline of a single iteration. */
+        vk::UniquePipeline m_pipeline;
+    };
+}
@@ -0,0 +1,100 @@
+/**
+ * @file   GPUTimeline.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  GPU timestamp queries feeding the application timeline.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace vkfw_core::gfx {
+    class LogicalDevice;
+    class CommandBuffer;
+}
+
+namespace vkfw_app::gfx {
+
+    /**
+     *  Manages timestamp queries for pre-recorded primary command buffers.
+     *  Each command buffer index owns a fixed range of queries that is reset at the start of recording.
+     */
+    class GPUTimeline
+    {
+    public:
+        /** The maximum number of regions per command buffer. */
+        static constexpr std::uint32_t MAX_REGIONS = 32;
+
+        GPUTimeline(vkfw_core::gfx::LogicalDevice* device, std::size_t numCmdBuffers);
+
+        /** Has to be recorded at the start of a command buffer (outside of any render pass). */
+        void ResetQueries(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex);
+        /** Records a begin time stamp, returns the region index for EndRegion. */
+        std::uint32_t BeginRegion(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const char* name);
+        void EndRegion(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, std::uint32_t region);
+
+        /** Marks the command buffer as submitted, the CPU time is used to place the GPU events on the timeline. */
+        void MarkSubmitted(std::size_t cmdBufferIndex);
+        /** Reads back the queries of a finished command buffer and records them on the timelines GPU track. */
+        void CollectResults(std::size_t cmdBufferIndex);
+
+    private:
+        struct Region
+        {
+            const char* m_name = nullptr;
+            bool m_closed = false;
+        };
+
+        struct CmdBufferQueries
+        {
+            /** The regions recorded into the command buffer. */
+            std::vector<Region> m_regions;
+            /** The CPU time of the last submit. */
+            std::uint64_t m_submitTime = 0;
+            /** Whether results are outstanding. */
+            bool m_pending = false;
+        };
+
+        std::uint32_t QueryIndex(std::size_t cmdBufferIndex, std::uint32_t region, bool end) const
+        {
+            return static_cast<std::uint32_t>(cmdBufferIndex) * 2 * MAX_REGIONS + 2 * region + (end ? 1 : 0);
+        }
+
+        /** The device. */
+        vkfw_core::gfx::LogicalDevice* m_device;
+        /** The query pool. */
+        vk::UniqueQueryPool m_queryPool;
+        /** Nanoseconds per time stamp tick. */
+        double m_timestampPeriod = 1.0;
+        /** The queries per command buffer. */
+        std::vector<CmdBufferQueries> m_cmdBufferQueries;
+    };
+
+    /** Scoped GPU timeline region, does nothing if no timeline is given. */
+    class GPUTimelineRegion
+    {
+    public:
+        GPUTimelineRegion(GPUTimeline* timeline, vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const char* name)
+            : m_timeline{timeline}, m_cmdBuffer{cmdBuffer}, m_cmdBufferIndex{cmdBufferIndex}
+        {
+            if (m_timeline != nullptr) { m_region = m_timeline->BeginRegion(m_cmdBuffer, m_cmdBufferIndex, name); }
+        }
+        ~GPUTimelineRegion()
+        {
+            if (m_timeline != nullptr) { m_timeline->EndRegion(m_cmdBuffer, m_cmdBufferIndex, m_region); }
+        }
+        GPUTimelineRegion(const GPUTimelineRegion&) = delete;
+        GPUTimelineRegion& operator=(const GPUTimelineRegion&) = delete;
+
+    private:
+        GPUTimeline* m_timeline;
+        vkfw_core::gfx::CommandBuffer& m_cmdBuffer;
+        std::size_t m_cmdBufferIndex;
+        std::uint32_t m_region = 0;
+    };
+}
@@ -0,0 +1,52 @@
+/**
+ * @file   LightSampler.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Power weighted sampling of emissive triangles for next event estimation.
+ */
+
+#pragma once
+
+#include "rt/rt_sample_host_interface.h"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace vkfw_app::gfx {
+
+    /** An emissive triangle in world space. */
+    struct EmissiveTriangle
+    {
+        std::array<glm::vec3, 3> m_vertices;
+        glm::vec3 m_Le = glm::vec3{0.0f};
+    };
+
+    /**
+     *  Builds the light triangles and an alias table over them, a triangle is selected proportional to
+     *  its power (luminance times area) in constant time on the GPU.
+     */
+    class LightSampler
+    {
+    public:
+        explicit LightSampler(std::span<const EmissiveTriangle> triangles);
+
+        /** The light triangles, contains a single dummy triangle if there are no emitters (descriptors need non empty buffers). */
+        [[nodiscard]] const std::vector<scene::rt::LightTriangle>& GetLightTriangles() const { return m_lightTriangles; }
+        /** The alias table, one entry per light triangle. */
+        [[nodiscard]] const std::vector<scene::rt::LightAliasEntry>& GetAliasTable() const { return m_aliasTable; }
+        /** The number of light triangles that can be sampled (0 if there are no emitters). */
+        [[nodiscard]] std::uint32_t GetNumLightTriangles() const { return m_numLightTriangles; }
+
+    private:
+        /** The light triangles. */
+        std::vector<scene::rt::LightTriangle> m_lightTriangles;
+        /** The alias table. */
+        std::vector<scene::rt::LightAliasEntry> m_aliasTable;
+        /** The number of light triangles that can be sampled. */
+        std::uint32_t m_numLightTriangles = 0;
+    };
+}
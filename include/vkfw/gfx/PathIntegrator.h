@@ -10,17 +10,85 @@
 
 #include "gfx/RTIntegrator.h"
 
+#include <gfx/vk/memory/MemoryGroup.h>
+#include <gfx/vk/pipeline/DescriptorSetLayout.h>
+#include <gfx/vk/wrappers/DescriptorPool.h>
+#include <gfx/vk/wrappers/DescriptorSet.h>
+
+#include <memory>
+
 namespace vkfw_app::gfx::rt {
 
+    /**
+     *  Path tracer lit by the sky and emissive triangles (next event estimation with shadow rays, MIS for the emitters,
+     *  diffuse Phong and mirror materials).
+     *  The megakernel traces complete paths in one ray generation shader, the wavefront mode splits each bounce into
+     *  extend, shade (one pass per material bin) and shadow stages communicating through queues in storage buffers.
+     */
     class PathIntegrator : public RTIntegrator
     {
     public:
-        PathIntegrator(vkfw_core::gfx::LogicalDevice* device);
+        enum class Mode
+        {
+            Megakernel,
+            Wavefront
+        };
+
+        PathIntegrator(vkfw_core::gfx::LogicalDevice* device, Mode mode);
         ~PathIntegrator() override;
 
+        std::string_view GetCompositeShaderName() const override { return "shader/rt/path/path_composite.frag"; }
+        vk::DescriptorSetLayout GetIntegratorDescriptorSetLayout() const override { return m_pathDescriptorSetLayoutHandle; }
+        void InitializeResources(const glm::uvec2& screenSize, std::size_t numCmdBuffers) override;
+        std::uint64_t GetTracedRays(std::size_t cmdBufferIndex) const override;
+
+        void InitializePipeline(const vkfw_core::gfx::PipelineLayout& pipelineLayout) override;
         void TraceRays(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const glm::u32vec4& rtGroups) override;
 
     private:
         std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> GetShaders() const override;
+        std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> GetTracingStageShaders(std::string_view raygenShader) const;
+        void BindDescriptorSets(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex);
+        void TraceWavefront(vkfw_core::gfx::CommandBuffer& cmdBuffer, const glm::u32vec4& rtGroups);
+        void TraceStageIndirect(vkfw_core::gfx::CommandBuffer& cmdBuffer, vkfw_core::gfx::RayTracingPipeline& pipeline, std::size_t counterOffset);
+        void RecordCounterUpdate(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t offset, std::size_t size, const void* data);
+        void RecordReadback(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex);
+
+        /** Megakernel or wavefront path tracing. */
+        Mode m_mode;
+        /** The number of pixels, each queue holds one element per pixel. */
+        std::uint32_t m_queueCapacity = 0;
+
+        /** The layout of the path tracing descriptor set (counters, queues and radiance in wavefront mode). */
+        vkfw_core::gfx::DescriptorSetLayout m_pathDescriptorSetLayout;
+        /** The handle of the path tracing descriptor set layout. */
+        vk::DescriptorSetLayout m_pathDescriptorSetLayoutHandle;
+        /** The descriptor pool for the path tracing descriptor set. */
+        vkfw_core::gfx::DescriptorPool m_descriptorPool;
+        /** The path tracing descriptor set. */
+        vkfw_core::gfx::DescriptorSet m_pathDescriptorSet;
+        /** Holds the counters and the queues. */
+        std::unique_ptr<vkfw_core::gfx::MemoryGroup> m_queueMemGroup;
+        /** The buffer indices of counters, ray queues, hit queues, shadow queue and radiance in the memory group. */
+        unsigned int m_countersBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        unsigned int m_rayQueuesBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        unsigned int m_hitQueuesBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        unsigned int m_shadowQueueBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        unsigned int m_radianceBufferIdx = vkfw_core::gfx::MemoryGroup::INVALID_INDEX;
+        /** The device address of the counters used for indirect tracing. */
+        vk::DeviceAddress m_countersAddress = 0;
+
+        /** The wavefront stages. */
+        vkfw_core::gfx::RayTracingPipeline m_generatePipeline;
+        vkfw_core::gfx::RayTracingPipeline m_extendPipeline;
+        vkfw_core::gfx::RayTracingPipeline m_shadePhongPipeline;
+        vkfw_core::gfx::RayTracingPipeline m_shadeMirrorPipeline;
+        vkfw_core::gfx::RayTracingPipeline m_shadowPipeline;
+        vkfw_core::gfx::RayTracingPipeline m_accumulatePipeline;
+
+        /** Host visible copy of the ray statistics (extension and shadow rays) per command buffer. */
+        vk::UniqueBuffer m_readbackBuffer;
+        vk::UniqueDeviceMemory m_readbackMemory;
+        const std::uint32_t* m_readbackData = nullptr;
     };
 }
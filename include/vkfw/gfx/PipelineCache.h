@@ -0,0 +1,74 @@
+/**
+ * @file   PipelineCache.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Vulkan pipeline cache persisted in the working directory.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+
+namespace vkfw_core::gfx {
+    class LogicalDevice;
+}
+
+namespace vkfw_app::gfx {
+
+    /**
+     *  Loads a VkPipelineCache at startup and writes it back on destruction. The file is named after the pipeline cache UUID
+     *  of the driver, so a driver update starts with an empty cache instead of handing incompatible data to the driver. The
+     *  driver itself keys the entries by the shader code and pipeline state. Only the compute pipelines and the compositing
+     *  pipeline of the application go through the cache, the pipelines created by vkfw_core take no pipeline cache.
+     */
+    class PipelineCache
+    {
+    public:
+        explicit PipelineCache(vkfw_core::gfx::LogicalDevice* device);
+        ~PipelineCache();
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        [[nodiscard]] vk::PipelineCache GetHandle() const { return *m_pipelineCache; }
+
+        /**
+         *  Creates a compute pipeline through the cache and logs its creation time. A pipeline counts as a cache hit if the
+         *  cache did not grow by creating it (drivers add an entry for every compiled pipeline).
+         */
+        [[nodiscard]] vk::UniquePipeline CreateComputePipeline(const vk::ComputePipelineCreateInfo& createInfo, std::string_view name);
+        /** Creates a graphics pipeline through the cache, like CreateComputePipeline. */
+        [[nodiscard]] vk::UniquePipeline CreateGraphicsPipeline(const vk::GraphicsPipelineCreateInfo& createInfo, std::string_view name);
+        /** Writes the cache to disk (also done on destruction). */
+        void Save() const;
+
+    private:
+        [[nodiscard]] std::size_t GetDataSize() const;
+        /** Creates a pipeline by the given function and counts the hit or miss. */
+        [[nodiscard]] vk::UniquePipeline CreatePipeline(const std::function<vk::ResultValue<vk::UniquePipeline>(vk::PipelineCache)>& create, std::string_view name);
+
+        /** The device. */
+        vkfw_core::gfx::LogicalDevice* m_device;
+        /** The file the cache is loaded from and saved to. */
+        std::filesystem::path m_filename;
+        /** The pipeline cache. */
+        vk::UniquePipelineCache m_pipelineCache;
+        /** The number of pipelines found in and missing from the cache. */
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+        /** The time spent creating pipelines through the cache in milliseconds. */
+        double m_creationTime = 0.0;
+    };
+
+    /** Creates a compute pipeline through the cache or without one if pipelineCache is nullptr, throws on failure. */
+    [[nodiscard]] vk::UniquePipeline CreateComputePipeline(vkfw_core::gfx::LogicalDevice* device, PipelineCache* pipelineCache,
+                                                           const vk::ComputePipelineCreateInfo& createInfo, std::string_view name);
+    /** Creates a graphics pipeline through the cache or without one if pipelineCache is nullptr, throws on failure. */
+    [[nodiscard]] vk::UniquePipeline CreateGraphicsPipeline(vkfw_core::gfx::LogicalDevice* device, PipelineCache* pipelineCache,
+                                                            const vk::GraphicsPipelineCreateInfo& createInfo, std::string_view name);
+}
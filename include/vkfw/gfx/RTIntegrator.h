@@ -19,6 +19,10 @@ namespace vkfw_core::gfx {
     class UniformBufferObject;
 }
 
+namespace vkfw_app::gfx {
+    class PipelineCache;
+}
+
 namespace vkfw_app::gfx::rt {
 
     class RTIntegrator
@@ -30,13 +34,25 @@ namespace vkfw_app::gfx::rt {
         std::string_view GetName() const { return m_integratorName; }
         const std::vector<std::uint32_t>& GetMaterialSBTMapping() const { return m_materialSBTMapping; }
 
-        void InitializePipeline(const vkfw_core::gfx::PipelineLayout& pipelineLayout);
+        /** The fragment shader compositing the convergence image. */
+        virtual std::string_view GetCompositeShaderName() const { return "shader/rt/ao/ao_composite.frag"; }
+        /** The layout of the integrator specific descriptor set (IntegratorSet), an empty handle if the integrator has none. */
+        virtual vk::DescriptorSetLayout GetIntegratorDescriptorSetLayout() const { return vk::DescriptorSetLayout{}; }
+        /** Creates screen sized resources, called before InitializePipeline. */
+        virtual void InitializeResources([[maybe_unused]] const glm::uvec2& screenSize, [[maybe_unused]] std::size_t numCmdBuffers) {}
+        /** The number of rays traced by the last finished frame of the command buffer, 0 if the integrator does not count rays. */
+        virtual std::uint64_t GetTracedRays([[maybe_unused]] std::size_t cmdBufferIndex) const { return 0; }
+
+        /** The cache the integrators own pipelines are created through (may be nullptr), set before InitializePipeline. */
+        void SetPipelineCache(PipelineCache* pipelineCache) { m_pipelineCache = pipelineCache; }
+        virtual void InitializePipeline(const vkfw_core::gfx::PipelineLayout& pipelineLayout);
         void InitializeMisc(const vkfw_core::gfx::UniformBufferObject& cameraUBO, vkfw_core::gfx::DescriptorSet& rtResourcesDescriptorSet, std::vector<vkfw_core::gfx::DescriptorSet>& convergenceImageDescriptorSets);
 
         virtual void TraceRays(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const glm::u32vec4& rtGroups) = 0;
 
     protected:
         vkfw_core::gfx::LogicalDevice* GetDevice() const { return m_device; }
+        PipelineCache* GetPipelineCache() const { return m_pipelineCache; }
 
         const vkfw_core::gfx::PipelineLayout& GetPipelineLayout() const { return *m_rtPipelineLayout; }
         vkfw_core::gfx::RayTracingPipeline& GetPipeline() { return m_rtPipeline; }
@@ -46,11 +62,18 @@ namespace vkfw_app::gfx::rt {
 
         std::vector<std::uint32_t>& materialSBTMapping() { return m_materialSBTMapping; }
         virtual std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> GetShaders() const = 0;
+        /**
+         *  Appends the occlusion ray type: its miss shader (OcclusionMissIndex) and one alpha tested any hit group per
+         *  material hit group starting at hitGroupOffset, without closest hit shaders.
+         */
+        void AddOcclusionShaders(std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo>& shaders, std::uint32_t hitGroupOffset, std::uint32_t numMaterialHitGroups) const;
 
     private:
         std::string_view m_integratorName;
         std::uint32_t m_maxRecursionDepth;
         vkfw_core::gfx::LogicalDevice* m_device;
+        /** The persistent pipeline cache (optional). */
+        PipelineCache* m_pipelineCache = nullptr;
         /** The raytracing pipeline. */
         vkfw_core::gfx::RayTracingPipeline m_rtPipeline;
 
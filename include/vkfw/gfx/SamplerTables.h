@@ -0,0 +1,27 @@
+/**
+ * @file   SamplerTables.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Tables for the low discrepancy and blue noise sample generators of the ray tracing shaders.
+ */
+
+#pragma once
+
+#include "rt/rt_sample_host_interface.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace vkfw_app::gfx {
+
+    /** The direction numbers of the first SobolDimensions Sobol dimensions, SobolBits numbers per dimension. */
+    [[nodiscard]] std::vector<std::uint32_t> CreateSobolDirections();
+    /**
+     *  A tileable BlueNoiseSize x BlueNoiseSize blue noise mask created by the void and cluster method.
+     *  Every pixel holds its rank, the ranks are a permutation of [0, BlueNoiseSize^2).
+     */
+    [[nodiscard]] std::vector<std::uint32_t> CreateBlueNoise(std::uint32_t seed);
+    /** The content of the sampler tables buffer as described by SamplerTableLayout (two blue noise channels packed per pixel). */
+    [[nodiscard]] std::vector<std::uint32_t> CreateSamplerTables();
+}
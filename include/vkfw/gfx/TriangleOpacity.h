@@ -0,0 +1,62 @@
+/**
+ * @file   TriangleOpacity.h
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Classification of triangles against the alpha channel of their textures.
+ */
+
+#pragma once
+
+#include "rt/rt_sample_host_interface.h"
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace vkfw_core::gfx {
+    class MeshInfo;
+}
+
+namespace vkfw_app::gfx {
+
+    /** The opacity classes of the triangles of a mesh. */
+    struct TriangleOpacity
+    {
+        /** TriangleOpacityBits per triangle (scene::rt::TriangleOpacityClass) in the order of the index buffer. */
+        std::vector<std::uint32_t> m_classes;
+        /** The number of opaque, transparent and mixed triangles. */
+        std::array<std::size_t, 3> m_counts = {};
+    };
+
+    /** The alpha channel of a texture. */
+    struct AlphaMask
+    {
+        std::int64_t m_width = 0;
+        std::int64_t m_height = 0;
+        std::vector<std::uint8_t> m_alpha;
+        /** The class of the whole texture, triangles on textures with a single class need no rasterization. */
+        std::uint32_t m_textureClass = static_cast<std::uint32_t>(scene::rt::TriangleOpacityClass::TriangleOpaque);
+
+        [[nodiscard]] std::uint8_t GetWrapped(std::int64_t x, std::int64_t y) const
+        {
+            x = ((x % m_width) + m_width) % m_width;
+            y = ((y % m_height) + m_height) % m_height;
+            return m_alpha[static_cast<std::size_t>(y * m_width + x)];
+        }
+    };
+
+    /** Creates the mask of a width x height texture from its alpha values (row major) and classifies the whole texture. */
+    [[nodiscard]] AlphaMask CreateAlphaMask(std::int64_t width, std::int64_t height, std::vector<std::uint8_t> alpha);
+    /** Classifies a single triangle by its texture coordinates against the mask (scene::rt::TriangleOpacityClass). */
+    [[nodiscard]] std::uint32_t ClassifyTriangle(const AlphaMask& mask, const std::array<glm::vec2, 3>& texCoords);
+
+    /**
+     *  Classifies the triangles of a mesh by rasterizing their UV footprint against the alpha channel of the diffuse texture.
+     *  A triangle is opaque (or transparent) if all texels the footprint touches, extended by the reach of the bilinear
+     *  filter, are. Triangles without an alpha tested material are opaque.
+     */
+    [[nodiscard]] TriangleOpacity ClassifyTriangleOpacity(const vkfw_core::gfx::MeshInfo& mesh);
+}
@@ -1,13 +1,11 @@
 #ifndef SHADER_CORE_SAMPLING
 #define SHADER_CORE_SAMPLING
 
-#include "random.glsl"
-
 const float M_PI = 3.14159265359;
 
-void sampleCameraRay(out vec3 origin, out vec3 direction, CameraParameters cam, inout uint rngState) {
-    const vec2 pixelCenter = vec2(gl_LaunchIDEXT.xy) + vec2(rand(rngState), rand(rngState));
-    const vec2 inUV = pixelCenter / vec2(gl_LaunchSizeEXT.xy);
+void sampleCameraRay(out vec3 origin, out vec3 direction, CameraParameters cam, uvec2 pixel, uvec2 imageSize, vec2 u) {
+    const vec2 pixelCenter = vec2(pixel) + u;
+    const vec2 inUV = pixelCenter / vec2(imageSize);
     vec2 d = inUV * 2.0 - 1.0;
 
     origin = (cam.viewInverse * vec4(0,0,0,1)).xyz;
@@ -15,9 +13,20 @@ void sampleCameraRay(out vec3 origin, out vec3 direction, CameraParameters cam,
     direction = (cam.viewInverse * vec4(normalize(target.xyz / target.w), 0)).xyz;
 }
 
-vec3 sampleUniformHemisphere(vec3 normal, vec3 tangent, vec3 binormal, inout uint rngState) {
-    float r1 = rand(rngState);
-    float r2 = rand(rngState);
+#ifdef RAYGEN
+void sampleCameraRay(out vec3 origin, out vec3 direction, CameraParameters cam, vec2 u) {
+    sampleCameraRay(origin, direction, cam, gl_LaunchIDEXT.xy, gl_LaunchSizeEXT.xy, u);
+}
+#endif
+
+// with checkerboard rendering only every other pixel traces, the two halves alternate between the frames of a convergence image.
+bool isTracedThisFrame(CameraParameters cam, uvec2 pixel) {
+    return cam.checkerboard == 0 || ((pixel.x + pixel.y) & 1u) == cam.checkerboard - 1;
+}
+
+vec3 sampleUniformHemisphere(vec3 normal, vec3 tangent, vec3 binormal, vec2 u) {
+    float r1 = u.x;
+    float r2 = u.y;
     float sq = sqrt(1.0 - r2);
 
     vec3 direction = vec3(cos(2 * M_PI * r1) * sq, sin(2 * M_PI * r1) * sq, sqrt(r2));
@@ -30,10 +39,9 @@ float uniformHemispherePDF() {
     return 1.0f / (2.0f * M_PI);
 }
 
-vec2 sampleUniformDiskConcentric(inout uint rngState) {
+vec2 sampleUniformDiskConcentric(vec2 u) {
     // from PBRT v4
     // Map _u_ to $[-1,1]^2$ and handle degeneracy at the origin
-    vec2 u = vec2(rand(rngState), rand(rngState));
     vec2 uOffset = 2.0f * u - vec2(1.0f, 1.0f);
     if (uOffset.x == 0.0f && uOffset.y == 0.0f)
         return vec2(0.0f);
@@ -50,9 +58,9 @@ vec2 sampleUniformDiskConcentric(inout uint rngState) {
     return r * vec2(cos(theta), sin(theta));
 }
 
-vec3 sampleCosineHemisphere(vec3 normal, vec3 tangent, vec3 binormal, inout uint rngState) {
+vec3 sampleCosineHemisphere(vec3 normal, vec3 tangent, vec3 binormal, vec2 u) {
     // from PBRT v4
-    vec2 d = sampleUniformDiskConcentric(rngState);
+    vec2 d = sampleUniformDiskConcentric(u);
     float z2 = min(1.0f, dot(d, d));
     float z = sqrt(1.0f - z2);
 
@@ -14,7 +14,8 @@ BEGIN_INTERFACE(materials)
 BEGIN_CONSTANTS(MaterialIdentifierApp)
     MirrorMaterialType = CALC_MATERIAL_ENUM(0),
     GlassMaterialType = CALC_MATERIAL_ENUM(1),
-    TotalMaterialCount = CALC_MATERIAL_ENUM(2)
+    EmissiveMaterialType = CALC_MATERIAL_ENUM(2),
+    TotalMaterialCount = CALC_MATERIAL_ENUM(3)
 END_CONSTANTS()
 
 struct MirrorMaterial
@@ -22,6 +23,14 @@ struct MirrorMaterial
     vec3 Kr;
 };
 
+struct EmissiveMaterial
+{
+    /** Emitted radiance (both sides). */
+    vec3 Le;
+    /** Index of the first triangle of the geometry in the light triangles, the primitive id is added. */
+    uint firstLightTriangle;
+};
+
 END_INTERFACE()
 
 #endif // MATERIAL_SAMPLE_HOST_INTERFACE
@@ -0,0 +1,48 @@
+#ifndef SHADER_RT_ALPHA_TEST
+#define SHADER_RT_ALPHA_TEST
+
+// Alpha testing in any hit shaders, has to be included after rt_sample_host_interface.h and rayCone.glsl.
+
+hitAttributeEXT vec2 attribs;
+
+#include "geometry.glsl"
+layout(scalar, binding = InstanceInfos, set = RTResourcesSet) buffer InstanceInfosBuffer { InstanceDesc i[]; } instances;
+layout(scalar, binding = PhongBumpMaterialInfos, set = RTResourcesSet) buffer PhongMaterialInfosBuffer { PhongBumpMaterial m[]; } phongMaterials;
+layout(scalar, binding = MirrorMaterialInfos, set = RTResourcesSet) buffer MirrorMaterialInfosBuffer { MirrorMaterial m[]; } mirrorMaterials;
+layout(binding = Textures, set = RTResourcesSet) uniform sampler2D textures[];
+
+#include "triangleOpacity.glsl"
+
+// the alpha of the material at the current hit, for a ray cone of the given width at the ray origin.
+float alphaAtHit(float coneWidth, float coneSpreadAngle)
+{
+    // most triangles are classified as opaque or transparent, no vertex or texture fetches for them.
+    uint opacityClass = triangleOpacityClass(gl_InstanceID, gl_PrimitiveID);
+    if (opacityClass == TriangleOpaque) return 1.0f;
+    if (opacityClass == TriangleTransparent) return 0.0f;
+
+    uint materialType = instances.i[gl_InstanceID].materialType;
+    if (materialType != PhongBumpMaterialType) return 1.0f;
+
+    const vec3 barycentricCoords = vec3(1.0f - attribs.x - attribs.y, attribs.x, attribs.y);
+
+    uint bufferIndex = instances.i[gl_InstanceID].bufferIndex;
+    uint indexOffset = instances.i[gl_InstanceID].indexOffset;
+
+    uvec3 ind = loadTriangleIndices(bufferIndex, indexOffset, gl_PrimitiveID);
+
+    RayTracingVertex v0 = loadVertex(bufferIndex, ind.x);
+    RayTracingVertex v1 = loadVertex(bufferIndex, ind.y);
+    RayTracingVertex v2 = loadVertex(bufferIndex, ind.z);
+
+    vec2 texCoords = v0.texCoords * barycentricCoords.x + v1.texCoords * barycentricCoords.y + v2.texCoords * barycentricCoords.z;
+
+    uint materialIndex = instances.i[gl_InstanceID].materialIndex;
+    uint diffuseTextureIndex = phongMaterials.m[nonuniformEXT(materialIndex)].diffuseTextureIndex;
+    // any hit shaders run for most traversal steps through alpha tested geometry, fetching the matching mip level saves most of the bandwidth.
+    float hitConeWidth = rayConeWidthAtHit(coneWidth, coneSpreadAngle, gl_HitTEXT);
+    float lod = cam.rayConeLod == 1 ? rayConeTextureLod(instances.i[gl_InstanceID].transform, v0, v1, v2, vec2(textureSize(textures[nonuniformEXT(diffuseTextureIndex)], 0)), hitConeWidth) : 0.0f;
+    return textureLod(textures[nonuniformEXT(diffuseTextureIndex)], texCoords, lod).a;
+}
+
+#endif // SHADER_RT_ALPHA_TEST
@@ -0,0 +1,185 @@
+#ifndef SHADER_RT_AO_INTEGRATOR
+#define SHADER_RT_AO_INTEGRATOR
+
+// The ambient occlusion integrator, the includer defines findNextNonSpecularHit and isOccluded (ray tracing pipeline or ray queries).
+// Has to be included after rt_sample_host_interface.h, sampling.glsl and sampleGenerator.glsl.
+
+layout(binding = ResultImage, set = ConvergenceSet, rgba32f) uniform writeonly image2D image;
+layout(binding = GBufferImage, set = ConvergenceSet, rgba32f) uniform writeonly image2D gBuffer;
+layout(binding = HistoryImage, set = ConvergenceSet, rgba32f) uniform readonly image2D history;
+layout(binding = HistoryGBufferImage, set = ConvergenceSet, rgba32f) uniform readonly image2D historyGBuffer;
+layout(binding = AdaptiveSampling, set = ConvergenceSet) buffer AdaptiveSamplingBuffer { AdaptiveSamplingStats stats; };
+
+const float aoRayCount = 16;
+// adaptive sampling: a pixel needs at least this many AO samples before it can be converged.
+const float minConvergenceSamples = 256;
+// the ray budget freed by converged pixels is distributed up to this many rays per pixel and frame.
+const float maxAdaptiveRayCount = 128;
+// a reprojected history is clamped to this many AO samples, so moving surfaces keep adapting (below minConvergenceSamples, they are never converged).
+const float maxReprojectedSamples = 128;
+// disocclusion tests of the reprojection: minimum cosine between the normals and tolerance of the camera distance relative to the expected one.
+const float reprojectionNormalThreshold = 0.9f;
+const float reprojectionDepthThreshold = 0.05f;
+
+vec3 face_forward(vec3 direction, vec3 normal)
+{
+    if (dot(normal, direction) > 0.0f) normal *= -1;
+    return normal;
+}
+
+void compute_default_basis(const vec3 normal, out vec3 tangent, out vec3 binormal)
+{
+  if(abs(normal.x) > abs(normal.y))
+    tangent = vec3(normal.z, 0, -normal.x) / sqrt(normal.x * normal.x + normal.z * normal.z);
+  else
+    tangent = vec3(0, -normal.z, normal.y) / sqrt(normal.y * normal.y + normal.z * normal.z);
+  binormal = cross(normal, tangent);
+}
+
+// the standard error of the mean has to fall below the threshold relative to the mean (with a floor for dark pixels).
+bool isConverged(float aoValue, float aoSquared, float aoNormalize)
+{
+    if (aoNormalize < minConvergenceSamples) return false;
+    float mean = aoValue / aoNormalize;
+    float variance = max(aoSquared / aoNormalize - mean * mean, 0.0f);
+    float standardError = sqrt(variance / aoNormalize);
+    return standardError <= cam.convergenceThreshold * max(mean, 0.1f);
+}
+
+// bilinearly filters the history at the position of the hit in the previous frame, taps failing the disocclusion tests are dropped.
+vec4 reprojectHistory(vec3 position, vec3 normal, uvec2 launchSize)
+{
+    vec4 prevClip = cam.prevViewProj * vec4(position, 1.0f);
+    if (prevClip.w <= 0.0f) return vec4(0.0f);
+    vec2 prevPixel = (prevClip.xy / prevClip.w * 0.5f + 0.5f) * vec2(launchSize) - 0.5f;
+    ivec2 basePixel = ivec2(floor(prevPixel));
+    vec2 f = prevPixel - vec2(basePixel);
+    float expectedDistance = length(position - cam.prevCameraPosition.xyz);
+
+    vec4 result = vec4(0.0f);
+    float weightSum = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 tap = basePixel + offset;
+        if (any(lessThan(tap, ivec2(0))) || any(greaterThanEqual(tap, ivec2(launchSize)))) continue;
+
+        vec4 prevSurface = imageLoad(historyGBuffer, tap);
+        if (prevSurface.w <= 0.0f) continue;
+        if (dot(prevSurface.xyz, normal) < reprojectionNormalThreshold) continue;
+        if (abs(prevSurface.w - expectedDistance) > reprojectionDepthThreshold * expectedDistance) continue;
+
+        vec2 bilinear = mix(1.0f - f, f, vec2(offset));
+        float weight = bilinear.x * bilinear.y;
+        result += weight * imageLoad(history, tap);
+        weightSum += weight;
+    }
+    if (weightSum < 1e-3f) return vec4(0.0f);
+
+    // the sums and the sample counts are scaled together, which keeps the mean and limits the weight of the history.
+    result /= weightSum;
+    if (result.a > maxReprojectedSamples) result *= maxReprojectedSamples / result.a;
+    return result;
+}
+
+// traces the AO of one pixel and accumulates it, shared by the ray tracing pipeline and the ray query backend.
+void integrateAO(uvec2 launchId, uvec2 launchSize)
+{
+    const ivec2 pixel = ivec2(launchId);
+    // the previous frame accumulated into another convergence image, a static camera continues with the same pixel.
+    vec4 resultColor = vec4(0.0f);
+    vec4 gBufferValue = vec4(0.0f);
+    if (cam.historyMode == uint(HistoryStatic)) {
+        resultColor = imageLoad(history, pixel);
+        gBufferValue = imageLoad(historyGBuffer, pixel);
+    }
+
+    // r: sum of AO samples, g: sum of squared AO samples, b: primary hits, a: number of AO samples.
+    float aoValue = resultColor.r;
+    float aoSquared = resultColor.g;
+    float traceHits = resultColor.b;
+    float aoNormalize = resultColor.a;
+
+    const bool adaptive = cam.adaptiveSampling == 1;
+    if (adaptive && isConverged(aoValue, aoSquared, aoNormalize)) {
+        // the accumulated result and the G-buffer are carried over as they are.
+        imageStore(image, pixel, resultColor);
+        imageStore(gBuffer, pixel, gBufferValue);
+        return;
+    }
+
+    const bool cosSample = cam.cosineSampled == 1;
+    SampleGenerator cameraSg = initSampleGenerator(launchId, cam.frameId, 0);
+
+    vec3 origin, direction;
+    sampleCameraRay(origin, direction, cam, launchId, launchSize, sample2D(cameraSg));
+    float tmax = 10000.0;
+    vec3 normal;
+    // primary ray cones start at the camera with the spread angle of a pixel.
+    float coneWidth = 0.0f;
+
+    vec3 cameraOrigin = origin;
+    bool hit = findNextNonSpecularHit(origin, direction, normal, tmax, coneWidth, cam.pixelSpreadAngle);
+    gBufferValue = vec4(0.0f);
+    if (hit) {
+        vec3 n = face_forward(direction, normal);
+        vec3 s, t;
+        compute_default_basis(n, s, t);
+        vec3 p = origin;
+        gBufferValue = vec4(n, length(p - cameraOrigin));
+
+        if (cam.historyMode == uint(HistoryReproject)) {
+            vec4 reprojected = reprojectHistory(p, n, launchSize);
+            aoValue = reprojected.r;
+            aoSquared = reprojected.g;
+            traceHits = reprojected.b;
+            aoNormalize = reprojected.a;
+        }
+        traceHits += 1.0f;
+
+        float rayCount = aoRayCount;
+        if (!isTracedThisFrame(cam, launchId)) {
+            // the other half of the checkerboard traces AO rays, this pixel only carries its history over.
+            rayCount = 0.0f;
+        } else if (adaptive) {
+            atomicAdd(stats.activePixels, 1);
+            // spend the budget of all pixels on the pixels that were still active last time this image was traced.
+            // after a reset all pixels are active and the counter of the previous frame is meaningless.
+            if (cam.cameraMovedThisFrame != 1 && stats.lastActivePixels > 0) {
+                float numPixels = float(launchSize.x * launchSize.y);
+                rayCount = clamp(floor(aoRayCount * numPixels / float(stats.lastActivePixels)), aoRayCount, maxAdaptiveRayCount);
+            }
+        }
+
+        for (int i = 0; i < int(rayCount); ++i) {
+            // every AO ray is its own sample of the sequence, the frames do not overlap as long as maxAdaptiveRayCount is not exceeded.
+            SampleGenerator sg = initSampleGenerator(launchId, cam.frameId * uint(maxAdaptiveRayCount) + uint(i), 1);
+            vec3 sample_direction;
+            float pdf;
+            if (!cosSample)
+            {
+                sample_direction = sampleUniformHemisphere(n, s, t, sample2D(sg));
+                pdf = uniformHemispherePDF();
+            }
+            else
+            {
+                sample_direction = sampleCosineHemisphere(n, s, t, sample2D(sg));
+                pdf = cosineHemispherePDF(abs(sample_direction.z));
+            }
+
+            // ambient occlusion rays start with the footprint of the primary hit, keeping the pixel spread is conservative (sharper) for diffuse rays.
+            float aoSample = 0.0f;
+            if (!isOccluded(p, sample_direction, cam.maxRange, coneWidth, cam.pixelSpreadAngle)) {
+                aoSample = dot(sample_direction, n) / (M_PI * pdf);
+            }
+            aoValue += aoSample;
+            aoSquared += aoSample * aoSample;
+            aoNormalize += 1.0f;
+        }
+    }
+
+    resultColor = vec4(aoValue, aoSquared, traceHits, aoNormalize);
+    imageStore(image, pixel, resultColor);
+    imageStore(gBuffer, pixel, gBufferValue);
+}
+
+#endif // SHADER_RT_AO_INTEGRATOR
@@ -8,9 +8,13 @@ layout(location = 0) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
 
 layout(set = ConvergenceSet, binding = AccumulatedImage) uniform sampler2D accumulatedImage;
+layout(set = ConvergenceSet, binding = GuideImage) uniform sampler2D guideImage;
+
+vec3 resolve(vec4 accumulated) { return vec3(accumulated.r / accumulated.a); }
+
+#include "../reconstruct.glsl"
 
 void main()
 {
-    vec4 accumulatedColor = texture(accumulatedImage, fragTexCoord);
-    outColor = vec4(vec3(accumulatedColor.r / accumulatedColor.a), 1.0f);
+    outColor = vec4(reconstruct(accumulatedImage, guideImage, fragTexCoord), 1.0f);
 }
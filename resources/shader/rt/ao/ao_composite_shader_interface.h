@@ -11,7 +11,9 @@ END_CONSTANTS()
 
 BEGIN_CONSTANTS(CompositeConvSetBindings)
     AccumulatedImage = 0,
-    ConvSetBindingsSize = 1
+    /** The G-buffer of the traced pixels, guides the reconstruction at the output resolution. */
+    GuideImage = 1,
+    ConvSetBindingsSize = 2
 END_CONSTANTS()
 
 END_INTERFACE()
@@ -0,0 +1,39 @@
+#ifndef DENOISE_HOST_INTERFACE
+#define DENOISE_HOST_INTERFACE
+
+#include "shader_interface.h"
+
+BEGIN_INTERFACE(vkfw_app::scene::rt)
+
+BEGIN_CONSTANTS(DenoiseBindingSets)
+    DenoiseSet = 0
+END_CONSTANTS()
+
+BEGIN_CONSTANTS(DenoiseSetBindings)
+    DenoiseInput = 0,
+    DenoiseOutput = 1,
+    DenoiseGBuffer = 2,
+    DenoiseSetBindingsSize = 3
+END_CONSTANTS()
+
+BEGIN_CONSTANTS(DenoiseParameters)
+    DenoiseWorkgroupSize = 8,
+    MaxDenoiseIterations = 5,
+    /** The input is the convergence image (sums and sample count in alpha), otherwise the output of the last iteration. */
+    DenoiseAccumulatedInputFlag = 1,
+    /** The AO integrator stores its result in the red channel only. */
+    DenoiseMonochromeFlag = 2
+END_CONSTANTS()
+
+/** Push constants of one a-trous iteration. */
+struct DenoisePushConstants
+{
+    /** The distance between the filter taps in pixels (2^iteration). */
+    int stepWidth;
+    uint iteration;
+    uint flags;
+};
+
+END_INTERFACE()
+
+#endif // DENOISE_HOST_INTERFACE
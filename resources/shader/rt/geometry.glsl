@@ -0,0 +1,23 @@
+#ifndef SHADER_RT_GEOMETRY
+#define SHADER_RT_GEOMETRY
+
+// Vertex and index fetches of the hit triangles for both vertex layouts, cam.compactVertices selects the layout of all geometry.
+// Has to be included after rt_sample_host_interface.h.
+
+layout(scalar, binding = Vertices, set = RTResourcesSet) buffer VerticesBuffer { RayTracingVertex v[]; } vertices[];
+layout(scalar, binding = Vertices, set = RTResourcesSet) buffer CompactVerticesBuffer { CompactRayTracingVertex v[]; } compactVertices[];
+// triangle lists, the three indices of a triangle are fetched with a single load.
+layout(scalar, binding = Indices, set = RTResourcesSet) buffer IndicesBuffer { uvec3 t[]; } triangleIndices[];
+
+uvec3 loadTriangleIndices(uint bufferIndex, uint indexOffset, uint primitiveId)
+{
+    return triangleIndices[nonuniformEXT(bufferIndex)].t[indexOffset / 3 + primitiveId];
+}
+
+RayTracingVertex loadVertex(uint bufferIndex, uint index)
+{
+    if (cam.compactVertices == 0) return vertices[nonuniformEXT(bufferIndex)].v[index];
+    return decodeCompactVertex(compactVertices[nonuniformEXT(bufferIndex)].v[index]);
+}
+
+#endif // SHADER_RT_GEOMETRY
@@ -0,0 +1,21 @@
+#ifndef SHADER_RT_OCCLUSION
+#define SHADER_RT_OCCLUSION
+
+// Occlusion rays: terminate on the first (alpha tested) hit, no closest hit shaders and a minimal payload.
+
+struct OcclusionPayload
+{
+    // ray cone at the origin, for the texture LOD of alpha testing.
+    float coneWidth;
+    float coneSpreadAngle;
+    // traced as occluded, the occlusion miss shader clears it.
+    uint occluded;
+};
+
+#ifdef RAYGEN
+layout(location = 1) rayPayloadEXT OcclusionPayload occlusionValue;
+#else
+layout(location = 1) rayPayloadInEXT OcclusionPayload occlusionValue;
+#endif
+
+#endif // SHADER_RT_OCCLUSION
@@ -0,0 +1,64 @@
+#ifndef SHADER_RT_PATH_LIGHT_SAMPLING
+#define SHADER_RT_PATH_LIGHT_SAMPLING
+
+// Next event estimation of the emissive triangles (see gfx::LightSampler), usable in hit and ray generation shaders.
+// Has to be included after rt_sample_host_interface.h and sampleGenerator.glsl.
+
+layout(scalar, binding = EmissiveMaterialInfos, set = RTResourcesSet) buffer EmissiveMaterialInfosBuffer { EmissiveMaterial m[]; } emissiveMaterials;
+layout(scalar, binding = LightTriangles, set = RTResourcesSet) buffer LightTrianglesBuffer { LightTriangle t[]; } lightTriangles;
+layout(scalar, binding = LightAliasTable, set = RTResourcesSet) buffer LightAliasTableBuffer { LightAliasEntry e[]; } lightAliasTable;
+
+struct LightSample
+{
+    vec3 direction;
+    float dist;
+    vec3 Le;
+    // solid angle pdf.
+    float pdf;
+};
+
+bool lightSamplingEnabled() { return cam.lightSampling == 1 && cam.numLightTriangles > 0; }
+
+uint emitterLightIndex(uint materialIndex, uint primitiveId) { return emissiveMaterials.m[materialIndex].firstLightTriangle + primitiveId; }
+
+// solid angle pdf of next event estimation sampling the point at the given distance along the direction on the light triangle.
+float lightPdf(uint lightIndex, vec3 direction, float dist)
+{
+    if (!lightSamplingEnabled()) return 0.0f;
+    LightTriangle light = lightTriangles.t[lightIndex];
+    // emitters are two sided.
+    float cosLight = abs(dot(normalize(cross(light.v1 - light.v0, light.v2 - light.v0)), direction));
+    if (cosLight <= 0.0f) return 0.0f;
+    return light.selectionPdf / light.area * dist * dist / cosLight;
+}
+
+// power heuristic.
+float misWeight(float pdf, float otherPdf)
+{
+    float pdf2 = pdf * pdf;
+    return pdf2 / max(pdf2 + otherPdf * otherPdf, 1e-20f);
+}
+
+// selects a light triangle by the alias table and a uniformly distributed point on it.
+bool sampleLight(vec3 position, inout SampleGenerator sg, out LightSample lightSample)
+{
+    float u = sample1D(sg) * float(cam.numLightTriangles);
+    uint bucket = min(uint(u), cam.numLightTriangles - 1);
+    uint lightIndex = (u - float(bucket)) < lightAliasTable.e[bucket].probability ? bucket : lightAliasTable.e[bucket].alias;
+    LightTriangle light = lightTriangles.t[lightIndex];
+
+    vec2 uv = sample2D(sg);
+    float su = sqrt(uv.x);
+    float v = uv.y;
+    vec3 lightPosition = (1.0f - su) * light.v0 + su * (1.0f - v) * light.v1 + su * v * light.v2;
+
+    vec3 toLight = lightPosition - position;
+    lightSample.dist = length(toLight);
+    if (lightSample.dist <= 0.0f) return false;
+    lightSample.direction = toLight / lightSample.dist;
+    lightSample.Le = light.Le;
+    lightSample.pdf = lightPdf(lightIndex, lightSample.direction, lightSample.dist);
+    return lightSample.pdf > 0.0f;
+}
+
+#endif // SHADER_RT_PATH_LIGHT_SAMPLING
@@ -0,0 +1,34 @@
+#ifndef SHADER_RT_PATH_QUEUES
+#define SHADER_RT_PATH_QUEUES
+
+// The queues of the wavefront path tracer, has to be included after path_host_interface.h.
+
+layout(scalar, binding = PathCounters, set = IntegratorSet) buffer PathCountersBuffer { PathTracingCounters counters; };
+layout(scalar, binding = RayQueues, set = IntegratorSet) buffer RayQueuesBuffer { PathRay r[]; } rayQueues;
+layout(scalar, binding = HitQueues, set = IntegratorSet) buffer HitQueuesBuffer { PathHit h[]; } hitQueues;
+layout(scalar, binding = ShadowQueue, set = IntegratorSet) buffer ShadowQueueBuffer { ShadowRay s[]; } shadowQueue;
+// two entries per pixel: extension rays and sky shadow rays at [pixel], emitter shadow rays at [queueCapacity + pixel].
+layout(binding = PathRadiance, set = IntegratorSet) buffer RadianceBuffer { vec4 r[]; } radiance;
+
+uint currentRayIndex(uint index) { return counters.currentRayQueue * counters.queueCapacity + index; }
+
+void pushRay(PathRay ray)
+{
+    uint nextQueue = 1 - counters.currentRayQueue;
+    uint slot = atomicAdd(counters.rayQueues[nextQueue].width, 1);
+    rayQueues.r[nextQueue * counters.queueCapacity + slot] = ray;
+}
+
+void pushHit(uint bin, PathHit hit)
+{
+    uint slot = atomicAdd(counters.hitQueues[bin].width, 1);
+    hitQueues.h[bin * counters.queueCapacity + slot] = hit;
+}
+
+void pushShadowRay(ShadowRay ray)
+{
+    uint slot = atomicAdd(counters.shadowQueue.width, 1);
+    shadowQueue.s[slot] = ray;
+}
+
+#endif // SHADER_RT_PATH_QUEUES
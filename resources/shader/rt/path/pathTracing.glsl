@@ -0,0 +1,33 @@
+#ifndef SHADER_RT_PATH_TRACING
+#define SHADER_RT_PATH_TRACING
+
+// Shared by the megakernel and the wavefront path tracer, has to be included after path_host_interface.h.
+
+// the sky is the only light source (ambient path tracing).
+const vec3 skyRadiance = vec3(1.0f);
+// relative distance shadow rays towards emitters stop before the sampled point, so the emitter itself does not occlude it.
+const float shadowEpsilon = 1e-3f;
+
+vec3 face_forward(vec3 direction, vec3 normal)
+{
+    if (dot(normal, direction) > 0.0f) normal *= -1;
+    return normal;
+}
+
+void compute_default_basis(const vec3 normal, out vec3 tangent, out vec3 binormal)
+{
+  if(abs(normal.x) > abs(normal.y))
+    tangent = vec3(normal.z, 0, -normal.x) / sqrt(normal.x * normal.x + normal.z * normal.z);
+  else
+    tangent = vec3(0, -normal.z, normal.y) / sqrt(normal.y * normal.y + normal.z * normal.z);
+  binormal = cross(normal, tangent);
+}
+
+// emitters are not binned, the extend stage adds their radiance directly.
+uint materialBin(uint materialType)
+{
+    if (materialType == MirrorMaterialType) return uint(MirrorBin);
+    return uint(PhongBin);
+}
+
+#endif // SHADER_RT_PATH_TRACING
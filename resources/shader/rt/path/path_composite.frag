@@ -0,0 +1,21 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+#include "../ao/ao_composite_shader_interface.h"
+
+layout(location = 0) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = ConvergenceSet, binding = AccumulatedImage) uniform sampler2D accumulatedImage;
+layout(set = ConvergenceSet, binding = GuideImage) uniform sampler2D guideImage;
+
+// the path tracers accumulate radiance in rgb and the number of samples in alpha.
+vec3 resolve(vec4 accumulated) { return accumulated.rgb / max(accumulated.a, 1.0f); }
+
+#include "../reconstruct.glsl"
+
+void main()
+{
+    outColor = vec4(reconstruct(accumulatedImage, guideImage, fragTexCoord), 1.0f);
+}
@@ -0,0 +1,97 @@
+#ifndef PATH_HOST_INTERFACE
+#define PATH_HOST_INTERFACE
+
+#include "rt/rt_sample_host_interface.h"
+
+BEGIN_INTERFACE(vkfw_app::scene::rt)
+
+BEGIN_CONSTANTS(PathSetBindings)
+    PathCounters = 0,
+    RayQueues = 1,
+    HitQueues = 2,
+    ShadowQueue = 3,
+    PathRadiance = 4,
+    PathSetBindingsSize = 5
+END_CONSTANTS()
+
+BEGIN_CONSTANTS(PathMaterialBins)
+    PhongBin = 0,
+    MirrorBin = 1,
+    MaterialBinCount = 2
+END_CONSTANTS()
+
+BEGIN_CONSTANTS(PathTracingParameters)
+    MaxPathDepth = 4,
+    PathSpecularFlag = 1
+END_CONSTANTS()
+
+/** A path segment waiting to be traced (extend stage). */
+struct PathRay
+{
+    vec3 origin;
+    uint pixel;
+    vec3 direction;
+    /** The ray cone width at the origin. */
+    float coneWidth;
+    vec3 throughput;
+    /** The next sample dimension of the path (the sample generator is rebuilt from pixel and frame in every stage). */
+    uint sampleDimension;
+    /** PathSpecularFlag if the path only had specular bounces since the last diffuse vertex (escaping rays see the sky). */
+    uint flags;
+    /** The pdf of the direction sampled at the last diffuse vertex (MIS weight when an emitter is hit). */
+    float bsdfPdf;
+};
+
+/** A hit of the extend stage waiting to be shaded, binned by material. */
+struct PathHit
+{
+    /** The index of the ray in the current ray queue. */
+    uint rayIndex;
+    uint instanceId;
+    uint primitiveId;
+    float hitT;
+    vec2 barycentrics;
+};
+
+/** A shadow ray towards the sky or an emitter, the contribution is added if nothing occludes it up to tMax. */
+struct ShadowRay
+{
+    vec3 origin;
+    /** The entry in the radiance buffer: the pixel for the sky, queueCapacity + pixel for emitters (no two rays of a pixel write the same entry). */
+    uint radianceIndex;
+    vec3 direction;
+    float coneWidth;
+    vec3 contribution;
+    float tMax;
+};
+
+/** Same layout as VkTraceRaysIndirectCommandKHR, the queue counters are used directly for indirect tracing. */
+struct TraceRaysIndirectCommand
+{
+    uint width;
+    uint height;
+    uint depth;
+};
+
+struct PathTracingCounters
+{
+    /** Ping-pong queues of extension rays, width is the number of rays. */
+    TraceRaysIndirectCommand rayQueues[2];
+    /** One hit queue per material bin (PhongBin, MirrorBin). */
+    TraceRaysIndirectCommand hitQueues[2];
+    TraceRaysIndirectCommand shadowQueue;
+    /** The ray queue read by the current bounce. */
+    uint currentRayQueue;
+    uint bounce;
+    /** The capacity of each queue (one element per pixel, the shadow queue and radiance hold two). */
+    uint queueCapacity;
+    /** The width of the image, to find the pixel coordinates of a path. */
+    uint imageWidth;
+    /** Statistics: rays traced in the current frame. */
+    uint extensionRays;
+    uint shadowRays;
+};
+
+END_INTERFACE()
+
+#endif // PATH_HOST_INTERFACE
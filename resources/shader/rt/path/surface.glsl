@@ -0,0 +1,63 @@
+#ifndef SHADER_RT_PATH_SURFACE
+#define SHADER_RT_PATH_SURFACE
+
+// Reconstructs surface attributes from a hit (instance, primitive and barycentrics), usable in hit and ray generation shaders.
+// Has to be included after rt_sample_host_interface.h.
+
+#include "../geometry.glsl"
+layout(scalar, binding = InstanceInfos, set = RTResourcesSet) buffer InstanceInfosBuffer { InstanceDesc i[]; } instances;
+layout(scalar, binding = PhongBumpMaterialInfos, set = RTResourcesSet) buffer PhongMaterialInfosBuffer { PhongBumpMaterial m[]; } phongMaterials;
+layout(scalar, binding = MirrorMaterialInfos, set = RTResourcesSet) buffer MirrorMaterialInfosBuffer { MirrorMaterial m[]; } mirrorMaterials;
+layout(binding = Textures, set = RTResourcesSet) uniform sampler2D textures[];
+
+struct Surface
+{
+    vec3 position;
+    vec3 normal;
+    vec2 texCoords;
+    RayTracingVertex v0;
+    RayTracingVertex v1;
+    RayTracingVertex v2;
+    mat4 transform;
+    uint materialType;
+    uint materialIndex;
+};
+
+Surface interpolateSurface(uint instanceId, uint primitiveId, vec2 attribs)
+{
+    const vec3 barycentricCoords = vec3(1.0f - attribs.x - attribs.y, attribs.x, attribs.y);
+
+    uint bufferIndex = instances.i[instanceId].bufferIndex;
+    uint indexOffset = instances.i[instanceId].indexOffset;
+    mat4 transformInverseTranspose = instances.i[instanceId].transformInverseTranspose;
+
+    uvec3 ind = loadTriangleIndices(bufferIndex, indexOffset, primitiveId);
+
+    Surface surface;
+    surface.v0 = loadVertex(bufferIndex, ind.x);
+    surface.v1 = loadVertex(bufferIndex, ind.y);
+    surface.v2 = loadVertex(bufferIndex, ind.z);
+    surface.transform = instances.i[instanceId].transform;
+    surface.materialType = instances.i[instanceId].materialType;
+    surface.materialIndex = instances.i[instanceId].materialIndex;
+
+    vec3 normal = surface.v0.normal * barycentricCoords.x + surface.v1.normal * barycentricCoords.y + surface.v2.normal * barycentricCoords.z;
+    surface.normal = normalize(vec3(transformInverseTranspose * vec4(normal, 0.0)));
+
+    vec3 position = surface.v0.position * barycentricCoords.x + surface.v1.position * barycentricCoords.y + surface.v2.position * barycentricCoords.z;
+    surface.position = vec3(surface.transform * vec4(position, 1.0));
+
+    surface.texCoords = surface.v0.texCoords * barycentricCoords.x + surface.v1.texCoords * barycentricCoords.y + surface.v2.texCoords * barycentricCoords.z;
+    return surface;
+}
+
+// the diffuse albedo of a Phong surface hit by a ray cone of the given width.
+vec3 phongAlbedo(Surface surface, vec3 rayDirection, float coneWidth)
+{
+    uint diffuseTextureIndex = phongMaterials.m[nonuniformEXT(surface.materialIndex)].diffuseTextureIndex;
+    vec2 texSize = vec2(textureSize(textures[nonuniformEXT(diffuseTextureIndex)], 0));
+    float lod = cam.rayConeLod == 1 ? rayConeTextureLodForDirection(surface.transform, surface.v0, surface.v1, surface.v2, texSize, coneWidth, rayDirection) : 0.0f;
+    return textureLod(textures[nonuniformEXT(diffuseTextureIndex)], surface.texCoords, lod).rgb;
+}
+
+#endif // SHADER_RT_PATH_SURFACE
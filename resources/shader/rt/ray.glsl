@@ -4,9 +4,15 @@ struct RayPayload {
     vec3 rayDirection;
     vec3 rayOrigin;
     int done;
+    // ray cone (for texture LOD): width at the ray origin and spread angle.
+    float coneWidth;
+    float coneSpreadAngle;
+    // emitter hit: solid angle pdf of sampling the hit point by next event estimation (for MIS).
+    float lightPdf;
     // miss: done = -1
     // specular hit: done += 0
     // other: done += 1
+    // emitter (path tracer): done = 2
 };
 
 #ifdef RAYGEN
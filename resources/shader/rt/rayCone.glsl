@@ -0,0 +1,39 @@
+#ifndef SHADER_RT_RAY_CONE
+#define SHADER_RT_RAY_CONE
+
+// Ray cone texture LOD (Akenine-Moeller et al., "Texture Level of Detail Strategies for Real-Time Ray Tracing").
+// Has to be included after rt_sample_host_interface.h.
+
+float rayConeWidthAtHit(float coneWidth, float coneSpreadAngle, float hitT)
+{
+    return coneWidth + coneSpreadAngle * hitT;
+}
+
+// Returns the mip level for a cone of width coneWidth with the given (world space) direction hitting the triangle.
+float rayConeTextureLodForDirection(mat4 transform, RayTracingVertex v0, RayTracingVertex v1, RayTracingVertex v2, vec2 texSize, float coneWidth, vec3 rayDirection)
+{
+    vec3 p0 = vec3(transform * vec4(v0.position, 1.0));
+    vec3 p1 = vec3(transform * vec4(v1.position, 1.0));
+    vec3 p2 = vec3(transform * vec4(v2.position, 1.0));
+    vec3 triangleNormal = cross(p1 - p0, p2 - p0);
+    float worldArea = length(triangleNormal);
+    vec2 uv10 = v1.texCoords - v0.texCoords;
+    vec2 uv20 = v2.texCoords - v0.texCoords;
+    float texelArea = abs(uv10.x * uv20.y - uv20.x * uv10.y) * texSize.x * texSize.y;
+
+    float lambda = 0.5f * log2(texelArea / max(worldArea, 1e-12f));
+    // degenerate cones or texture mappings result in -inf, which is clamped to the base level.
+    float cosTheta = abs(dot(normalize(rayDirection), triangleNormal / max(worldArea, 1e-12f)));
+    lambda += log2(abs(coneWidth)) - log2(max(cosTheta, 1e-4f));
+    return lambda;
+}
+
+#if !defined(RAYGEN) && !defined(RAY_QUERY)
+// Returns the mip level for a cone of width coneWidth hitting the triangle (only valid in hit shaders).
+float rayConeTextureLod(mat4 transform, RayTracingVertex v0, RayTracingVertex v1, RayTracingVertex v2, vec2 texSize, float coneWidth)
+{
+    return rayConeTextureLodForDirection(transform, v0, v1, v2, texSize, coneWidth, gl_WorldRayDirectionEXT);
+}
+#endif
+
+#endif // SHADER_RT_RAY_CONE
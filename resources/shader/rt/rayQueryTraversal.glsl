@@ -0,0 +1,92 @@
+#ifndef SHADER_RT_RAY_QUERY_TRAVERSAL
+#define SHADER_RT_RAY_QUERY_TRAVERSAL
+
+// Inline traversal with ray queries, the equivalent of rayTraversal.glsl with the closest hit, mirror and alpha testing any hit shaders.
+// Has to be included after rt_sample_host_interface.h, rayCone.glsl and path/surface.glsl, RAY_QUERY has to be defined.
+
+layout(binding = AccelerationStructure, set = RTResourcesSet) uniform accelerationStructureEXT topLevelAS;
+
+#include "triangleOpacity.glsl"
+
+struct RayQueryHit
+{
+    uint instanceId;
+    uint primitiveId;
+    vec2 barycentrics;
+    float hitT;
+};
+
+// the candidate is ignored like in skipAlpha.rahit if the diffuse texture is fully transparent at the hit.
+bool isCandidateOpaque(rayQueryEXT rayQuery, vec3 direction, float coneWidth, float coneSpreadAngle)
+{
+    uint instanceId = rayQueryGetIntersectionInstanceIdEXT(rayQuery, false);
+    uint primitiveId = rayQueryGetIntersectionPrimitiveIndexEXT(rayQuery, false);
+    uint opacityClass = triangleOpacityClass(instanceId, primitiveId);
+    if (opacityClass != TriangleMixed) return opacityClass == TriangleOpaque;
+    if (instances.i[instanceId].materialType != PhongBumpMaterialType) return true;
+
+    Surface surface = interpolateSurface(instanceId, primitiveId, rayQueryGetIntersectionBarycentricsEXT(rayQuery, false));
+    uint diffuseTextureIndex = phongMaterials.m[nonuniformEXT(surface.materialIndex)].diffuseTextureIndex;
+    vec2 texSize = vec2(textureSize(textures[nonuniformEXT(diffuseTextureIndex)], 0));
+    float hitConeWidth = rayConeWidthAtHit(coneWidth, coneSpreadAngle, rayQueryGetIntersectionTEXT(rayQuery, false));
+    float lod = cam.rayConeLod == 1 ? rayConeTextureLodForDirection(surface.transform, surface.v0, surface.v1, surface.v2, texSize, hitConeWidth, direction) : 0.0f;
+    return textureLod(textures[nonuniformEXT(diffuseTextureIndex)], surface.texCoords, lod).a != 0.0f;
+}
+
+bool traceRayQuery(vec3 origin, vec3 direction, float tmax, float coneWidth, float coneSpreadAngle, out RayQueryHit hit)
+{
+    const float tmin = 0.001;
+
+    rayQueryEXT rayQuery;
+    rayQueryInitializeEXT(rayQuery, topLevelAS, cam.alphaTestedGeometry == 0 ? gl_RayFlagsOpaqueEXT : gl_RayFlagsNoneEXT, 0xff, origin, tmin, direction, tmax);
+    while (rayQueryProceedEXT(rayQuery)) {
+        if (rayQueryGetIntersectionTypeEXT(rayQuery, false) == gl_RayQueryCandidateIntersectionTriangleEXT
+            && isCandidateOpaque(rayQuery, direction, coneWidth, coneSpreadAngle)) {
+            rayQueryConfirmIntersectionEXT(rayQuery);
+        }
+    }
+    if (rayQueryGetIntersectionTypeEXT(rayQuery, true) == gl_RayQueryCommittedIntersectionNoneEXT) return false;
+
+    hit.instanceId = rayQueryGetIntersectionInstanceIdEXT(rayQuery, true);
+    hit.primitiveId = rayQueryGetIntersectionPrimitiveIndexEXT(rayQuery, true);
+    hit.barycentrics = rayQueryGetIntersectionBarycentricsEXT(rayQuery, true);
+    hit.hitT = rayQueryGetIntersectionTEXT(rayQuery, true);
+    return true;
+}
+
+// visibility only: the first alpha tested hit terminates the query, mirrors occlude like any other surface.
+bool isOccluded(vec3 origin, vec3 direction, float tmax, float coneWidth, float coneSpreadAngle)
+{
+    const float tmin = 0.001;
+
+    rayQueryEXT rayQuery;
+    rayQueryInitializeEXT(rayQuery, topLevelAS, gl_RayFlagsTerminateOnFirstHitEXT | (cam.alphaTestedGeometry == 0 ? gl_RayFlagsOpaqueEXT : gl_RayFlagsNoneEXT), 0xff, origin, tmin, direction, tmax);
+    while (rayQueryProceedEXT(rayQuery)) {
+        if (rayQueryGetIntersectionTypeEXT(rayQuery, false) == gl_RayQueryCandidateIntersectionTriangleEXT
+            && isCandidateOpaque(rayQuery, direction, coneWidth, coneSpreadAngle)) {
+            rayQueryConfirmIntersectionEXT(rayQuery);
+        }
+    }
+    return rayQueryGetIntersectionTypeEXT(rayQuery, true) != gl_RayQueryCommittedIntersectionNoneEXT;
+}
+
+// the ray cone starts with coneWidth at the origin, on return coneWidth is the width at the hit.
+bool findNextNonSpecularHit(inout vec3 origin, inout vec3 direction, out vec3 normal, float tmax, inout float coneWidth, float coneSpreadAngle)
+{
+    const uint maxSpecularDepth = 10;
+    for (uint specularDepth = 0; specularDepth < maxSpecularDepth; ++specularDepth) {
+        RayQueryHit hit;
+        if (!traceRayQuery(origin, direction, tmax, coneWidth, coneSpreadAngle, hit)) return false;
+
+        Surface surface = interpolateSurface(hit.instanceId, hit.primitiveId, hit.barycentrics);
+        origin = surface.position;
+        normal = surface.normal;
+        // the mirrors are planar, so the reflection keeps the spread angle of the cone.
+        coneWidth = rayConeWidthAtHit(coneWidth, coneSpreadAngle, hit.hitT);
+        if (surface.materialType != MirrorMaterialType) return true;
+        direction = reflect(direction, surface.normal);
+    }
+    return false;
+}
+
+#endif // SHADER_RT_RAY_QUERY_TRAVERSAL
@@ -1,11 +1,13 @@
 #include "ray.glsl"
+#include "occlusion.glsl"
 
 layout(binding = AccelerationStructure, set = 0) uniform accelerationStructureEXT topLevelAS;
 
-bool findNextNonSpecularHit(inout vec3 origin, inout vec3 direction, out vec3 normal, float tmax)
+// the ray cone starts with coneWidth at the origin, on return coneWidth is the width at the hit.
+bool findNextNonSpecularHit(inout vec3 origin, inout vec3 direction, out vec3 normal, float tmax, inout float coneWidth, float coneSpreadAngle)
 {
     const uint maxSpecularDepth = 10;
-    uint rayFlags = gl_RayFlagsNoneEXT;
+    uint rayFlags = cam.alphaTestedGeometry == 0 ? gl_RayFlagsOpaqueEXT : gl_RayFlagsNoneEXT;
     uint cullMask = 0xff;
     float tmin = 0.001;
 
@@ -13,6 +15,8 @@ bool findNextNonSpecularHit(inout vec3 origin, inout vec3 direction, out vec3 no
     hitValue.rayDirection = direction.xyz;
     hitValue.rayOrigin = origin.xyz;
     hitValue.done = 0;
+    hitValue.coneWidth = coneWidth;
+    hitValue.coneSpreadAngle = coneSpreadAngle;
 
     uint specularDepth = 0;
     while (hitValue.done == 0 && specularDepth < maxSpecularDepth)
@@ -28,5 +32,21 @@ bool findNextNonSpecularHit(inout vec3 origin, inout vec3 direction, out vec3 no
     origin = hitValue.rayOrigin;
     direction = hitValue.rayDirection;
     normal = hitValue.attenuation;
+    coneWidth = hitValue.coneWidth;
     return true;
 }
+
+// visibility only: the first alpha tested hit terminates the ray, mirrors occlude like any other surface.
+bool isOccluded(vec3 origin, vec3 direction, float tmax, float coneWidth, float coneSpreadAngle)
+{
+    uint rayFlags = gl_RayFlagsTerminateOnFirstHitEXT | gl_RayFlagsSkipClosestHitShaderEXT;
+    if (cam.alphaTestedGeometry == 0) rayFlags |= gl_RayFlagsOpaqueEXT;
+    uint cullMask = 0xff;
+    float tmin = 0.001;
+
+    occlusionValue.coneWidth = coneWidth;
+    occlusionValue.coneSpreadAngle = coneSpreadAngle;
+    occlusionValue.occluded = 1;
+    traceRayEXT(topLevelAS, rayFlags, cullMask, uint(AOOcclusionHitGroupOffset), 0, uint(OcclusionMissIndex), origin, tmin, direction, tmax, 1);
+    return occlusionValue.occluded == 1;
+}
@@ -0,0 +1,59 @@
+#ifndef SHADER_RT_RECONSTRUCT
+#define SHADER_RT_RECONSTRUCT
+
+// Edge aware reconstruction of the traced image at the output resolution (render scale and checkerboard holes).
+// The includer defines vec3 resolve(vec4 accumulated), converting an accumulated texel to a color.
+// The nearest traced pixel is the reference of the edge stopping weights, texels without samples are skipped.
+
+// relative camera distance difference and normal exponent of the edge stopping weights.
+const float reconstructDepthPhi = 0.05f;
+const float reconstructNormalExponent = 8.0f;
+// below this weight sum no tap was accepted.
+const float reconstructMinWeight = 1e-4f;
+
+float reconstructEdgeWeight(vec4 referenceSurface, vec4 surface)
+{
+    bool referenceGeometry = referenceSurface.w > 0.0f;
+    if (referenceGeometry != (surface.w > 0.0f)) return 0.0f;
+    if (!referenceGeometry) return 1.0f;
+    float depthWeight = exp(-abs(surface.w - referenceSurface.w) / (reconstructDepthPhi * referenceSurface.w));
+    float normalWeight = pow(max(dot(surface.xyz, referenceSurface.xyz), 0.0f), reconstructNormalExponent);
+    return depthWeight * normalWeight;
+}
+
+// tent filter with the given radius (in traced pixels) over the 3x3 traced pixels around uv, returns the weighted color sum and the weight.
+vec4 reconstructTaps(sampler2D accumulatedImage, sampler2D guideImage, vec2 uv, float radius, bool edgeAware)
+{
+    ivec2 size = textureSize(accumulatedImage, 0);
+    vec2 position = uv * vec2(size);
+    ivec2 center = clamp(ivec2(floor(position)), ivec2(0), size - 1);
+    vec4 referenceSurface = texelFetch(guideImage, center, 0);
+
+    vec4 result = vec4(0.0f);
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            ivec2 tap = center + ivec2(x, y);
+            if (any(lessThan(tap, ivec2(0))) || any(greaterThanEqual(tap, size))) continue;
+            vec4 accumulated = texelFetch(accumulatedImage, tap, 0);
+            if (accumulated.a <= 0.0f) continue;
+
+            vec2 distance = abs(vec2(tap) + 0.5f - position) / radius;
+            float weight = max(1.0f - distance.x, 0.0f) * max(1.0f - distance.y, 0.0f);
+            if (edgeAware) weight *= reconstructEdgeWeight(referenceSurface, texelFetch(guideImage, tap, 0));
+            result += vec4(weight * resolve(accumulated), weight);
+        }
+    }
+    return result;
+}
+
+vec3 reconstruct(sampler2D accumulatedImage, sampler2D guideImage, vec2 uv)
+{
+    // bilinear first (a single tap at full resolution), the wider tent closes checkerboard holes, the last pass ignores edges.
+    vec4 result = reconstructTaps(accumulatedImage, guideImage, uv, 1.0f, true);
+    if (result.w < reconstructMinWeight) result = reconstructTaps(accumulatedImage, guideImage, uv, 2.0f, true);
+    if (result.w < reconstructMinWeight) result = reconstructTaps(accumulatedImage, guideImage, uv, 2.0f, false);
+    if (result.w < reconstructMinWeight) return vec3(0.0f);
+    return result.rgb / result.w;
+}
+
+#endif // SHADER_RT_RECONSTRUCT
@@ -8,7 +8,8 @@ BEGIN_INTERFACE(vkfw_app::scene::rt)
 
 BEGIN_CONSTANTS(BindingSets)
     RTResourcesSet = 0,
-    ConvergenceSet = 1
+    ConvergenceSet = 1,
+    IntegratorSet = 2
 END_CONSTANTS()
 
 BEGIN_CONSTANTS(ResSetBindings)
@@ -20,12 +21,76 @@ BEGIN_CONSTANTS(ResSetBindings)
     PhongBumpMaterialInfos = 5,
     MirrorMaterialInfos = 6,
     Textures = 7,
-    ResSetBindingsSize = 8
+    EmissiveMaterialInfos = 8,
+    LightTriangles = 9,
+    LightAliasTable = 10,
+    SamplerTables = 11,
+    TriangleOpacity = 12,
+    ResSetBindingsSize = 13
 END_CONSTANTS()
 
 BEGIN_CONSTANTS(ConvSetBindings)
     ResultImage = 0,
-    ConvSetBindingsSize = 1
+    AdaptiveSampling = 1,
+    /** Normal (xyz) and camera distance (w, 0 without geometry) of the first diffuse hit per pixel, guides the denoiser. */
+    GBufferImage = 2,
+    /** The convergence and G-buffer images of the previous frame, the AO integrator carries them over into the current ones. */
+    HistoryImage = 3,
+    HistoryGBufferImage = 4,
+    ConvSetBindingsSize = 5
+END_CONSTANTS()
+
+/** Occlusion rays only answer visibility: own miss shader, any hit shaders for alpha testing and no closest hit shaders. */
+BEGIN_CONSTANTS(OcclusionRays)
+    OcclusionMissIndex = 1,
+    /** The occlusion hit groups follow the material hit groups of the AO integrator (one per material hit group). */
+    AOOcclusionHitGroupOffset = 2
+END_CONSTANTS()
+
+/**
+ *  The opacity of a triangle against the alpha of its diffuse texture, classified on the CPU (gfx::ClassifyTriangleOpacity).
+ *  The triangle opacity buffer starts with one entry per geometry buffer (bufferIndex of the instances) holding the offset of
+ *  its classes, 0 if the geometry is not classified. The classes follow with TriangleOpacityBits bits per triangle.
+ */
+BEGIN_CONSTANTS(TriangleOpacityClass)
+    TriangleOpaque = 0,
+    TriangleTransparent = 1,
+    /** Only these triangles need the alpha test. */
+    TriangleMixed = 2,
+    TriangleOpacityBits = 2,
+    TrianglesPerOpacityWord = 16
+END_CONSTANTS()
+
+BEGIN_CONSTANTS(RayQueryParameters)
+    /** The compute shaders tracing with ray queries run on square tiles of this size. */
+    RayQueryWorkgroupSize = 8
+END_CONSTANTS()
+
+BEGIN_CONSTANTS(HistoryMode)
+    /** The camera did not move, the history of a pixel is the same pixel of the previous frame. */
+    HistoryStatic = 0,
+    /** The camera moved, the history is reprojected and tested for disocclusions. */
+    HistoryReproject = 1,
+    /** The parameters changed, the history is discarded. */
+    HistoryReset = 2
+END_CONSTANTS()
+
+BEGIN_CONSTANTS(SamplerType)
+    /** Independent hashed random numbers per sample and dimension. */
+    RandomSampler = 0,
+    /** Owen scrambled Sobol points, scrambled per pixel and dimension. */
+    SobolSampler = 1,
+    /** A tiled blue noise mask per dimension, rotated by the R2 sequence per sample. */
+    BlueNoiseSampler = 2,
+    SamplerTypeCount = 3
+END_CONSTANTS()
+
+/** Layout of the sampler tables buffer (in uints): Sobol direction numbers followed by the blue noise tile. */
+BEGIN_CONSTANTS(SamplerTableLayout)
+    SobolDimensions = 2,
+    SobolBits = 32,
+    BlueNoiseSize = 64,
+    BlueNoiseOffset = 64
 END_CONSTANTS()
 
 struct RayTracingVertex
@@ -43,14 +108,109 @@ struct RayTracingVertex
 #endif
 };
 
+/**
+ *  The compact vertex layout (20 instead of 48 bytes): the position stays a float vector for the acceleration structure
+ *  builds, the normal is octahedral encoded in two snorm16 values, the texture coordinates are half floats and the color is dropped.
+ */
+struct CompactRayTracingVertex
+{
+    vec3 position;
+    /** Octahedral encoded normal (packSnorm2x16). */
+    uint normal;
+    /** packHalf2x16 of the texture coordinates. */
+    uint texCoords;
+
+#ifdef __cplusplus
+    CompactRayTracingVertex(const vkfw_core::gfx::MeshInfo* mi, std::size_t index);
+    explicit CompactRayTracingVertex(const RayTracingVertex& vertex);
+    static vk::VertexInputBindingDescription m_bindingDescription;
+    static std::array<vk::VertexInputAttributeDescription, 3> m_attributeDescriptions;
+#endif
+};
+
+#ifndef __cplusplus
+// the inverse of the octahedral encoding in CompactRayTracingVertex (Cigolle et al., "A Survey of Efficient Representations for Independent Unit Vectors").
+vec3 decodeOctahedralNormal(uint encoded)
+{
+    vec2 f = unpackSnorm2x16(encoded);
+    vec3 n = vec3(f.x, f.y, 1.0f - abs(f.x) - abs(f.y));
+    float t = max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+RayTracingVertex decodeCompactVertex(CompactRayTracingVertex vertex)
+{
+    return RayTracingVertex(vertex.position, decodeOctahedralNormal(vertex.normal), unpackHalf2x16(vertex.texCoords), vec4(0.0f));
+}
+#endif
+
 struct CameraParameters
 {
     mat4 viewInverse;
     mat4 projInverse;
+    /** The view projection matrix of the previous frame, to reproject the history. */
+    mat4 prevViewProj;
+    /** The camera position of the previous frame (w unused), to test reprojected depths. */
+    vec4 prevCameraPosition;
     uint frameId;
     uint cameraMovedThisFrame;
     uint cosineSampled;
     float maxRange;
+    /** The spread angle of a pixel, used as initial ray cone angle. */
+    float pixelSpreadAngle;
+    /** Whether hit shaders select the texture LOD by ray cones (otherwise the base level is used). */
+    uint rayConeLod;
+    /** Relative standard error below which a pixel is converged and stops tracing. */
+    float convergenceThreshold;
+    /** Whether converged pixels skip tracing and hand their rays to the remaining pixels. */
+    uint adaptiveSampling;
+    /** Whether the path tracer samples the emissive triangles directly (next event estimation with MIS). */
+    uint lightSampling;
+    /** The number of entries in the light triangles and the alias table. */
+    uint numLightTriangles;
+    /** The sample generator (SamplerType). */
+    uint samplerType;
+    /** How the AO integrator reuses the result of the previous frame (HistoryMode). */
+    uint historyMode;
+    /** Checkerboard rendering: 0 traces every pixel, 1 or 2 only the pixels with even or odd x + y this frame. */
+    uint checkerboard;
+    /** Whether all geometry is stored as CompactRayTracingVertex (otherwise RayTracingVertex). */
+    uint compactVertices;
+    /** Whether any geometry has transparent or alpha tested triangles, otherwise rays are opaque and skip the any hit shaders. */
+    uint alphaTestedGeometry;
+};
+
+/** An emissive triangle in world space for next event estimation. */
+struct LightTriangle
+{
+    vec3 v0;
+    /** The probability of selecting the triangle (proportional to its power). */
+    float selectionPdf;
+    vec3 v1;
+    float area;
+    vec3 v2;
+    uint padding0;
+    vec3 Le;
+    uint padding1;
+};
+
+/** One bucket of the alias table over the light triangles (Vose). */
+struct LightAliasEntry
+{
+    /** Probability to keep the bucket index, otherwise the alias is used. */
+    float probability;
+    uint alias;
+};
+
+/** Active pixel counters for adaptive sampling, one per convergence image. */
+struct AdaptiveSamplingStats
+{
+    /** The number of pixels that traced rays the last time the image was rendered. */
+    uint lastActivePixels;
+    /** The number of pixels tracing rays in the current frame. */
+    uint activePixels;
 };
 
 BEGIN_UNIFORM_BLOCK(set = RTResourcesSet, binding = CameraProperties, CameraPropertiesBuffer)
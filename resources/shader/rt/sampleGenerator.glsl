@@ -0,0 +1,90 @@
+#ifndef SHADER_RT_SAMPLE_GENERATOR
+#define SHADER_RT_SAMPLE_GENERATOR
+
+// Sample generators selected by cam.samplerType (see SamplerType), the tables are created on the CPU (gfx::CreateSamplerTables).
+// Every call draws the next 2D dimension of the sample, the sample index selects the point of the sequence.
+// Has to be included after rt_sample_host_interface.h and random.glsl.
+
+layout(binding = SamplerTables, set = RTResourcesSet) buffer SamplerTablesBuffer { uint t[]; } samplerTables;
+
+struct SampleGenerator
+{
+    uvec2 pixel;
+    uint pixelSeed;
+    uint sampleIndex;
+    uint dimension;
+};
+
+SampleGenerator initSampleGenerator(uvec2 pixel, uint sampleIndex, uint dimension)
+{
+    SampleGenerator sg;
+    sg.pixel = pixel;
+    sg.pixelSeed = jenkinsHash(pixel.x ^ jenkinsHash(pixel.y));
+    sg.sampleIndex = sampleIndex;
+    sg.dimension = dimension;
+    return sg;
+}
+
+// hash based Owen scrambling from Burley, "Practical Hash-based Owen Scrambling", JCGT 2020.
+uint laineKarrasPermutation(uint x, uint seed)
+{
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return x;
+}
+
+uint nestedUniformScramble(uint x, uint seed) { return bitfieldReverse(laineKarrasPermutation(bitfieldReverse(x), seed)); }
+
+uint sobol(uint index, uint dim)
+{
+    uint x = 0u;
+    for (uint bit = 0u; index != 0u; ++bit, index >>= 1u) {
+        if ((index & 1u) != 0u) x ^= samplerTables.t[dim * uint(SobolBits) + bit];
+    }
+    return x;
+}
+
+vec2 toUnitSquare(uvec2 x) { return vec2(x >> 8u) * (1.0f / 16777216.0f); }
+
+vec2 sampleRandom(SampleGenerator sg)
+{
+    uint rngState = jenkinsHash(sg.pixelSeed ^ jenkinsHash(sg.sampleIndex ^ jenkinsHash(sg.dimension)));
+    return vec2(rand(rngState), rand(rngState));
+}
+
+vec2 sampleSobol(SampleGenerator sg)
+{
+    // the index is shuffled per pixel and dimension, so every dimension pair is an independently scrambled (0,2)-sequence.
+    uint seed = jenkinsHash(sg.pixelSeed ^ jenkinsHash(sg.dimension));
+    uint index = nestedUniformScramble(sg.sampleIndex, seed);
+    uint x = nestedUniformScramble(sobol(index, 0u), jenkinsHash(seed ^ 0x9e3779b9u));
+    uint y = nestedUniformScramble(sobol(index, 1u), jenkinsHash(seed ^ 0x7f4a7c15u));
+    return toUnitSquare(uvec2(x, y));
+}
+
+vec2 sampleBlueNoise(SampleGenerator sg)
+{
+    // every dimension uses a differently offset tile, consecutive samples rotate it by the R2 sequence.
+    uint offset = jenkinsHash(sg.dimension);
+    uvec2 p = (sg.pixel + uvec2(offset, offset >> 16u)) % uint(BlueNoiseSize);
+    uint ranks = samplerTables.t[uint(BlueNoiseOffset) + p.y * uint(BlueNoiseSize) + p.x];
+    vec2 noise = (vec2(ranks & 0xffffu, ranks >> 16u) + 0.5f) / float(BlueNoiseSize * BlueNoiseSize);
+    return fract(noise + toUnitSquare(uvec2(sg.sampleIndex) * uvec2(3242174889u, 2447445415u)));
+}
+
+vec2 sample2D(inout SampleGenerator sg)
+{
+    vec2 u;
+    if (cam.samplerType == SobolSampler) u = sampleSobol(sg);
+    else if (cam.samplerType == BlueNoiseSampler) u = sampleBlueNoise(sg);
+    else u = sampleRandom(sg);
+    sg.dimension += 1u;
+    return u;
+}
+
+float sample1D(inout SampleGenerator sg) { return sample2D(sg).x; }
+
+#endif // SHADER_RT_SAMPLE_GENERATOR
@@ -0,0 +1,19 @@
+#ifndef SHADER_RT_TRIANGLE_OPACITY
+#define SHADER_RT_TRIANGLE_OPACITY
+
+// The opacity classes of the triangles (see TriangleOpacityClass), has to be included after the instances are declared.
+
+layout(binding = TriangleOpacity, set = RTResourcesSet) buffer TriangleOpacityBuffer { uint o[]; } triangleOpacity;
+
+// only mixed triangles need the alpha test, unclassified geometry is treated as mixed.
+uint triangleOpacityClass(uint instanceId, uint primitiveId)
+{
+    uint classesOffset = triangleOpacity.o[instances.i[instanceId].bufferIndex];
+    if (classesOffset == 0) return uint(TriangleMixed);
+
+    uint triangle = instances.i[instanceId].indexOffset / 3 + primitiveId;
+    uint classes = triangleOpacity.o[classesOffset + triangle / uint(TrianglesPerOpacityWord)];
+    return (classes >> (uint(TriangleOpacityBits) * (triangle % uint(TrianglesPerOpacityWord)))) & ((1u << uint(TriangleOpacityBits)) - 1u);
+}
+
+#endif // SHADER_RT_TRIANGLE_OPACITY
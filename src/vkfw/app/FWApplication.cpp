@@ -7,7 +7,10 @@
  */
 
 #include "app/FWApplication.h"
+#include "app/SimpleScene.h"
+#include "app/RaytracingScene.h"
 #include "app_constants.h"
+#include "core/Timeline.h"
 #include <app/VKWindow.h>
 #include <gfx/vk/LogicalDevice.h>
 // ReSharper disable once CppUnusedIncludeDirective
@@ -17,11 +20,17 @@
 #include "imgui.h"
 #include <vulkan/vulkan.hpp>
 
+#include <algorithm>
+#include <set>
+#include <string>
+
 namespace vkfw_app {
 
     void* GetDeviceFeaturesNextChain()
     {
-        return nullptr;
+        // the ray query AO integrator traces from a compute shader.
+        static vk::PhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures{VK_TRUE};
+        return &rayQueryFeatures;
     }
 
     /**
@@ -32,14 +41,16 @@ namespace vkfw_app {
                           applicationVersion,
                           configFileName,
                           {},
-                          {VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME, VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME, VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME},
+                          {VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME, VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME, VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME,
+                           VK_KHR_RAY_QUERY_EXTENSION_NAME},
                           GetDeviceFeaturesNextChain()},
           m_camera{std::make_unique<vkfw_core::gfx::ArcballCamera>(glm::vec3(2.0f, 2.0f, 2.0f), glm::radians(45.0f),
                                                                    static_cast<float>(GetWindow(0)->GetWidth())
                                                                        / static_cast<float>(GetWindow(0)->GetHeight()),
                                                                    0.1f, 10.0f)},
-          m_simple_scene{&GetWindow(0)->GetDevice(), m_camera.get(), GetWindow(0)->GetFramebuffers().size()},
-          m_rt_scene{&GetWindow(0)->GetDevice(), m_camera.get(), GetWindow(0)->GetFramebuffers().size()}
+          m_windowTarget{GetWindow(0)},
+          m_gpuTimeline{std::make_unique<gfx::GPUTimeline>(&GetWindow(0)->GetDevice(), GetWindow(0)->GetFramebuffers().size())},
+          m_pipelineCache{std::make_unique<gfx::PipelineCache>(&GetWindow(0)->GetDevice())}
     {
         auto fbSize = GetWindow(0)->GetFramebuffers()[0].GetSize();
         Resize(fbSize, GetWindow(0));
@@ -49,54 +60,131 @@ namespace vkfw_app {
     {
         // remove pipeline from command buffer.
         GetWindow(0)->UpdatePrimaryCommandBuffers([](const vkfw_core::gfx::CommandBuffer&, std::size_t) {});
+        GetWindow(0)->GetDevice().GetHandle().waitIdle();
+        for (auto& scene : m_scenes) { scene.reset(); }
     }
 
     void FWApplication::FrameMove(float time, float elapsed, vkfw_core::VKWindow* window)
     {
         if (window != GetWindow(0)) return;
+        TIMELINE_SCOPE("FrameMove");
 
-        bool cameraChanged = m_camera->UpdateCamera(elapsed, window);
+        // results of the last submit of this command buffer.
+        m_gpuTimeline->CollectResults(m_windowTarget.GetCurrentlyRenderedImageIndex());
+        core::Timeline::Instance().Drain();
 
-        switch (m_scene_to_render) {
-        case 0: m_simple_scene.FrameMove(time, elapsed, cameraChanged, window); break;
-        case 1: m_rt_scene.FrameMove(time, elapsed, cameraChanged, window); break;
-        default: break;
-        }
+        ApplySceneChange(GetScene(m_scene_to_render)->UpdateStreamedResources(), window);
+
+        bool cameraChanged = m_camera->UpdateCamera(elapsed, window);
+        GetScene(m_scene_to_render)->FrameMove(time, elapsed, cameraChanged, &m_windowTarget);
     }
 
     void FWApplication::RenderScene(vkfw_core::VKWindow* window)
     {
-        switch (m_scene_to_render) {
-        case 0: m_simple_scene.RenderScene(window); break;
-        case 1: m_rt_scene.RenderScene(window); break;
-        default: break;
-        }
+        if (window != GetWindow(0)) return;
+        TIMELINE_SCOPE("RenderScene");
+
+        GetScene(m_scene_to_render)->RenderScene(&m_windowTarget);
+        // the command buffer is submitted by the window right after this.
+        m_gpuTimeline->MarkSubmitted(m_windowTarget.GetCurrentlyRenderedImageIndex());
     }
 
     void FWApplication::RenderGUI(vkfw_core::VKWindow* window)
     {
-        bool changed = false;
+        TIMELINE_SCOPE("RenderGUI");
+        auto change = scene::SceneChange::None;
+        auto previousScene = m_scene_to_render;
         ImGui::SetNextWindowPos(ImVec2(5, 5), ImGuiCond_Always);
-        ImGui::SetNextWindowSize(ImVec2(220, 90), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(220, 95), ImGuiCond_Always);
         if (ImGui::Begin("Render Control")) {
-            if (ImGui::RadioButton("Render Simple Scene", &m_scene_to_render, 0)) changed = true;
-            if (ImGui::RadioButton("Render RayTracing Scene", &m_scene_to_render, 1)) changed = true;
+            ImGui::RadioButton("Render Simple Scene", &m_scene_to_render, 0);
+            ImGui::RadioButton("Render RayTracing Scene", &m_scene_to_render, 1);
+            ImGui::Checkbox("Evict Inactive Scenes", &m_evictInactiveScenes);
         }
         ImGui::End();
+        if (previousScene != m_scene_to_render) {
+            // the GUI of the new scene is skipped for this frame, so it is not created before the old one is evicted.
+            window->GetDevice().GetHandle().waitIdle();
+            // evict before activating to keep the peak memory at a single scene.
+            if (m_evictInactiveScenes) { EvictInactiveScenes(); }
+            // switching scenes only needs new command buffers (and pipelines if the scene was not used at this size yet).
+            ApplySceneChange(scene::SceneChange::CommandStream, window);
+            return;
+        }
 
-        switch (m_scene_to_render) {
-        case 0: {
-            changed = changed || m_simple_scene.RenderGUI(window);
-            break;
+        change = std::max(change, GetScene(m_scene_to_render)->RenderGUI(window));
+        ApplySceneChange(change, window);
+    }
+
+    scene::Scene* FWApplication::GetScene(int sceneIndex)
+    {
+        if (sceneIndex < 0 || static_cast<std::size_t>(sceneIndex) >= NUM_SCENES) { throw std::out_of_range(fmt::format("Scene index {} out of range.", sceneIndex)); }
+
+        auto& scene = m_scenes[static_cast<std::size_t>(sceneIndex)];
+        if (!scene) {
+            auto* device = &GetWindow(0)->GetDevice();
+            auto numFramebuffers = GetWindow(0)->GetFramebuffers().size();
+            switch (sceneIndex) {
+            case 0: scene = std::make_unique<scene::simple::SimpleScene>(device, m_camera.get(), &m_meshCache, &m_textureCache, numFramebuffers); break;
+            case 1: scene = std::make_unique<scene::rt::RaytracingScene>(device, m_camera.get(), &m_meshCache, &m_textureCache, numFramebuffers); break;
+            default: break;
+            }
+            scene->SetGPUTimeline(m_gpuTimeline.get());
+            scene->SetPipelineCache(m_pipelineCache.get());
+            m_scenePipelineSizes[static_cast<std::size_t>(sceneIndex)] = glm::uvec2{0};
         }
-        case 1: {
-            changed = changed || m_rt_scene.RenderGUI(window);
+        return scene.get();
+    }
+
+    void FWApplication::EvictInactiveScenes()
+    {
+        std::set<std::string> usedMeshes;
+        for (std::size_t i = 0; i < NUM_SCENES; ++i) {
+            if (!m_scenes[i]) { continue; }
+            if (static_cast<int>(i) == m_scene_to_render) {
+                usedMeshes.insert(m_scenes[i]->GetMeshFilenames().begin(), m_scenes[i]->GetMeshFilenames().end());
+                continue;
+            }
+            spdlog::info("Evicting inactive scene {}.", i);
+            m_scenes[i].reset();
+            m_scenePipelineSizes[i] = glm::uvec2{0};
+        }
+        // the meshes only the evicted scenes used would otherwise stay in memory until the application exits.
+        m_meshCache.ReleaseUnusedMeshes(usedMeshes);
+    }
+
+    void FWApplication::ApplySceneChange(scene::SceneChange change, vkfw_core::VKWindow* window)
+    {
+        switch (change) {
+        case scene::SceneChange::None:
+        case scene::SceneChange::Parameters:
+            // parameters are uploaded with the UBOs in the next FrameMove.
+            break;
+        case scene::SceneChange::CommandStream: {
+            // the command buffers may still be in flight.
+            window->GetDevice().GetHandle().waitIdle();
+            auto& pipelineSize = m_scenePipelineSizes[static_cast<std::size_t>(m_scene_to_render)];
+            if (pipelineSize != m_screenSize) {
+                GetScene(m_scene_to_render)->CreatePipeline(m_screenSize, &m_windowTarget);
+                pipelineSize = m_screenSize;
+            }
+            RecordCommandBuffers(window);
             break;
         }
-        default: break;
+        case scene::SceneChange::Resize:
+            // the swapchain is unchanged, only the scenes resources are recreated.
+            window->GetDevice().GetHandle().waitIdle();
+            Resize(m_screenSize, window);
+            break;
         }
+    }
 
-        if (changed) { window->ForceResizeEvent(); }
+    void FWApplication::RecordCommandBuffers(vkfw_core::VKWindow* window)
+    {
+        window->UpdatePrimaryCommandBuffers([this](vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex) {
+            m_gpuTimeline->ResetQueries(cmdBuffer, cmdBufferIndex);
+            GetScene(m_scene_to_render)->RenderScene(cmdBuffer, cmdBufferIndex, &m_windowTarget);
+        });
     }
 
     bool FWApplication::HandleKeyboard(int key, int scancode, int action, int mods, vkfw_core::VKWindow* sender)
@@ -119,26 +207,13 @@ namespace vkfw_app {
         // TODO: maybe use lambdas to register for resize events...
         if (window != GetWindow(0)) return;
 
-        switch (m_scene_to_render) {
-        case 0: m_simple_scene.CreatePipeline(screenSize, window); break;
-        case 1: m_rt_scene.CreatePipeline(screenSize, window); break;
-        default: break;
-        }
+        // pipelines of inactive scenes are recreated when they are activated.
+        m_screenSize = screenSize;
+        m_scenePipelineSizes.fill(glm::uvec2{0});
+        GetScene(m_scene_to_render)->CreatePipeline(screenSize, &m_windowTarget);
+        m_scenePipelineSizes[static_cast<std::size_t>(m_scene_to_render)] = screenSize;
 
-        window->UpdatePrimaryCommandBuffers(
-            [this, window](vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex) {
-                switch (m_scene_to_render) {
-                case 0: {
-                    m_simple_scene.RenderScene(cmdBuffer, cmdBufferIndex, window);
-                    break;
-                }
-                case 1: {
-                    m_rt_scene.RenderScene(cmdBuffer, cmdBufferIndex, window);
-                    break;
-                }
-                default: break;
-                }
-            });
+        RecordCommandBuffers(window);
     }
 
 }
@@ -0,0 +1,406 @@
+/**
+ * @file   HeadlessBenchmark.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the headless benchmark mode.
+ */
+
+#include "app/HeadlessBenchmark.h"
+#include "app/FWApplication.h"
+#include "app/SimpleScene.h"
+#include "app/RaytracingScene.h"
+#include "app_constants.h"
+#include "core/Timeline.h"
+#include "main.h"
+
+#include <app/Configuration.h>
+#include <gfx/vk/LogicalDevice.h>
+#include <gfx/camera/ArcballCamera.h>
+#include <cereal/archives/xml.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+namespace vkfw_app {
+
+    /** The number of offscreen images used, behaves like a double buffered swapchain. */
+    constexpr std::size_t NUM_OFFSCREEN_FRAMEBUFFERS = 2;
+    /** The simulated time step per frame, keeps animations deterministic. */
+    constexpr float FRAME_TIME_STEP = 1.0f / 60.0f;
+
+    bool BenchmarkSettings::ParseCommandLine(int argc, const char** argv, BenchmarkSettings& settings)
+    {
+        bool benchmark = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            auto nextArg = [argc, argv, &i, arg]() -> std::string_view {
+                if (i + 1 >= argc) { throw std::invalid_argument(fmt::format("Missing value for command line argument {}.", arg)); }
+                return argv[++i];
+            };
+            auto parseExtent = [&nextArg, arg]() {
+                auto extent = std::stoul(std::string{nextArg()});
+                if (extent == 0 || extent > std::numeric_limits<unsigned int>::max()) {
+                    throw std::invalid_argument(fmt::format("Value for command line argument {} has to be a positive number of pixels.", arg));
+                }
+                return static_cast<unsigned int>(extent);
+            };
+
+            if (arg == "--benchmark") {
+                benchmark = true;
+            } else if (arg == "--scene") {
+                auto sceneName = nextArg();
+                if (sceneName == "simple") {
+                    settings.m_scene = BenchmarkScene::Simple;
+                } else if (sceneName == "rt") {
+                    settings.m_scene = BenchmarkScene::RayTracing;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown scene '{}' (use 'simple' or 'rt').", sceneName));
+                }
+            } else if (arg == "--frames") {
+                settings.m_frames = std::stoull(std::string{nextArg()});
+            } else if (arg == "--warmup") {
+                settings.m_warmupFrames = std::stoull(std::string{nextArg()});
+            } else if (arg == "--width") {
+                settings.m_resolution.x = parseExtent();
+            } else if (arg == "--height") {
+                settings.m_resolution.y = parseExtent();
+            } else if (arg == "--texture-lod") {
+                auto lodMode = nextArg();
+                if (lodMode == "cone") {
+                    settings.m_rayConeTextureLod = true;
+                } else if (lodMode == "base") {
+                    settings.m_rayConeTextureLod = false;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown texture LOD mode '{}' (use 'cone' or 'base').", lodMode));
+                }
+            } else if (arg == "--adaptive-sampling") {
+                auto adaptiveMode = nextArg();
+                if (adaptiveMode == "on") {
+                    settings.m_adaptiveSampling = true;
+                } else if (adaptiveMode == "off") {
+                    settings.m_adaptiveSampling = false;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown adaptive sampling mode '{}' (use 'on' or 'off').", adaptiveMode));
+                }
+            } else if (arg == "--light-sampling") {
+                auto lightSamplingMode = nextArg();
+                if (lightSamplingMode == "on") {
+                    settings.m_lightSampling = true;
+                } else if (lightSamplingMode == "off") {
+                    settings.m_lightSampling = false;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown light sampling mode '{}' (use 'on' or 'off').", lightSamplingMode));
+                }
+            } else if (arg == "--vertex-layout") {
+                auto vertexLayout = nextArg();
+                if (vertexLayout == "full") {
+                    settings.m_compactVertices = false;
+                } else if (vertexLayout == "compact") {
+                    settings.m_compactVertices = true;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown vertex layout '{}' (use 'full' or 'compact').", vertexLayout));
+                }
+            } else if (arg == "--integrator") {
+                auto integratorName = nextArg();
+                if (integratorName == "ao") {
+                    settings.m_integrator = BenchmarkIntegrator::AmbientOcclusion;
+                } else if (integratorName == "path-megakernel") {
+                    settings.m_integrator = BenchmarkIntegrator::PathTracingMegakernel;
+                } else if (integratorName == "path-wavefront") {
+                    settings.m_integrator = BenchmarkIntegrator::PathTracingWavefront;
+                } else if (integratorName == "ao-query") {
+                    settings.m_integrator = BenchmarkIntegrator::AmbientOcclusionRayQuery;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown integrator '{}' (use 'ao', 'ao-query', 'path-megakernel' or 'path-wavefront').", integratorName));
+                }
+            } else if (arg == "--sampler") {
+                auto samplerName = nextArg();
+                if (samplerName == "random") {
+                    settings.m_sampler = BenchmarkSampler::Random;
+                } else if (samplerName == "sobol") {
+                    settings.m_sampler = BenchmarkSampler::Sobol;
+                } else if (samplerName == "bluenoise") {
+                    settings.m_sampler = BenchmarkSampler::BlueNoise;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown sampler '{}' (use 'random', 'sobol' or 'bluenoise').", samplerName));
+                }
+            } else if (arg == "--denoise") {
+                settings.m_denoiseIterations = static_cast<std::uint32_t>(std::stoul(std::string{nextArg()}));
+            } else if (arg == "--render-scale") {
+                auto renderScaleName = nextArg();
+                if (renderScaleName == "100") {
+                    settings.m_renderScale = BenchmarkRenderScale::Full;
+                } else if (renderScaleName == "67") {
+                    settings.m_renderScale = BenchmarkRenderScale::TwoThirds;
+                } else if (renderScaleName == "50") {
+                    settings.m_renderScale = BenchmarkRenderScale::Half;
+                } else if (renderScaleName == "checkerboard") {
+                    settings.m_renderScale = BenchmarkRenderScale::Checkerboard;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown render scale '{}' (use '100', '67', '50' or 'checkerboard').", renderScaleName));
+                }
+            } else if (arg == "--stress-teapots") {
+                settings.m_stressScene.m_numTeapots = static_cast<std::size_t>(std::stoull(std::string{nextArg()}));
+            } else if (arg == "--stress-sponzas") {
+                settings.m_stressScene.m_numSponzas = static_cast<std::size_t>(std::stoull(std::string{nextArg()}));
+            } else if (arg == "--stress-layout") {
+                auto stressLayout = nextArg();
+                if (stressLayout == "grid") {
+                    settings.m_stressScene.m_layout = scene::rt::StressLayout::Grid;
+                } else if (stressLayout == "scatter") {
+                    settings.m_stressScene.m_layout = scene::rt::StressLayout::Scatter;
+                } else {
+                    throw std::invalid_argument(fmt::format("Unknown stress layout '{}' (use 'grid' or 'scatter').", stressLayout));
+                }
+            } else if (arg == "--stress-seed") {
+                settings.m_stressScene.m_seed = static_cast<std::uint32_t>(std::stoul(std::string{nextArg()}));
+            } else if (arg == "--output") {
+                settings.m_outputFile = nextArg();
+            } else if (arg == "--trace") {
+                settings.m_traceFile = nextArg();
+            } else {
+                spdlog::warn("Ignoring unknown command line argument {}.", arg);
+            }
+        }
+        return benchmark;
+    }
+
+    HeadlessBenchmark::HeadlessBenchmark(const BenchmarkSettings& settings) : m_settings{settings}
+    {
+        InitializeVulkan();
+
+        m_camera = std::make_unique<vkfw_core::gfx::ArcballCamera>(glm::vec3(2.0f, 2.0f, 2.0f), glm::radians(45.0f),
+                                                                   static_cast<float>(m_settings.m_resolution.x) / static_cast<float>(m_settings.m_resolution.y), 0.1f, 10.0f);
+        m_target = std::make_unique<OffscreenRenderTarget>(m_device.get(), "BenchmarkTarget", m_settings.m_resolution, NUM_OFFSCREEN_FRAMEBUFFERS);
+
+        m_meshCache = std::make_unique<scene::MeshCache>();
+        m_textureCache = std::make_unique<scene::TextureCache>();
+        switch (m_settings.m_scene) {
+        case BenchmarkScene::Simple:
+            m_scene = std::make_unique<scene::simple::SimpleScene>(m_device.get(), m_camera.get(), m_meshCache.get(), m_textureCache.get(), NUM_OFFSCREEN_FRAMEBUFFERS);
+            break;
+        case BenchmarkScene::RayTracing: {
+            auto rtScene = std::make_unique<scene::rt::RaytracingScene>(m_device.get(), m_camera.get(), m_meshCache.get(), m_textureCache.get(), NUM_OFFSCREEN_FRAMEBUFFERS);
+            rtScene->SetRayConeTextureLod(m_settings.m_rayConeTextureLod);
+            rtScene->SetAdaptiveSampling(m_settings.m_adaptiveSampling);
+            rtScene->SetLightSampling(m_settings.m_lightSampling);
+            rtScene->SetCompactVertices(m_settings.m_compactVertices);
+            switch (m_settings.m_integrator) {
+            case BenchmarkIntegrator::AmbientOcclusion: rtScene->SetIntegrator(scene::rt::IntegratorType::AmbientOcclusion); break;
+            case BenchmarkIntegrator::PathTracingMegakernel: rtScene->SetIntegrator(scene::rt::IntegratorType::PathTracingMegakernel); break;
+            case BenchmarkIntegrator::PathTracingWavefront: rtScene->SetIntegrator(scene::rt::IntegratorType::PathTracingWavefront); break;
+            case BenchmarkIntegrator::AmbientOcclusionRayQuery: rtScene->SetIntegrator(scene::rt::IntegratorType::AmbientOcclusionRayQuery); break;
+            }
+            rtScene->SetDenoiseIterations(m_settings.m_denoiseIterations);
+            // the results report the number of iterations actually filtered.
+            m_settings.m_denoiseIterations = rtScene->GetDenoiseIterations();
+            switch (m_settings.m_sampler) {
+            case BenchmarkSampler::Random: rtScene->SetSamplerType(scene::rt::SamplerType::RandomSampler); break;
+            case BenchmarkSampler::Sobol: rtScene->SetSamplerType(scene::rt::SamplerType::SobolSampler); break;
+            case BenchmarkSampler::BlueNoise: rtScene->SetSamplerType(scene::rt::SamplerType::BlueNoiseSampler); break;
+            }
+            switch (m_settings.m_renderScale) {
+            case BenchmarkRenderScale::Full: rtScene->SetRenderScale(scene::rt::RenderScale::Full); break;
+            case BenchmarkRenderScale::TwoThirds: rtScene->SetRenderScale(scene::rt::RenderScale::TwoThirds); break;
+            case BenchmarkRenderScale::Half: rtScene->SetRenderScale(scene::rt::RenderScale::Half); break;
+            case BenchmarkRenderScale::Checkerboard: rtScene->SetRenderScale(scene::rt::RenderScale::Checkerboard); break;
+            }
+            if (m_settings.m_stressScene.m_numTeapots + m_settings.m_stressScene.m_numSponzas > 0) { rtScene->AddStressScene(m_settings.m_stressScene); }
+            m_rtScene = rtScene.get();
+            m_scene = std::move(rtScene);
+            break;
+        }
+        }
+
+        m_gpuTimeline = std::make_unique<gfx::GPUTimeline>(m_device.get(), NUM_OFFSCREEN_FRAMEBUFFERS);
+        m_scene->SetGPUTimeline(m_gpuTimeline.get());
+        m_pipelineCache = std::make_unique<gfx::PipelineCache>(m_device.get());
+        m_scene->SetPipelineCache(m_pipelineCache.get());
+
+        // measure the complete scene, not the progressively loaded one.
+        while (!m_scene->IsFullyLoaded()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            m_scene->UpdateStreamedResources();
+        }
+
+        m_scene->CreatePipeline(m_settings.m_resolution, m_target.get());
+        m_target->UpdatePrimaryCommandBuffers([this](vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex) {
+            m_gpuTimeline->ResetQueries(cmdBuffer, cmdBufferIndex);
+            m_scene->RenderScene(cmdBuffer, cmdBufferIndex, m_target.get());
+        });
+    }
+
+    HeadlessBenchmark::~HeadlessBenchmark()
+    {
+        if (m_device) { m_device->GetHandle().waitIdle(); }
+        m_scene.reset();
+        m_meshCache.reset();
+        m_textureCache.reset();
+        m_gpuTimeline.reset();
+        m_pipelineCache.reset();
+        m_target.reset();
+        m_device.reset();
+    }
+
+    void HeadlessBenchmark::InitializeVulkan()
+    {
+        vkfw_core::cfg::Configuration config;
+        {
+            std::ifstream configFile(std::string{configFileName}, std::ios::in);
+            if (!configFile.is_open()) { throw std::runtime_error(fmt::format("Could not open configuration file {}.", configFileName)); }
+            cereal::XMLInputArchive ia(configFile);
+            ia(cereal::make_nvp("configuration", config));
+        }
+        if (config.m_windows.empty()) { throw std::runtime_error("Configuration does not contain any window (device) configuration."); }
+
+        vk::ApplicationInfo appInfo{applicationName.data(), applicationVersion, "VKFW", applicationVersion, VK_API_VERSION_1_2};
+        // no surface extensions: the benchmark never presents.
+        m_instance = vk::createInstanceUnique(vk::InstanceCreateInfo{vk::InstanceCreateFlags{}, &appInfo});
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(*m_instance);
+
+        // the simple scene only rasterizes, so it also runs on devices (and software renderers) without ray tracing support.
+        const bool rayTracing = m_settings.m_scene == BenchmarkScene::RayTracing;
+        // every scene (and the offscreen target) records synchronization2 barriers and submits.
+        std::vector<std::string> deviceExtensions = {VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME};
+        if (rayTracing) {
+            deviceExtensions.insert(deviceExtensions.end(), {VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME, VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
+                                                             VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME, VK_KHR_RAY_QUERY_EXTENSION_NAME});
+        }
+        static vk::PhysicalDeviceSynchronization2FeaturesKHR synchronization2Features{VK_TRUE};
+        synchronization2Features.pNext = rayTracing ? GetDeviceFeaturesNextChain() : nullptr;
+
+        for (const auto& physicalDevice : m_instance->enumeratePhysicalDevices()) {
+            auto availableExtensions = physicalDevice.enumerateDeviceExtensionProperties();
+            bool supported = std::all_of(deviceExtensions.begin(), deviceExtensions.end(), [&availableExtensions](const std::string& ext) {
+                return std::any_of(availableExtensions.begin(), availableExtensions.end(),
+                                   [&ext](const vk::ExtensionProperties& available) { return ext == available.extensionName.data(); });
+            });
+            if (!supported) { continue; }
+
+            auto queueFamilies = physicalDevice.getQueueFamilyProperties();
+            std::vector<vkfw_core::gfx::DeviceQueueDesc> queueDescs;
+            for (const auto& queueCfg : config.m_windows[0].m_queues) {
+                vk::QueueFlags requiredFlags;
+                if (queueCfg.m_graphicsCaps) { requiredFlags |= vk::QueueFlagBits::eGraphics; }
+                if (queueCfg.m_computeCaps) { requiredFlags |= vk::QueueFlagBits::eCompute; }
+                if (queueCfg.m_transferCaps) { requiredFlags |= vk::QueueFlagBits::eTransfer; }
+                for (std::uint32_t family = 0; family < queueFamilies.size(); ++family) {
+                    if ((queueFamilies[family].queueFlags & requiredFlags) == requiredFlags) {
+                        queueDescs.emplace_back(family, queueCfg.m_priorities);
+                        break;
+                    }
+                }
+            }
+            if (queueDescs.size() != config.m_windows[0].m_queues.size()) { continue; }
+
+            spdlog::info("Running headless benchmark on device {}.", physicalDevice.getProperties().deviceName.data());
+            m_device = std::make_unique<vkfw_core::gfx::LogicalDevice>(config.m_windows[0], physicalDevice, queueDescs, deviceExtensions, &synchronization2Features);
+            return;
+        }
+
+        throw std::runtime_error(rayTracing ? "Could not find a device supporting ray tracing for the headless benchmark."
+                                            : "Could not find a device with the configured queues for the headless benchmark.");
+    }
+
+    void HeadlessBenchmark::Run()
+    {
+        using clock = std::chrono::high_resolution_clock;
+        using milliseconds = std::chrono::duration<double, std::milli>;
+
+        m_timings.clear();
+        m_timings.reserve(m_settings.m_frames);
+        auto totalFrames = m_settings.m_warmupFrames + m_settings.m_frames;
+        auto measureStart = clock::now();
+        for (std::size_t frame = 0; frame < totalFrames; ++frame) {
+            if (frame == m_settings.m_warmupFrames) { measureStart = clock::now(); }
+
+            auto frameStart = clock::now();
+            m_target->AcquireNextImage();
+            auto imageIndex = m_target->GetCurrentlyRenderedImageIndex();
+            {
+                TIMELINE_SCOPE("FrameMove");
+                m_scene->FrameMove(static_cast<float>(frame) * FRAME_TIME_STEP, FRAME_TIME_STEP, frame == 0, m_target.get());
+            }
+            {
+                TIMELINE_SCOPE("RenderScene");
+                m_scene->RenderScene(m_target.get());
+            }
+            auto cpuEnd = clock::now();
+            m_gpuTimeline->MarkSubmitted(imageIndex);
+            double gpuTime = 0.0;
+            {
+                TIMELINE_SCOPE("SubmitFrame");
+                gpuTime = m_target->SubmitFrame(m_scene->WaitsOnRenderingFinished());
+            }
+            auto frameEnd = clock::now();
+            m_gpuTimeline->CollectResults(imageIndex);
+            core::Timeline::Instance().Drain();
+
+            if (frame >= m_settings.m_warmupFrames) {
+                // the frame has finished on the GPU, its ray counters are available.
+                auto rays = m_rtScene != nullptr ? m_rtScene->GetTracedRays(imageIndex) : 0;
+                m_timings.push_back(FrameTiming{milliseconds{cpuEnd - frameStart}.count(), gpuTime, milliseconds{frameEnd - frameStart}.count(), rays});
+            }
+        }
+        m_totalTime = milliseconds{clock::now() - measureStart}.count();
+        m_device->GetHandle().waitIdle();
+
+        WriteResults();
+    }
+
+    void HeadlessBenchmark::WriteResults() const
+    {
+        std::ofstream out{m_settings.m_outputFile, std::ios::out | std::ios::trunc};
+        if (!out.is_open()) { throw std::runtime_error(fmt::format("Could not open benchmark output file {}.", m_settings.m_outputFile.string())); }
+
+        auto sum = [this](double FrameTiming::*member) {
+            return std::accumulate(m_timings.begin(), m_timings.end(), 0.0, [member](double s, const FrameTiming& t) { return s + t.*member; });
+        };
+        auto numFrames = static_cast<double>(std::max<std::size_t>(m_timings.size(), 1));
+        auto cpuTotal = sum(&FrameTiming::m_cpuTime);
+        auto gpuTotal = sum(&FrameTiming::m_gpuTime);
+        auto frameTotal = sum(&FrameTiming::m_frameTime);
+        auto raysTotal = std::accumulate(m_timings.begin(), m_timings.end(), std::uint64_t{0}, [](std::uint64_t s, const FrameTiming& t) { return s + t.m_rays; });
+        constexpr std::array<const char*, 4> integratorNames = {"ao", "path-megakernel", "path-wavefront", "ao-query"};
+        constexpr std::array<const char*, 3> samplerNames = {"random", "sobol", "bluenoise"};
+        constexpr std::array<const char*, 4> renderScaleNames = {"100", "67", "50", "checkerboard"};
+
+        out << "{\n";
+        out << fmt::format("  \"scene\": \"{}\",\n", m_settings.m_scene == BenchmarkScene::Simple ? "simple" : "rt");
+        out << fmt::format("  \"device\": \"{}\",\n", m_device->GetPhysicalDevice().getProperties().deviceName.data());
+        out << fmt::format("  \"width\": {},\n  \"height\": {},\n", m_settings.m_resolution.x, m_settings.m_resolution.y);
+        out << fmt::format("  \"warmupFrames\": {},\n", m_settings.m_warmupFrames);
+        out << fmt::format("  \"textureLod\": \"{}\",\n", m_settings.m_rayConeTextureLod ? "cone" : "base");
+        out << fmt::format("  \"adaptiveSampling\": {},\n", m_settings.m_adaptiveSampling);
+        out << fmt::format("  \"integrator\": \"{}\",\n", integratorNames[static_cast<std::size_t>(m_settings.m_integrator)]);
+        out << fmt::format("  \"lightSampling\": {},\n", m_settings.m_lightSampling);
+        out << fmt::format("  \"vertexLayout\": \"{}\",\n", m_settings.m_compactVertices ? "compact" : "full");
+        out << fmt::format("  \"sampler\": \"{}\",\n", samplerNames[static_cast<std::size_t>(m_settings.m_sampler)]);
+        out << fmt::format("  \"denoiseIterations\": {},\n", m_settings.m_denoiseIterations);
+        out << fmt::format("  \"renderScale\": \"{}\",\n", renderScaleNames[static_cast<std::size_t>(m_settings.m_renderScale)]);
+        out << fmt::format("  \"stressScene\": {{\"teapots\": {}, \"sponzas\": {}, \"layout\": \"{}\", \"seed\": {}}},\n", m_settings.m_stressScene.m_numTeapots,
+                           m_settings.m_stressScene.m_numSponzas, m_settings.m_stressScene.m_layout == scene::rt::StressLayout::Grid ? "grid" : "scatter",
+                           m_settings.m_stressScene.m_seed);
+        out << "  \"frames\": [\n";
+        for (std::size_t i = 0; i < m_timings.size(); ++i) {
+            out << fmt::format("    {{\"frame\": {}, \"cpuMs\": {:.4f}, \"gpuMs\": {:.4f}, \"frameMs\": {:.4f}, \"rays\": {}}}{}\n", i, m_timings[i].m_cpuTime,
+                               m_timings[i].m_gpuTime, m_timings[i].m_frameTime, m_timings[i].m_rays, i + 1 < m_timings.size() ? "," : "");
+        }
+        out << "  ],\n";
+        out << "  \"totals\": {\n";
+        out << fmt::format("    \"frames\": {},\n", m_timings.size());
+        out << fmt::format("    \"cpuMs\": {:.4f},\n    \"gpuMs\": {:.4f},\n    \"frameMs\": {:.4f},\n    \"wallMs\": {:.4f},\n", cpuTotal, gpuTotal, frameTotal, m_totalTime);
+        out << fmt::format("    \"avgCpuMs\": {:.4f},\n    \"avgGpuMs\": {:.4f},\n    \"avgFrameMs\": {:.4f},\n", cpuTotal / numFrames, gpuTotal / numFrames, frameTotal / numFrames);
+        out << fmt::format("    \"rays\": {},\n    \"raysPerSecond\": {:.1f}\n", raysTotal, gpuTotal > 0.0 ? static_cast<double>(raysTotal) / (gpuTotal / 1000.0) : 0.0);
+        out << "  }\n";
+        out << "}\n";
+
+        spdlog::info("Benchmark results written to {} (avg. CPU {:.3f} ms, avg. GPU {:.3f} ms).", m_settings.m_outputFile.string(), cpuTotal / numFrames, gpuTotal / numFrames);
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * @file   MeshCache.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the mesh cache.
+ */
+
+#include "app/MeshCache.h"
+#include "main.h"
+
+#include <gfx/meshes/AssImpScene.h>
+
+#include <chrono>
+
+namespace vkfw_app::scene {
+
+    MeshCache::MeshFuture MeshCache::RequestMesh(const std::string& meshFilename)
+    {
+        std::scoped_lock lock{m_meshesMutex};
+        auto& mesh = m_meshes[meshFilename];
+        if (!mesh.valid()) {
+            spdlog::info("Importing mesh {}.", meshFilename);
+            mesh = std::async(std::launch::async, [meshFilename]() {
+                       auto start = std::chrono::steady_clock::now();
+                       // no device: the import must not create GPU objects off the render thread.
+                       auto result = std::make_shared<vkfw_core::gfx::AssImpScene>(meshFilename, nullptr);
+                       spdlog::info("Imported mesh {} in {:.1f} ms.", meshFilename,
+                                    std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count());
+                       return result;
+                   }).share();
+        }
+        return mesh;
+    }
+
+    void MeshCache::ReleaseUnusedMeshes(const std::set<std::string>& usedMeshes)
+    {
+        std::scoped_lock lock{m_meshesMutex};
+        std::size_t numReleased = 0;
+        for (auto mesh = m_meshes.begin(); mesh != m_meshes.end();) {
+            // destroying the last future of an import still running would block until it finished.
+            if (!usedMeshes.contains(mesh->first) && mesh->second.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+                mesh = m_meshes.erase(mesh);
+                numReleased += 1;
+            } else {
+                ++mesh;
+            }
+        }
+        if (numReleased > 0) { spdlog::info("Released {} cached meshes, {} still in use.", numReleased, m_meshes.size()); }
+    }
+}
@@ -0,0 +1,158 @@
+/**
+ * @file   OffscreenRenderTarget.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the offscreen render target.
+ */
+
+#include "app/OffscreenRenderTarget.h"
+#include "main.h"
+
+#include <gfx/vk/LogicalDevice.h>
+#include <gfx/vk/wrappers/DescriptorSet.h>
+#include <gfx/vk/wrappers/VertexInputResources.h>
+
+namespace vkfw_app {
+
+    // The queue indices for the current configuration.
+    constexpr unsigned int GRAPHICS_QUEUE = 0;
+
+    OffscreenRenderTarget::OffscreenRenderTarget(vkfw_core::gfx::LogicalDevice* device, std::string_view name, const glm::uvec2& size, std::size_t numFramebuffers)
+        : m_device{device}
+        , m_name{name}
+        , m_size{size}
+        , m_renderPass{device->GetHandle(), fmt::format("{}RenderPass", name), vk::UniqueRenderPass{}}
+    {
+        CreateRenderPass();
+        CreateFramebuffers(numFramebuffers);
+
+        m_commandPool = m_device->CreateCommandPoolForQueue(fmt::format("{}CommandPool", m_name), GRAPHICS_QUEUE);
+        vk::CommandBufferAllocateInfo cmdBufferallocInfo{m_commandPool.GetHandle(), vk::CommandBufferLevel::ePrimary, static_cast<std::uint32_t>(numFramebuffers)};
+        m_commandBuffers = vkfw_core::gfx::CommandBuffer::Initialize(m_device, fmt::format("{}CommandBuffer", m_name), m_commandPool.GetQueueFamily(),
+                                                                     m_device->GetHandle().allocateCommandBuffersUnique(cmdBufferallocInfo));
+
+        m_frameFence = m_device->GetHandle().createFenceUnique(vk::FenceCreateInfo{});
+        m_dataAvailableSemaphore = m_device->GetHandle().createSemaphoreUnique(vk::SemaphoreCreateInfo{});
+        m_renderingFinishedSemaphore = m_device->GetHandle().createSemaphoreUnique(vk::SemaphoreCreateInfo{});
+
+        vk::QueryPoolCreateInfo queryPoolInfo{vk::QueryPoolCreateFlags{}, vk::QueryType::eTimestamp, static_cast<std::uint32_t>(2 * numFramebuffers)};
+        m_timestampQueryPool = m_device->GetHandle().createQueryPoolUnique(queryPoolInfo);
+        m_timestampPeriod = static_cast<double>(m_device->GetPhysicalDevice().getProperties().limits.timestampPeriod);
+    }
+
+    OffscreenRenderTarget::~OffscreenRenderTarget()
+    {
+        m_device->GetHandle().waitIdle();
+    }
+
+    void OffscreenRenderTarget::CreateRenderPass()
+    {
+        std::array<vk::AttachmentDescription, 2> attachments{
+            vk::AttachmentDescription{vk::AttachmentDescriptionFlags{}, COLOR_FORMAT, vk::SampleCountFlagBits::e1, vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore,
+                                      vk::AttachmentLoadOp::eDontCare, vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferSrcOptimal},
+            vk::AttachmentDescription{vk::AttachmentDescriptionFlags{}, DEPTH_FORMAT, vk::SampleCountFlagBits::e1, vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eDontCare,
+                                      vk::AttachmentLoadOp::eDontCare, vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined, vk::ImageLayout::eDepthStencilAttachmentOptimal}};
+
+        vk::AttachmentReference colorAttachmentRef{0, vk::ImageLayout::eColorAttachmentOptimal};
+        vk::AttachmentReference depthAttachmentRef{1, vk::ImageLayout::eDepthStencilAttachmentOptimal};
+        vk::SubpassDescription subpass{vk::SubpassDescriptionFlags{}, vk::PipelineBindPoint::eGraphics, nullptr, colorAttachmentRef, nullptr, &depthAttachmentRef};
+
+        vk::SubpassDependency dependency{VK_SUBPASS_EXTERNAL,
+                                         0,
+                                         vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eEarlyFragmentTests,
+                                         vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eEarlyFragmentTests,
+                                         vk::AccessFlags{},
+                                         vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite};
+
+        vk::RenderPassCreateInfo renderPassInfo{vk::RenderPassCreateFlags{}, attachments, subpass, dependency};
+        m_renderPass.SetHandle(m_device->GetHandle(), m_device->GetHandle().createRenderPassUnique(renderPassInfo));
+    }
+
+    void OffscreenRenderTarget::CreateFramebuffers(std::size_t numFramebuffers)
+    {
+        vkfw_core::gfx::TextureDescriptor colorTexDesc{4, COLOR_FORMAT, vk::SampleCountFlagBits::e1};
+        colorTexDesc.m_imageTiling = vk::ImageTiling::eOptimal;
+        colorTexDesc.m_imageUsage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc;
+        colorTexDesc.m_memoryProperties = vk::MemoryPropertyFlagBits::eDeviceLocal;
+
+        vkfw_core::gfx::TextureDescriptor depthTexDesc{4, DEPTH_FORMAT, vk::SampleCountFlagBits::e1};
+        depthTexDesc.m_imageTiling = vk::ImageTiling::eOptimal;
+        depthTexDesc.m_imageUsage = vk::ImageUsageFlagBits::eDepthStencilAttachment;
+        depthTexDesc.m_memoryProperties = vk::MemoryPropertyFlagBits::eDeviceLocal;
+
+        m_colorImages.reserve(numFramebuffers);
+        m_depthImages.reserve(numFramebuffers);
+        for (std::size_t i = 0; i < numFramebuffers; ++i) {
+            auto& colorImage = m_colorImages.emplace_back(m_device, fmt::format("{}ColorImage-{}", m_name, i), colorTexDesc, vk::ImageLayout::eUndefined);
+            colorImage.InitializeImage(glm::u32vec4{m_size, 1, 1}, 1);
+            auto& depthImage = m_depthImages.emplace_back(m_device, fmt::format("{}DepthImage-{}", m_name, i), depthTexDesc, vk::ImageLayout::eUndefined);
+            depthImage.InitializeImage(glm::u32vec4{m_size, 1, 1}, 1);
+
+            std::array<vk::ImageView, 2> attachments{colorImage.GetImageView().GetHandle(), depthImage.GetImageView().GetHandle()};
+            vk::FramebufferCreateInfo fbInfo{vk::FramebufferCreateFlags{}, m_renderPass.GetHandle(), attachments, m_size.x, m_size.y, 1};
+            m_framebuffers.emplace_back(m_device->GetHandle().createFramebufferUnique(fbInfo));
+        }
+    }
+
+    void OffscreenRenderTarget::BeginRenderPass(std::size_t cmdBufferIndex, std::span<vkfw_core::gfx::DescriptorSet*> descriptorSets,
+                                                std::span<vkfw_core::gfx::VertexInputResources*> vertexInputs)
+    {
+        auto& cmdBuffer = m_commandBuffers[cmdBufferIndex];
+        for (auto descriptorSet : descriptorSets) { descriptorSet->BindBarrier(cmdBuffer); }
+        for (auto vertexInput : vertexInputs) { vertexInput->BindBarrier(cmdBuffer); }
+
+        std::array<vk::ClearValue, 2> clearColor;
+        clearColor[0].setColor(vk::ClearColorValue{std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}});
+        clearColor[1].setDepthStencil(vk::ClearDepthStencilValue{1.0f, 0});
+        vk::RenderPassBeginInfo renderPassBeginInfo{m_renderPass.GetHandle(), *m_framebuffers[cmdBufferIndex], vk::Rect2D{vk::Offset2D{0, 0}, vk::Extent2D{m_size.x, m_size.y}}, clearColor};
+        cmdBuffer.GetHandle().beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
+    }
+
+    void OffscreenRenderTarget::EndRenderPass(std::size_t cmdBufferIndex) { m_commandBuffers[cmdBufferIndex].GetHandle().endRenderPass(); }
+
+    void OffscreenRenderTarget::UpdatePrimaryCommandBuffers(const std::function<void(vkfw_core::gfx::CommandBuffer& commandBuffer, std::size_t cmdBufferIndex)>& fillFunc)
+    {
+        m_device->GetHandle().waitIdle();
+        for (std::size_t i = 0; i < m_commandBuffers.size(); ++i) {
+            auto queryIndex = static_cast<std::uint32_t>(2 * i);
+            vk::CommandBufferBeginInfo beginInfo{vk::CommandBufferUsageFlagBits::eSimultaneousUse};
+            m_commandBuffers[i].Begin(beginInfo);
+            m_commandBuffers[i].GetHandle().resetQueryPool(*m_timestampQueryPool, queryIndex, 2);
+            m_commandBuffers[i].GetHandle().writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *m_timestampQueryPool, queryIndex);
+
+            fillFunc(m_commandBuffers[i], i);
+
+            m_commandBuffers[i].GetHandle().writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *m_timestampQueryPool, queryIndex + 1);
+            m_commandBuffers[i].End();
+        }
+    }
+
+    void OffscreenRenderTarget::AcquireNextImage() { m_currentImageIndex = (m_currentImageIndex + 1) % m_commandBuffers.size(); }
+
+    double OffscreenRenderTarget::SubmitFrame(bool signalRenderingFinished)
+    {
+        vk::SemaphoreSubmitInfoKHR waitSemaphore{*m_dataAvailableSemaphore, 0, vk::PipelineStageFlagBits2KHR::eAllCommands};
+        vk::SemaphoreSubmitInfoKHR signalSemaphore{*m_renderingFinishedSemaphore, 0, vk::PipelineStageFlagBits2KHR::eAllCommands};
+        vk::CommandBufferSubmitInfoKHR cmdBufferInfo{m_commandBuffers[m_currentImageIndex].GetHandle()};
+        vk::SubmitInfo2KHR submitInfo{vk::SubmitFlagsKHR{}, waitSemaphore, cmdBufferInfo};
+        if (signalRenderingFinished) { submitInfo.setSignalSemaphoreInfos(signalSemaphore); }
+
+        m_device->GetQueue(GRAPHICS_QUEUE, 0).GetHandle().submit2KHR(submitInfo, *m_frameFence);
+        if (auto r = m_device->GetHandle().waitForFences({*m_frameFence}, VK_TRUE, vkfw_core::defaultFenceTimeout); r != vk::Result::eSuccess) {
+            spdlog::error("Could not wait for fence while rendering offscreen frame: {}.", r);
+            throw std::runtime_error("Could not wait for fence while rendering offscreen frame.");
+        }
+        m_device->GetHandle().resetFences({*m_frameFence});
+
+        std::array<std::uint64_t, 2> timestamps = {0, 0};
+        auto queryIndex = static_cast<std::uint32_t>(2 * m_currentImageIndex);
+        if (auto r = m_device->GetHandle().getQueryPoolResults(*m_timestampQueryPool, queryIndex, 2, sizeof(timestamps), timestamps.data(), sizeof(std::uint64_t),
+                                                               vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+            r != vk::Result::eSuccess) {
+            spdlog::warn("Could not read time stamps of offscreen frame: {}.", r);
+            return 0.0;
+        }
+        return static_cast<double>(timestamps[1] - timestamps[0]) * m_timestampPeriod * 1e-6;
+    }
+}
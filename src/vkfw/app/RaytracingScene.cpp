@@ -7,6 +7,7 @@
  */
 
 #include "app/RaytracingScene.h"
+#include "app/MeshCache.h"
 
 #include <app/VKWindow.h>
 #include <core/resources/ShaderManager.h>
@@ -21,19 +22,50 @@
 #include <glm/gtc/matrix_inverse.hpp>
 #include "imgui.h"
 #include "gfx/AOIntegrator.h"
+#include "gfx/AOQueryIntegrator.h"
 #include "gfx/PathIntegrator.h"
+#include "gfx/Denoiser.h"
+#include "core/Timeline.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <map>
 
 #undef MemoryBarrier
 
 namespace vkfw_app::scene::rt {
 
+    namespace {
+        constexpr const char* TEAPOT_MESH = "teapot/teapot.obj";
+        constexpr const char* SPONZA_MESH = "sponza/sponza.obj";
+
+        /** The transform of the meshes in the default scene, stress scene instances are placed relative to it. */
+        glm::mat4 DefaultWorldMatrix() { return glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.015f)); }
+
+        /** Minimum time between two acceleration structure rebuilds while meshes are still streamed in. */
+        constexpr auto STREAMING_REBUILD_INTERVAL = std::chrono::milliseconds{250};
+
+        /** Descriptor arrays grow to the next power of two, so most streamed in meshes fit into the existing layout. */
+        std::uint32_t DescriptorCapacity(std::size_t count) { return count == 0 ? 0 : std::bit_ceil(static_cast<std::uint32_t>(count)); }
+
+        template<typename T> void PadDescriptors(std::vector<T>& descriptors, std::uint32_t capacity)
+        {
+            if (!descriptors.empty()) { descriptors.resize(capacity, descriptors.front()); }
+        }
+    }
+
     RaytracingScene::RaytracingScene(vkfw_core::gfx::LogicalDevice* t_device,
                                      vkfw_core::gfx::UserControlledCamera* t_camera,
+                                     MeshCache* t_meshCache,
+                                     TextureCache* t_textureCache,
                                      std::size_t t_num_framebuffers)
-        : Scene(t_device, t_camera, t_num_framebuffers)
+        : Scene(t_device, t_camera, t_meshCache, t_textureCache, t_num_framebuffers)
         , m_memGroup{GetDevice(), "RTSceneMemoryGroup", vk::MemoryPropertyFlags()}
         , m_cameraUBO{vkfw_core::gfx::UniformBufferObject::Create<CameraPropertiesBuffer>(GetDevice(), GetNumberOfFramebuffers())}
-        , m_asGeometry{GetDevice(), "RTSceneASGeometry", std::vector<std::uint32_t>{{0, 1}}}
         , m_sampler{GetDevice()->GetHandle(), "RTSceneSampler", vk::UniqueSampler{}}
         , m_rtResourcesDescriptorSetLayout{"RTSceneResourcesDescriptorSetLayout"}
         , m_convergenceImageDescriptorSetLayout{"RTSceneConvergenceDescriptorSet"}
@@ -42,32 +74,69 @@ namespace vkfw_app::scene::rt {
         , m_accumulatedResultSampler{GetDevice()->GetHandle(), "AccumulatedResultSampler", vk::UniqueSampler{}}
         , m_accumulatedResultImageDescriptorSetLayout{"AccumulatedResultDescriptorSet"}
         , m_compositingPipelineLayout{GetDevice()->GetHandle(), "RTCompositingPipelineLayout", vk::UniquePipelineLayout{}}
-        , m_compositingFullscreenQuad{"shader/rt/ao/ao_composite.frag", 1}
+        , m_compositingPipeline{GetDevice()}
     {
-        vk::SamplerCreateInfo samplerCreateInfo{vk::SamplerCreateFlags(),       vk::Filter::eLinear, vk::Filter::eLinear, vk::SamplerMipmapMode::eNearest, vk::SamplerAddressMode::eRepeat, vk::SamplerAddressMode::eRepeat,
+        vk::SamplerCreateInfo samplerCreateInfo{vk::SamplerCreateFlags(),       vk::Filter::eLinear, vk::Filter::eLinear, vk::SamplerMipmapMode::eLinear, vk::SamplerAddressMode::eRepeat, vk::SamplerAddressMode::eRepeat,
                                                 vk::SamplerAddressMode::eRepeat};
+        // the hit shaders select the mip level explicitly (ray cones).
+        samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
         m_sampler.SetHandle(GetDevice()->GetHandle(), GetDevice()->GetHandle().createSamplerUnique(samplerCreateInfo));
 
-        m_integrator = std::make_unique<gfx::rt::AOIntegrator>(GetDevice());
+        CreateIntegrator();
+        m_denoiser = std::make_unique<gfx::rt::Denoiser>(GetDevice());
 
         m_triangleMaterial.m_materialName = "RT_DemoScene_TriangleMaterial";
         m_triangleMaterial.m_Kr = glm::vec3{0.988f, 0.059f, 0.753};
+        m_areaLightMaterial.m_materialName = "RT_DemoScene_AreaLightMaterial";
+        m_areaLightMaterial.m_Le = glm::vec3{20.0f, 18.0f, 15.0f};
         InitializeScene();
         InitializeDescriptorSets();
     }
 
     RaytracingScene::~RaytracingScene() = default;
 
+    void RaytracingScene::CreateIntegrator()
+    {
+        switch (m_requestedIntegratorType) {
+        case IntegratorType::AmbientOcclusion: m_integrator = std::make_unique<gfx::rt::AOIntegrator>(GetDevice()); break;
+        case IntegratorType::AmbientOcclusionRayQuery: m_integrator = std::make_unique<gfx::rt::AOQueryIntegrator>(GetDevice()); break;
+        case IntegratorType::PathTracingMegakernel:
+            m_integrator = std::make_unique<gfx::rt::PathIntegrator>(GetDevice(), gfx::rt::PathIntegrator::Mode::Megakernel);
+            break;
+        case IntegratorType::PathTracingWavefront:
+            m_integrator = std::make_unique<gfx::rt::PathIntegrator>(GetDevice(), gfx::rt::PathIntegrator::Mode::Wavefront);
+            break;
+        }
+        m_integratorType = m_requestedIntegratorType;
+        m_integratorPipelineValid = false;
+    }
+
     void RaytracingScene::InitializeScene()
     {
         auto numUBOBuffers = GetNumberOfFramebuffers();
 
         m_cameraProperties.viewInverse = glm::inverse(GetCamera()->GetViewMatrix());
         m_cameraProperties.projInverse = glm::inverse(GetCamera()->GetProjMatrix());
+        m_lastViewProj = GetCamera()->GetProjMatrix() * GetCamera()->GetViewMatrix();
+        m_lastCameraPosition = m_cameraProperties.viewInverse[3];
+        m_cameraProperties.prevViewProj = m_lastViewProj;
+        m_cameraProperties.prevCameraPosition = m_lastCameraPosition;
         m_cameraProperties.frameId = 0;
         m_cameraProperties.cosineSampled = 0;
         m_cameraProperties.cameraMovedThisFrame = 1;
         m_cameraProperties.maxRange = 10.0f;
+        m_cameraProperties.pixelSpreadAngle = 0.0f;
+        m_cameraProperties.rayConeLod = 1;
+        m_cameraProperties.convergenceThreshold = 0.01f;
+        m_cameraProperties.adaptiveSampling = 1;
+        m_cameraProperties.lightSampling = 1;
+        m_cameraProperties.numLightTriangles = 0;
+        m_cameraProperties.samplerType = static_cast<std::uint32_t>(SamplerType::SobolSampler);
+        m_cameraProperties.historyMode = static_cast<std::uint32_t>(HistoryMode::HistoryReset);
+        m_cameraProperties.checkerboard = 0;
+        m_cameraProperties.compactVertices = m_compactVertices ? 1 : 0;
+        m_cameraProperties.alphaTestedGeometry = 1;
+        m_checkerboardPhases.resize(numUBOBuffers, 0);
         auto uboSize = m_cameraUBO.GetCompleteSize();
 
         // Setup vertices for a single triangle
@@ -77,11 +146,9 @@ namespace vkfw_app::scene::rt {
         // Setup indices
         std::vector<uint32_t> indicesRT = {0, 1, 2};
 
-        m_teapotMeshInfo = std::make_shared<vkfw_core::gfx::AssImpScene>("teapot/teapot.obj", GetDevice());
-        m_sponzaMeshInfo = std::make_shared<vkfw_core::gfx::AssImpScene>("sponza/sponza.obj", GetDevice());
-
-        glm::mat4 worldMatrixTeapot = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.015f));
-        glm::mat4 worldMatrixSponza = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.015f));
+        // the meshes are imported in parallel and added to the scene as soon as they are available.
+        RequestSceneMesh(TEAPOT_MESH, DefaultWorldMatrix());
+        RequestSceneMesh(SPONZA_MESH, DefaultWorldMatrix());
 
         auto indexBufferOffset = GetDevice()->CalculateStorageBufferAlignment(vkfw_core::byteSizeOf(vertices));
         // this is not documented but it seems this memory needs the same alignment as uniform buffers.
@@ -89,16 +156,65 @@ namespace vkfw_app::scene::rt {
         auto uniformDataOffset =
             GetDevice()->CalculateUniformBufferAlignment(indexBufferOffset + vkfw_core::byteSizeOf(indicesRT));
         auto completeBufferSize = uniformDataOffset + uboSize;
-        auto completeBufferIdx = m_memGroup.AddBufferToGroup("RTSceneCompleteBuffer",
+        m_triangleBufferIdx = m_memGroup.AddBufferToGroup("RTSceneCompleteBuffer",
             vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer
                 | vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eUniformBuffer
                 | vk::BufferUsageFlagBits::eShaderDeviceAddress | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR,
             completeBufferSize, std::vector<std::uint32_t>{{0, 1}});
 
-        m_memGroup.AddDataToBufferInGroup(completeBufferIdx, 0, vertices);
-        m_memGroup.AddDataToBufferInGroup(completeBufferIdx, indexBufferOffset, indicesRT);
+        m_memGroup.AddDataToBufferInGroup(m_triangleBufferIdx, 0, vertices);
+        m_memGroup.AddDataToBufferInGroup(m_triangleBufferIdx, indexBufferOffset, indicesRT);
+        m_numTriangleVertices = vertices.size();
+
+        m_cameraUBO.AddUBOToBuffer(&m_memGroup, m_triangleBufferIdx, uniformDataOffset, m_cameraProperties);
+
+        // the demo geometry is small, it is uploaded in both vertex layouts so switching the layout only rebuilds the acceleration structure.
+        auto addCompactGeometry = [this](std::string_view bufferName, const std::vector<RayTracingVertex>& geometryVertices, const std::vector<std::uint32_t>& geometryIndices) {
+            std::vector<CompactRayTracingVertex> compactVertices(geometryVertices.begin(), geometryVertices.end());
+            auto compactIndexOffset = GetDevice()->CalculateStorageBufferAlignment(vkfw_core::byteSizeOf(compactVertices));
+            auto bufferIdx = m_memGroup.AddBufferToGroup(std::string{bufferName},
+                vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eStorageBuffer
+                    | vk::BufferUsageFlagBits::eShaderDeviceAddress | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR,
+                compactIndexOffset + vkfw_core::byteSizeOf(geometryIndices), std::vector<std::uint32_t>{{0, 1}});
+            m_memGroup.AddDataToBufferInGroup(bufferIdx, 0, compactVertices);
+            m_memGroup.AddDataToBufferInGroup(bufferIdx, compactIndexOffset, geometryIndices);
+            return bufferIdx;
+        };
+        m_compactTriangleBufferIdx = addCompactGeometry("RTSceneCompactTriangleBuffer", vertices, indicesRT);
 
-        m_cameraUBO.AddUBOToBuffer(&m_memGroup, completeBufferIdx, uniformDataOffset, m_cameraProperties);
+        {
+            // a small ceiling light above the demo models, the only emitter of the scene.
+            const glm::vec3 lightNormal{0.0f, -1.0f, 0.0f};
+            std::vector<RayTracingVertex> areaLightVertices = {{glm::vec3{0.5f, 4.0f, -0.5f}, lightNormal, glm::vec4{1.0f}, glm::vec2{0.0f, 0.0f}},
+                                                               {glm::vec3{1.5f, 4.0f, -0.5f}, lightNormal, glm::vec4{1.0f}, glm::vec2{1.0f, 0.0f}},
+                                                               {glm::vec3{1.5f, 4.0f, 0.5f}, lightNormal, glm::vec4{1.0f}, glm::vec2{1.0f, 1.0f}},
+                                                               {glm::vec3{0.5f, 4.0f, 0.5f}, lightNormal, glm::vec4{1.0f}, glm::vec2{0.0f, 1.0f}}};
+            std::vector<uint32_t> areaLightIndices = {0, 1, 2, 0, 2, 3};
+            for (std::size_t i = 0; i < areaLightIndices.size(); i += 3) {
+                m_emissiveTriangles.push_back(gfx::EmissiveTriangle{{areaLightVertices[areaLightIndices[i]].position, areaLightVertices[areaLightIndices[i + 1]].position,
+                                                                     areaLightVertices[areaLightIndices[i + 2]].position},
+                                                                    m_areaLightMaterial.m_Le});
+            }
+
+            // same layout as the triangle buffer: vertices first, then the indices.
+            auto areaLightIndexOffset = GetDevice()->CalculateStorageBufferAlignment(vkfw_core::byteSizeOf(areaLightVertices));
+            m_areaLightBufferIdx = m_memGroup.AddBufferToGroup("RTSceneAreaLightBuffer",
+                vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eStorageBuffer
+                    | vk::BufferUsageFlagBits::eShaderDeviceAddress | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR,
+                areaLightIndexOffset + vkfw_core::byteSizeOf(areaLightIndices), std::vector<std::uint32_t>{{0, 1}});
+            m_memGroup.AddDataToBufferInGroup(m_areaLightBufferIdx, 0, areaLightVertices);
+            m_memGroup.AddDataToBufferInGroup(m_areaLightBufferIdx, areaLightIndexOffset, areaLightIndices);
+            m_numAreaLightVertices = areaLightVertices.size();
+            m_compactAreaLightBufferIdx = addCompactGeometry("RTSceneCompactAreaLightBuffer", areaLightVertices, areaLightIndices);
+        }
+
+        {
+            // Sobol direction numbers and the blue noise tile, shared by all sample generators.
+            auto samplerTables = gfx::CreateSamplerTables();
+            m_samplerTablesBufferIdx = m_memGroup.AddBufferToGroup("RTSceneSamplerTablesBuffer", vk::BufferUsageFlagBits::eStorageBuffer, vkfw_core::byteSizeOf(samplerTables),
+                                                                   std::vector<std::uint32_t>{{0, 1}});
+            m_memGroup.AddDataToBufferInGroup(m_samplerTablesBufferIdx, 0, samplerTables);
+        }
 
         vkfw_core::gfx::QueuedDeviceTransfer transfer{GetDevice(), GetDevice()->GetQueue(TRANSFER_QUEUE, 0)};
         m_memGroup.FinalizeDeviceGroup();
@@ -121,35 +237,81 @@ namespace vkfw_app::scene::rt {
             }
         }
 
-        m_asGeometry.AddTriangleGeometry(glm::mat3x4{1.0f}, m_triangleMaterial, m_integrator->GetMaterialSBTMapping(), 1, vertices.size(), sizeof(RayTracingVertex),
-                                         m_memGroup.GetBuffer(completeBufferIdx));
+        {
+            vk::SamplerCreateInfo samplerCreateInfo{vk::SamplerCreateFlags(),       vk::Filter::eLinear, vk::Filter::eLinear, vk::SamplerMipmapMode::eNearest, vk::SamplerAddressMode::eRepeat, vk::SamplerAddressMode::eRepeat,
+                                                    vk::SamplerAddressMode::eRepeat};
+            m_accumulatedResultSampler.SetHandle(GetDevice()->GetHandle(), GetDevice()->GetHandle().createSamplerUnique(samplerCreateInfo));
+        }
 
-        m_asGeometry.AddMeshGeometry(*m_teapotMeshInfo.get(), worldMatrixTeapot);
-        m_asGeometry.AddMeshGeometry(*m_sponzaMeshInfo.get(), worldMatrixSponza);
+        BuildAccelerationStructure();
+    }
 
-        vkfw_core::gfx::rt::AccelerationStructureGeometry::AccelerationStructureBufferInfo bufferInfo;
-        m_asGeometry.FinalizeGeometry<RayTracingVertex>(bufferInfo);
-        m_asGeometry.FinalizeMaterial<vkfw_app::gfx::MirrorMaterialInfo>(bufferInfo);
-        m_asGeometry.FinalizeMaterial<vkfw_core::gfx::PhongBumpMaterialInfo>(bufferInfo);
-        m_asGeometry.FinalizeBuffer(bufferInfo, m_integrator->GetMaterialSBTMapping());
+    void RaytracingScene::RequestSceneMesh(const std::string& meshFilename, const glm::mat4& worldMatrix)
+    {
+        auto instance = std::find_if(m_sceneMeshes.begin(), m_sceneMeshes.end(), [&meshFilename](const SceneMesh& sceneMesh) { return sceneMesh.m_meshFilename == meshFilename; });
+        if (instance != m_sceneMeshes.end()) {
+            m_sceneMeshes.emplace_back(SceneMesh{meshFilename, instance->m_mesh, worldMatrix, MeshState::Loading, instance->m_opacity});
+            return;
+        }
 
-        // m_asGeometry.AddMeshGeometry(*m_meshInfo.get(), worldMatrixMesh);
-        // m_asGeometry.FinalizeMeshGeometry<RayTracingVertex>();
+        auto mesh = RequestMesh(meshFilename);
+        auto opacity = std::async(std::launch::async, [mesh, meshFilename]() {
+                           auto start = std::chrono::steady_clock::now();
+                           auto result = gfx::ClassifyTriangleOpacity(*mesh.get());
+                           spdlog::info("Classified triangles of {} in {:.1f} ms: {} opaque, {} transparent, {} alpha tested.", meshFilename,
+                                        std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count(), result.m_counts[0],
+                                        result.m_counts[1], result.m_counts[2]);
+                           return result;
+                       }).share();
+        m_sceneMeshes.emplace_back(SceneMesh{meshFilename, std::move(mesh), worldMatrix, MeshState::Loading, std::move(opacity)});
+    }
 
-        m_asGeometry.BuildAccelerationStructure();
+    void RaytracingScene::AddStressScene(const StressSceneSettings& settings)
+    {
+        auto instances = GenerateStressInstances(settings);
+        m_sceneMeshes.reserve(m_sceneMeshes.size() + instances.size());
+        for (const auto& instance : instances) {
+            RequestSceneMesh(instance.m_mesh == StressMesh::Teapot ? TEAPOT_MESH : SPONZA_MESH, instance.m_worldMatrix * DefaultWorldMatrix());
+        }
+        spdlog::info("Added stress scene with {} teapots and {} Sponza instances (seed {}).", settings.m_numTeapots, settings.m_numSponzas, settings.m_seed);
+    }
 
-        {
-            vk::SamplerCreateInfo samplerCreateInfo{vk::SamplerCreateFlags(),       vk::Filter::eLinear, vk::Filter::eLinear, vk::SamplerMipmapMode::eNearest, vk::SamplerAddressMode::eRepeat, vk::SamplerAddressMode::eRepeat,
-                                                    vk::SamplerAddressMode::eRepeat};
-            m_accumulatedResultSampler.SetHandle(GetDevice()->GetHandle(), GetDevice()->GetHandle().createSamplerUnique(samplerCreateInfo));
+    void RaytracingScene::BuildAccelerationStructure()
+    {
+        m_asGeometry = std::make_unique<vkfw_core::gfx::rt::AccelerationStructureGeometry>(GetDevice(), "RTSceneASGeometry", std::vector<std::uint32_t>{{0, 1}});
+        const auto vertexSize = m_compactVertices ? sizeof(CompactRayTracingVertex) : sizeof(RayTracingVertex);
+        m_asGeometry->AddTriangleGeometry(glm::mat3x4{1.0f}, m_triangleMaterial, m_integrator->GetMaterialSBTMapping(), 1, m_numTriangleVertices, vertexSize,
+                                          m_memGroup.GetBuffer(m_compactVertices ? m_compactTriangleBufferIdx : m_triangleBufferIdx));
+        // the light triangles are built from the emissive geometry in the same order.
+        m_areaLightMaterial.m_firstLightTriangle = 0;
+        m_asGeometry->AddTriangleGeometry(glm::mat3x4{1.0f}, m_areaLightMaterial, m_integrator->GetMaterialSBTMapping(), m_emissiveTriangles.size(), m_numAreaLightVertices,
+                                          vertexSize, m_memGroup.GetBuffer(m_compactVertices ? m_compactAreaLightBufferIdx : m_areaLightBufferIdx));
+
+        for (const auto& sceneMesh : m_sceneMeshes) {
+            if (sceneMesh.m_state == MeshState::Added) { m_asGeometry->AddMeshGeometry(*sceneMesh.m_mesh.get(), sceneMesh.m_worldMatrix); }
+        }
+
+        vkfw_core::gfx::rt::AccelerationStructureGeometry::AccelerationStructureBufferInfo bufferInfo;
+        if (m_compactVertices) {
+            m_asGeometry->FinalizeGeometry<CompactRayTracingVertex>(bufferInfo);
+        } else {
+            m_asGeometry->FinalizeGeometry<RayTracingVertex>(bufferInfo);
         }
+        m_asGeometry->FinalizeMaterial<vkfw_app::gfx::MirrorMaterialInfo>(bufferInfo);
+        m_asGeometry->FinalizeMaterial<vkfw_core::gfx::PhongBumpMaterialInfo>(bufferInfo);
+        m_asGeometry->FinalizeMaterial<vkfw_app::gfx::EmissiveMaterialInfo>(bufferInfo);
+        m_asGeometry->FinalizeBuffer(bufferInfo, m_integrator->GetMaterialSBTMapping());
+        InitializeLightSampler();
+        InitializeTriangleOpacity();
+
+        m_asGeometry->BuildAccelerationStructure();
 
         {
             // This barrier is needed to get all images into the same layout they will be at the beginning of each command buffer submit.
             // if we would fill the command buffer each frame (and therefore create barriers containing the actual image layouts) this would not be neccessary.
             auto cmdBuffer = vkfw_core::gfx::CommandBuffer::beginSingleTimeSubmit(GetDevice(), "TransferImageLayoutsInitialCommandBuffer", "TransferImageLayoutsInitial", GetDevice()->GetCommandPool(GRAPHICS_QUEUE));
             vkfw_core::gfx::PipelineBarrier barrier{GetDevice()};
-            m_asGeometry.CreateResourceUseBarriers(vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eRayTracingShader, vk::ImageLayout::eShaderReadOnlyOptimal, barrier);
+            m_asGeometry->CreateResourceUseBarriers(vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eRayTracingShader, vk::ImageLayout::eShaderReadOnlyOptimal, barrier);
             barrier.Record(cmdBuffer);
             auto fence = vkfw_core::gfx::CommandBuffer::endSingleTimeSubmit(GetDevice()->GetQueue(GRAPHICS_QUEUE, 0), cmdBuffer, {}, {});
             if (auto r = GetDevice()->GetHandle().waitForFences({fence->GetHandle()}, VK_TRUE, vkfw_core::defaultFenceTimeout); r != vk::Result::eSuccess) {
@@ -159,24 +321,116 @@ namespace vkfw_app::scene::rt {
         }
     }
 
+    void RaytracingScene::InitializeLightSampler()
+    {
+        gfx::LightSampler lightSampler{m_emissiveTriangles};
+        m_cameraProperties.numLightTriangles = lightSampler.GetNumLightTriangles();
+
+        m_lightMemGroup = std::make_unique<vkfw_core::gfx::MemoryGroup>(GetDevice(), "RTSceneLightMemoryGroup", vk::MemoryPropertyFlags());
+        m_lightTrianglesBufferIdx = m_lightMemGroup->AddBufferToGroup("RTSceneLightTrianglesBuffer", vk::BufferUsageFlagBits::eStorageBuffer,
+                                                                      vkfw_core::byteSizeOf(lightSampler.GetLightTriangles()), std::vector<std::uint32_t>{{0, 1}});
+        m_lightAliasTableBufferIdx = m_lightMemGroup->AddBufferToGroup("RTSceneLightAliasTableBuffer", vk::BufferUsageFlagBits::eStorageBuffer,
+                                                                       vkfw_core::byteSizeOf(lightSampler.GetAliasTable()), std::vector<std::uint32_t>{{0, 1}});
+        m_lightMemGroup->AddDataToBufferInGroup(m_lightTrianglesBufferIdx, 0, lightSampler.GetLightTriangles());
+        m_lightMemGroup->AddDataToBufferInGroup(m_lightAliasTableBufferIdx, 0, lightSampler.GetAliasTable());
+
+        vkfw_core::gfx::QueuedDeviceTransfer transfer{GetDevice(), GetDevice()->GetQueue(TRANSFER_QUEUE, 0)};
+        m_lightMemGroup->FinalizeDeviceGroup();
+        m_lightMemGroup->TransferData(transfer);
+        transfer.FinishTransfer();
+    }
+
+    void RaytracingScene::InitializeTriangleOpacity()
+    {
+        // one entry per geometry buffer in the order they are added to the acceleration structure, the triangle and the area light are not alpha tested.
+        std::vector<std::uint32_t> triangleOpacity{0, 0};
+        for (const auto& sceneMesh : m_sceneMeshes) {
+            if (sceneMesh.m_state == MeshState::Added) { triangleOpacity.push_back(0); }
+        }
+        // instances of the same mesh share the classification and point to the same classes.
+        std::map<const gfx::TriangleOpacity*, std::uint32_t> classesOffsets;
+        std::size_t geometryIndex = 2;
+        std::size_t numNonOpaqueTriangles = 0;
+        for (const auto& sceneMesh : m_sceneMeshes) {
+            if (sceneMesh.m_state != MeshState::Added) { continue; }
+            const auto& opacity = sceneMesh.m_opacity.get();
+            numNonOpaqueTriangles += opacity.m_counts[1] + opacity.m_counts[2];
+            auto [classesOffset, inserted] = classesOffsets.try_emplace(&opacity, static_cast<std::uint32_t>(triangleOpacity.size()));
+            if (inserted) { triangleOpacity.insert(triangleOpacity.end(), opacity.m_classes.begin(), opacity.m_classes.end()); }
+            triangleOpacity[geometryIndex++] = classesOffset->second;
+        }
+        // the geometry flags are owned by the acceleration structure, scenes without any transparent triangle trace opaque rays instead.
+        m_cameraProperties.alphaTestedGeometry = numNonOpaqueTriangles > 0 ? 1 : 0;
+
+        m_opacityMemGroup = std::make_unique<vkfw_core::gfx::MemoryGroup>(GetDevice(), "RTSceneOpacityMemoryGroup", vk::MemoryPropertyFlags());
+        m_triangleOpacityBufferIdx = m_opacityMemGroup->AddBufferToGroup("RTSceneTriangleOpacityBuffer", vk::BufferUsageFlagBits::eStorageBuffer,
+                                                                         vkfw_core::byteSizeOf(triangleOpacity), std::vector<std::uint32_t>{{0, 1}});
+        m_opacityMemGroup->AddDataToBufferInGroup(m_triangleOpacityBufferIdx, 0, triangleOpacity);
+
+        vkfw_core::gfx::QueuedDeviceTransfer transfer{GetDevice(), GetDevice()->GetQueue(TRANSFER_QUEUE, 0)};
+        m_opacityMemGroup->FinalizeDeviceGroup();
+        m_opacityMemGroup->TransferData(transfer);
+        transfer.FinishTransfer();
+    }
+
+    std::pair<std::size_t, std::size_t> RaytracingScene::GetGeometryDescriptorCounts() const
+    {
+        std::vector<vkfw_core::gfx::BufferRange> vboBufferRanges;
+        std::vector<vkfw_core::gfx::BufferRange> iboBufferRanges;
+        vkfw_core::gfx::BufferRange instanceBufferRange;
+        std::vector<vkfw_core::gfx::Texture*> textures;
+        m_asGeometry->FillGeometryInfo(vboBufferRanges, iboBufferRanges, instanceBufferRange);
+        m_asGeometry->FillTextureInfo(textures);
+        return {std::max(vboBufferRanges.size(), iboBufferRanges.size()), textures.size()};
+    }
+
     void RaytracingScene::InitializeDescriptorSets()
     {
         using UniformBufferObject = vkfw_core::gfx::UniformBufferObject;
         using Texture = vkfw_core::gfx::Texture;
         using ResBindings = ResSetBindings;
+        // the pipeline layouts are recreated below.
+        m_integratorPipelineValid = false;
         using ConvBindings = ConvSetBindings;
 
-        m_asGeometry.AddDescriptorLayoutBindingAS(m_rtResourcesDescriptorSetLayout, vk::ShaderStageFlagBits::eRaygenKHR, static_cast<uint32_t>(ResBindings::AccelerationStructure));
-        m_asGeometry.AddDescriptorLayoutBindingBuffers(m_rtResourcesDescriptorSetLayout, vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR, static_cast<uint32_t>(ResBindings::Vertices),
-                                                       static_cast<uint32_t>(ResBindings::Indices), static_cast<uint32_t>(ResBindings::InstanceInfos),
-                                                       static_cast<uint32_t>(ResBindings::Textures));
-
-        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::PhongBumpMaterialInfos), vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR);
-        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::MirrorMaterialInfos), vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR);
-        UniformBufferObject::AddDescriptorLayoutBinding(m_rtResourcesDescriptorSetLayout, vk::ShaderStageFlagBits::eRaygenKHR, true, static_cast<uint32_t>(ResBindings::CameraProperties));
-
-        Texture::AddDescriptorLayoutBinding(m_convergenceImageDescriptorSetLayout, vk::DescriptorType::eStorageImage, vk::ShaderStageFlagBits::eRaygenKHR, static_cast<uint32_t>(ConvBindings::ResultImage));
+        // the layouts are recreated when the meshes in the acceleration structure exceed the capacity of the geometry arrays.
+        m_rtResourcesDescriptorSetLayout = vkfw_core::gfx::DescriptorSetLayout{"RTSceneResourcesDescriptorSetLayout"};
+        m_convergenceImageDescriptorSetLayout = vkfw_core::gfx::DescriptorSetLayout{"RTSceneConvergenceDescriptorSet"};
+        m_accumulatedResultImageDescriptorSetLayout = vkfw_core::gfx::DescriptorSetLayout{"AccumulatedResultDescriptorSet"};
+        m_convergenceImageDescriptorSets.clear();
+        m_accumulatedResultImageDescriptorSets.clear();
+
+        // rays are generated in ray generation shaders or in compute shaders with ray queries.
+        const auto traceStages = vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eCompute;
+        m_asGeometry->AddDescriptorLayoutBindingAS(m_rtResourcesDescriptorSetLayout, traceStages, static_cast<uint32_t>(ResBindings::AccelerationStructure));
+        // the path tracer shades hits in ray generation shaders (wavefront), the ray query integrator inline, all other integrators in the hit shaders.
+        const auto resourceStages = traceStages | vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR;
+        // the geometry arrays are sized with headroom, streamed in meshes then only rewrite the descriptors.
+        const auto [numGeometryBuffers, numTextures] = GetGeometryDescriptorCounts();
+        m_geometryBufferCapacity = DescriptorCapacity(numGeometryBuffers);
+        m_textureCapacity = DescriptorCapacity(numTextures);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::Vertices), vk::DescriptorType::eStorageBuffer, m_geometryBufferCapacity, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::Indices), vk::DescriptorType::eStorageBuffer, m_geometryBufferCapacity, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::InstanceInfos), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::Textures), vk::DescriptorType::eCombinedImageSampler, m_textureCapacity, resourceStages);
+
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::PhongBumpMaterialInfos), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::MirrorMaterialInfos), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::EmissiveMaterialInfos), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::LightTriangles), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::LightAliasTable), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::SamplerTables), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        m_rtResourcesDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ResBindings::TriangleOpacity), vk::DescriptorType::eStorageBuffer, 1, resourceStages);
+        // the hit shaders read the camera parameters too (alpha testing, texture LOD selection).
+        UniformBufferObject::AddDescriptorLayoutBinding(m_rtResourcesDescriptorSetLayout, resourceStages, true, static_cast<uint32_t>(ResBindings::CameraProperties));
+
+        Texture::AddDescriptorLayoutBinding(m_convergenceImageDescriptorSetLayout, vk::DescriptorType::eStorageImage, traceStages, static_cast<uint32_t>(ConvBindings::ResultImage));
+        m_convergenceImageDescriptorSetLayout.AddBinding(static_cast<uint32_t>(ConvBindings::AdaptiveSampling), vk::DescriptorType::eStorageBuffer, 1, traceStages);
+        Texture::AddDescriptorLayoutBinding(m_convergenceImageDescriptorSetLayout, vk::DescriptorType::eStorageImage, traceStages, static_cast<uint32_t>(ConvBindings::GBufferImage));
+        Texture::AddDescriptorLayoutBinding(m_convergenceImageDescriptorSetLayout, vk::DescriptorType::eStorageImage, traceStages, static_cast<uint32_t>(ConvBindings::HistoryImage));
+        Texture::AddDescriptorLayoutBinding(m_convergenceImageDescriptorSetLayout, vk::DescriptorType::eStorageImage, traceStages, static_cast<uint32_t>(ConvBindings::HistoryGBufferImage));
         Texture::AddDescriptorLayoutBinding(m_accumulatedResultImageDescriptorSetLayout, vk::DescriptorType::eCombinedImageSampler, vk::ShaderStageFlagBits::eFragment, static_cast<uint32_t>(CompositeConvSetBindings::AccumulatedImage));
+        Texture::AddDescriptorLayoutBinding(m_accumulatedResultImageDescriptorSetLayout, vk::DescriptorType::eCombinedImageSampler, vk::ShaderStageFlagBits::eFragment, static_cast<uint32_t>(CompositeConvSetBindings::GuideImage));
 
         auto rtResourcesDescSetLayout = m_rtResourcesDescriptorSetLayout.CreateDescriptorLayout(GetDevice());
         auto convergenceDescSetLayout = m_convergenceImageDescriptorSetLayout.CreateDescriptorLayout(GetDevice());
@@ -209,9 +463,14 @@ namespace vkfw_app::scene::rt {
         }
 
         {
-            std::array<vk::DescriptorSetLayout, 2> descSetLayouts;
+            std::vector<vk::DescriptorSetLayout> descSetLayouts(static_cast<std::size_t>(BindingSets::ConvergenceSet) + 1);
             descSetLayouts[static_cast<std::size_t>(BindingSets::RTResourcesSet)] = rtResourcesDescSetLayout;
             descSetLayouts[static_cast<std::size_t>(BindingSets::ConvergenceSet)] = convergenceDescSetLayout;
+            // the integrator set is owned by the integrator itself.
+            if (auto integratorDescSetLayout = m_integrator->GetIntegratorDescriptorSetLayout(); integratorDescSetLayout) {
+                descSetLayouts.resize(static_cast<std::size_t>(BindingSets::IntegratorSet) + 1);
+                descSetLayouts[static_cast<std::size_t>(BindingSets::IntegratorSet)] = integratorDescSetLayout;
+            }
 
             vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo{vk::PipelineLayoutCreateFlags{}, descSetLayouts};
             m_rtPipelineLayout.SetHandle(GetDevice()->GetHandle(), GetDevice()->GetHandle().createPipelineLayoutUnique(pipelineLayoutCreateInfo));
@@ -225,35 +484,100 @@ namespace vkfw_app::scene::rt {
         }
     }
 
-    void RaytracingScene::CreatePipeline(const glm::uvec2& screenSize, vkfw_core::VKWindow* window)
+    void RaytracingScene::CreatePipeline(const glm::uvec2& screenSize, RenderTarget* target)
     {
-        InitializeStorageImage(screenSize, window);
+        const bool integratorChanged = m_requestedIntegratorType != m_integratorType;
+        if (integratorChanged || m_requestedCompactVertices != m_compactVertices) {
+            bool rebuild = m_requestedCompactVertices != m_compactVertices;
+            m_compactVertices = m_requestedCompactVertices;
+            m_cameraProperties.compactVertices = m_compactVertices ? 1 : 0;
+            if (integratorChanged) {
+                auto oldSBTMapping = m_integrator->GetMaterialSBTMapping();
+                CreateIntegrator();
+                // the shader binding table offsets are stored in the instances.
+                rebuild = rebuild || oldSBTMapping != m_integrator->GetMaterialSBTMapping();
+            }
+            if (rebuild) { BuildAccelerationStructure(); }
+            InitializeDescriptorSets();
+        }
+
+        m_screenSize = screenSize;
+        // the integrators and the denoiser only see the traced resolution, compositing reconstructs the screen size.
+        float renderScale = 1.0f;
+        if (m_renderScale == RenderScale::TwoThirds) { renderScale = 2.0f / 3.0f; }
+        if (m_renderScale == RenderScale::Half) { renderScale = 0.5f; }
+        m_traceSize = glm::max(glm::uvec2{glm::round(glm::vec2{screenSize} * renderScale)}, glm::uvec2{1});
+
+        InitializeStorageImage(m_traceSize, target);
+        m_denoiser->SetPipelineCache(GetPipelineCache());
+        m_integrator->SetPipelineCache(GetPipelineCache());
+        if (m_denoiseIterations > 0) {
+            m_denoiser->SetMonochrome(m_integratorType == IntegratorType::AmbientOcclusion || m_integratorType == IntegratorType::AmbientOcclusionRayQuery);
+            m_denoiser->InitializeResources(m_traceSize, m_rayTracingConvergenceImages, m_gBufferImages);
+        }
         FillDescriptorSets();
 
-        m_integrator->InitializePipeline(m_rtPipelineLayout);
+        m_integrator->InitializeResources(m_traceSize, target->GetNumberOfFramebuffers());
+        // no pipeline depends on the screen size, they are only created for new layouts.
+        if (!m_integratorPipelineValid) {
+            m_integrator->InitializePipeline(m_rtPipelineLayout);
+            m_integratorPipelineValid = true;
+        }
         m_integrator->InitializeMisc(m_cameraUBO, m_rtResourcesDescriptorSet, m_convergenceImageDescriptorSets);
 
-        m_compositingFullscreenQuad.CreatePipeline(GetDevice(), screenSize, window->GetRenderPass(), 0, m_compositingPipelineLayout);
+        // viewport and scissor are dynamic, only a new composite shader (integrator), render pass or layout needs a new pipeline.
+        m_compositingPipeline.CreatePipeline(m_integrator->GetCompositeShaderName(), target->GetRenderPass(), 0, m_compositingPipelineLayout, GetPipelineCache());
     }
 
-    void RaytracingScene::InitializeStorageImage(const glm::uvec2& screenSize, const vkfw_core::VKWindow* window)
+    void RaytracingScene::InitializeStorageImage(const glm::uvec2& screenSize, const RenderTarget* target)
     {
         vkfw_core::gfx::TextureDescriptor storageTexDesc{16, vk::Format::eR32G32B32A32Sfloat, vk::SampleCountFlagBits::e1};
         storageTexDesc.m_imageTiling = vk::ImageTiling::eOptimal;
-        storageTexDesc.m_imageUsage = vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
+        storageTexDesc.m_imageUsage = vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
         storageTexDesc.m_memoryProperties = vk::MemoryPropertyFlagBits::eDeviceLocal;
 
         {
             auto cmdBuffer = vkfw_core::gfx::CommandBuffer::beginSingleTimeSubmit(GetDevice(), "TransferConvImageLayoutsInitialCommandBuffer", "TransferConvImageLayoutsInitial", GetDevice()->GetCommandPool(GRAPHICS_QUEUE));
+            vkfw_core::gfx::PipelineBarrier clearBarrier{GetDevice()};
             vkfw_core::gfx::PipelineBarrier barrier{GetDevice()};
 
-            for (std::size_t i = 0; i < window->GetFramebuffers().size(); ++i) {
+            m_rayTracingConvergenceImages.clear();
+            m_gBufferImages.clear();
+            for (std::size_t i = 0; i < target->GetNumberOfFramebuffers(); ++i) {
                 auto& image = m_rayTracingConvergenceImages.emplace_back(GetDevice(), fmt::format("RTSceneConvergenceImage-{}", i), storageTexDesc, vk::ImageLayout::eUndefined);
                 image.InitializeImage(glm::u32vec4{screenSize, 1, 1}, 1);
+                auto& gBufferImage = m_gBufferImages.emplace_back(GetDevice(), fmt::format("RTSceneGBufferImage-{}", i), storageTexDesc, vk::ImageLayout::eUndefined);
+                gBufferImage.InitializeImage(glm::u32vec4{screenSize, 1, 1}, 1);
+                image.AccessBarrier(vk::AccessFlagBits2KHR::eTransferWrite, vk::PipelineStageFlagBits2KHR::eTransfer, vk::ImageLayout::eTransferDstOptimal, clearBarrier);
+                gBufferImage.AccessBarrier(vk::AccessFlagBits2KHR::eTransferWrite, vk::PipelineStageFlagBits2KHR::eTransfer, vk::ImageLayout::eTransferDstOptimal, clearBarrier);
             }
+
+            // the first frame after a resize reads the history of the previous frame, an empty G-buffer rejects any reprojection.
+            clearBarrier.Record(cmdBuffer);
+            vk::ClearColorValue clearColor{std::array<float, 4>{0.0f, 0.0f, 0.0f, 0.0f}};
+            vk::ImageSubresourceRange clearRange{vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+            for (std::size_t i = 0; i < m_rayTracingConvergenceImages.size(); ++i) {
+                cmdBuffer.GetHandle().clearColorImage(m_rayTracingConvergenceImages[i].GetHandle(), vk::ImageLayout::eTransferDstOptimal, clearColor, clearRange);
+                cmdBuffer.GetHandle().clearColorImage(m_gBufferImages[i].GetHandle(), vk::ImageLayout::eTransferDstOptimal, clearColor, clearRange);
+            }
+
             for (auto& image : m_rayTracingConvergenceImages) {
                 image.AccessBarrier(vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eFragmentShader, vk::ImageLayout::eShaderReadOnlyOptimal, barrier);
             }
+            for (auto& image : m_gBufferImages) {
+                image.AccessBarrier(vk::AccessFlagBits2KHR::eShaderWrite, vk::PipelineStageFlagBits2KHR::eRayTracingShader, vk::ImageLayout::eGeneral, barrier);
+            }
+
+            // one set of adaptive sampling counters per convergence image, starting with no active pixels.
+            m_adaptiveSamplingStatsSize = GetDevice()->CalculateStorageBufferAlignment(sizeof(AdaptiveSamplingStats));
+            m_adaptiveSamplingMemGroup = std::make_unique<vkfw_core::gfx::MemoryGroup>(GetDevice(), "RTSceneAdaptiveSamplingMemoryGroup", vk::MemoryPropertyFlags());
+            m_adaptiveSamplingBufferIdx = m_adaptiveSamplingMemGroup->AddBufferToGroup(
+                "RTSceneAdaptiveSamplingBuffer", vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
+                m_adaptiveSamplingStatsSize * target->GetNumberOfFramebuffers(), std::vector<std::uint32_t>{{0, 1}});
+            m_adaptiveSamplingMemGroup->FinalizeDeviceGroup();
+            auto adaptiveSamplingBuffer = m_adaptiveSamplingMemGroup->GetBuffer(m_adaptiveSamplingBufferIdx);
+            cmdBuffer.GetHandle().fillBuffer(adaptiveSamplingBuffer->GetHandle(), 0, VK_WHOLE_SIZE, 0);
+            adaptiveSamplingBuffer->AccessBarrier(vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite, vk::PipelineStageFlagBits2KHR::eRayTracingShader, barrier);
 
             barrier.Record(cmdBuffer);
             auto fence = vkfw_core::gfx::CommandBuffer::endSingleTimeSubmit(GetDevice()->GetQueue(GRAPHICS_QUEUE, 0), cmdBuffer, {}, {});
@@ -276,25 +600,51 @@ namespace vkfw_app::scene::rt {
         std::array<vkfw_core::gfx::BufferRange, 1> instanceBufferRange;
         std::array<vkfw_core::gfx::BufferRange, 1> phongBumpMaterialBufferRange;
         std::array<vkfw_core::gfx::BufferRange, 1> mirrorMaterialBufferRange;
+        std::array<vkfw_core::gfx::BufferRange, 1> emissiveMaterialBufferRange;
+        std::array<vkfw_core::gfx::BufferRange, 1> lightTrianglesBufferRange;
+        std::array<vkfw_core::gfx::BufferRange, 1> lightAliasTableBufferRange;
+        std::array<vkfw_core::gfx::BufferRange, 1> samplerTablesBufferRange;
+        std::array<vkfw_core::gfx::BufferRange, 1> triangleOpacityBufferRange;
         std::vector<vkfw_core::gfx::Texture*> textures;
 
         m_rtResourcesDescriptorSet.InitializeWrites(GetDevice(), m_rtResourcesDescriptorSetLayout);
 
-        accelerationStructure[0] = &m_asGeometry;
+        accelerationStructure[0] = m_asGeometry.get();
         m_rtResourcesDescriptorSet.WriteAccelerationStructureDescriptor(static_cast<uint32_t>(ResBindings::AccelerationStructure), 0, accelerationStructure);
 
         m_cameraUBO.FillBufferRange(cameraBufferRange[0]);
         m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::CameraProperties), 0, cameraBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
 
-        m_asGeometry.FillGeometryInfo(vboBufferRanges, iboBufferRanges, instanceBufferRange[0]);
-        m_asGeometry.FillMaterialInfo<vkfw_app::gfx::MirrorMaterialInfo>(mirrorMaterialBufferRange[0]);
-        m_asGeometry.FillMaterialInfo<vkfw_core::gfx::PhongBumpMaterialInfo>(phongBumpMaterialBufferRange[0]);
-        m_asGeometry.FillTextureInfo(textures);
+        m_asGeometry->FillGeometryInfo(vboBufferRanges, iboBufferRanges, instanceBufferRange[0]);
+        m_asGeometry->FillMaterialInfo<vkfw_app::gfx::MirrorMaterialInfo>(mirrorMaterialBufferRange[0]);
+        m_asGeometry->FillMaterialInfo<vkfw_core::gfx::PhongBumpMaterialInfo>(phongBumpMaterialBufferRange[0]);
+        m_asGeometry->FillMaterialInfo<vkfw_app::gfx::EmissiveMaterialInfo>(emissiveMaterialBufferRange[0]);
+        lightTrianglesBufferRange[0].m_buffer = m_lightMemGroup->GetBuffer(m_lightTrianglesBufferIdx);
+        lightTrianglesBufferRange[0].m_offset = 0;
+        lightTrianglesBufferRange[0].m_range = VK_WHOLE_SIZE;
+        lightAliasTableBufferRange[0].m_buffer = m_lightMemGroup->GetBuffer(m_lightAliasTableBufferIdx);
+        lightAliasTableBufferRange[0].m_offset = 0;
+        lightAliasTableBufferRange[0].m_range = VK_WHOLE_SIZE;
+        samplerTablesBufferRange[0].m_buffer = m_memGroup.GetBuffer(m_samplerTablesBufferIdx);
+        samplerTablesBufferRange[0].m_offset = 0;
+        samplerTablesBufferRange[0].m_range = VK_WHOLE_SIZE;
+        triangleOpacityBufferRange[0].m_buffer = m_opacityMemGroup->GetBuffer(m_triangleOpacityBufferIdx);
+        triangleOpacityBufferRange[0].m_offset = 0;
+        triangleOpacityBufferRange[0].m_range = VK_WHOLE_SIZE;
+        m_asGeometry->FillTextureInfo(textures);
+        PadDescriptors(vboBufferRanges, m_geometryBufferCapacity);
+        PadDescriptors(iboBufferRanges, m_geometryBufferCapacity);
+        PadDescriptors(textures, m_textureCapacity);
         m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::Vertices), 0, vboBufferRanges, vk::AccessFlagBits2KHR::eShaderRead);
         m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::Indices), 0, iboBufferRanges, vk::AccessFlagBits2KHR::eShaderRead);
         m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::InstanceInfos), 0, instanceBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
         m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::PhongBumpMaterialInfos), 0, phongBumpMaterialBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
         m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::MirrorMaterialInfos), 0, mirrorMaterialBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
+        m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::EmissiveMaterialInfos), 0, emissiveMaterialBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
+        m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::LightTriangles), 0, lightTrianglesBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
+        m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::LightAliasTable), 0, lightAliasTableBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
+        m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::SamplerTables), 0, samplerTablesBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
+        m_rtResourcesDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(ResBindings::TriangleOpacity), 0, triangleOpacityBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
         m_rtResourcesDescriptorSet.WriteImageDescriptor(static_cast<uint32_t>(ResBindings::Textures), 0, textures, m_sampler, vk::AccessFlagBits2KHR::eShaderRead, vk::ImageLayout::eShaderReadOnlyOptimal);
 
         m_rtResourcesDescriptorSet.FinalizeWrite(GetDevice());
@@ -305,41 +655,117 @@ namespace vkfw_app::scene::rt {
             m_convergenceImageDescriptorSets[i].WriteImageDescriptor(static_cast<uint32_t>(ConvBindings::ResultImage), 0, convergenceImage, vkfw_core::gfx::Sampler{},
                                                                      vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite,
                                                                      vk::ImageLayout::eGeneral);
+            std::array<vkfw_core::gfx::BufferRange, 1> adaptiveSamplingRange;
+            adaptiveSamplingRange[0].m_buffer = m_adaptiveSamplingMemGroup->GetBuffer(m_adaptiveSamplingBufferIdx);
+            adaptiveSamplingRange[0].m_offset = i * m_adaptiveSamplingStatsSize;
+            adaptiveSamplingRange[0].m_range = sizeof(AdaptiveSamplingStats);
+            m_convergenceImageDescriptorSets[i].WriteBufferDescriptor(static_cast<uint32_t>(ConvBindings::AdaptiveSampling), 0, adaptiveSamplingRange,
+                                                                      vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite);
+            std::array<vkfw_core::gfx::Texture*, 1> gBufferImage = {&m_gBufferImages[i]};
+            m_convergenceImageDescriptorSets[i].WriteImageDescriptor(static_cast<uint32_t>(ConvBindings::GBufferImage), 0, gBufferImage, vkfw_core::gfx::Sampler{},
+                                                                     vk::AccessFlagBits2KHR::eShaderWrite, vk::ImageLayout::eGeneral);
+            // the frames cycle through the convergence images, the previous frame was rendered to the previous one.
+            auto historyIndex = (i + m_convergenceImageDescriptorSets.size() - 1) % m_convergenceImageDescriptorSets.size();
+            std::array<vkfw_core::gfx::Texture*, 1> historyImage = {&m_rayTracingConvergenceImages[historyIndex]};
+            m_convergenceImageDescriptorSets[i].WriteImageDescriptor(static_cast<uint32_t>(ConvBindings::HistoryImage), 0, historyImage, vkfw_core::gfx::Sampler{},
+                                                                     vk::AccessFlagBits2KHR::eShaderRead, vk::ImageLayout::eGeneral);
+            std::array<vkfw_core::gfx::Texture*, 1> historyGBufferImage = {&m_gBufferImages[historyIndex]};
+            m_convergenceImageDescriptorSets[i].WriteImageDescriptor(static_cast<uint32_t>(ConvBindings::HistoryGBufferImage), 0, historyGBufferImage, vkfw_core::gfx::Sampler{},
+                                                                     vk::AccessFlagBits2KHR::eShaderRead, vk::ImageLayout::eGeneral);
             m_convergenceImageDescriptorSets[i].FinalizeWrite(GetDevice());
 
             m_accumulatedResultImageDescriptorSets[i].InitializeWrites(GetDevice(), m_accumulatedResultImageDescriptorSetLayout);
+            // the denoised image has the format of a convergence image holding a single sample.
             std::array<vkfw_core::gfx::Texture*, 1> accumulatedResultImage = {&m_rayTracingConvergenceImages[i]};
+            if (m_denoiseIterations > 0) { accumulatedResultImage[0] = &m_denoiser->GetResultImage(i); }
             m_accumulatedResultImageDescriptorSets[i].WriteImageDescriptor(static_cast<uint32_t>(CompositeConvSetBindings::AccumulatedImage), 0, accumulatedResultImage, m_accumulatedResultSampler,
                                                                      vk::AccessFlagBits2KHR::eShaderRead, vk::ImageLayout::eShaderReadOnlyOptimal);
+            m_accumulatedResultImageDescriptorSets[i].WriteImageDescriptor(static_cast<uint32_t>(CompositeConvSetBindings::GuideImage), 0, gBufferImage, m_accumulatedResultSampler,
+                                                                     vk::AccessFlagBits2KHR::eShaderRead, vk::ImageLayout::eShaderReadOnlyOptimal);
             m_accumulatedResultImageDescriptorSets[i].FinalizeWrite(GetDevice());
         }
     }
 
-    void RaytracingScene::RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, vkfw_core::VKWindow* window)
+    void RaytracingScene::RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, RenderTarget* target)
     {
-        m_integrator->TraceRays(cmdBuffer, cmdBufferIndex, m_rayTracingConvergenceImages[cmdBufferIndex].GetPixelSize());
+        RecordAdaptiveSamplingCounterReset(cmdBuffer, cmdBufferIndex);
+        {
+            const auto traceRegion = GPURegion(cmdBuffer, cmdBufferIndex, "TraceRays");
+            m_integrator->TraceRays(cmdBuffer, cmdBufferIndex, m_rayTracingConvergenceImages[cmdBufferIndex].GetPixelSize());
+        }
+        if (m_denoiseIterations > 0) {
+            const auto denoiseRegion = GPURegion(cmdBuffer, cmdBufferIndex, "Denoise");
+            m_denoiser->RecordDenoise(cmdBuffer, cmdBufferIndex);
+        }
 
+        const auto renderPassRegion = GPURegion(cmdBuffer, cmdBufferIndex, "RenderPass");
         m_accumulatedResultImageDescriptorSets[cmdBufferIndex].BindBarrier(cmdBuffer);
-        window->BeginSwapchainRenderPass(cmdBufferIndex, {}, {});
-        m_accumulatedResultImageDescriptorSets[cmdBufferIndex].Bind(cmdBuffer, vk::PipelineBindPoint::eGraphics, m_compositingPipelineLayout, 0);
-        m_compositingFullscreenQuad.Render(cmdBuffer);
-        window->EndSwapchainRenderPass(cmdBufferIndex);
+        target->BeginRenderPass(cmdBufferIndex, {}, {});
+        {
+            const auto compositeRegion = GPURegion(cmdBuffer, cmdBufferIndex, "Composite");
+            m_accumulatedResultImageDescriptorSets[cmdBufferIndex].Bind(cmdBuffer, vk::PipelineBindPoint::eGraphics, m_compositingPipelineLayout, 0);
+            m_compositingPipeline.Render(cmdBuffer, m_screenSize);
+        }
+        target->EndRenderPass(cmdBufferIndex);
     }
 
-    void RaytracingScene::FrameMove(float, float, bool cameraChanged, const vkfw_core::VKWindow* window)
+    void RaytracingScene::RecordAdaptiveSamplingCounterReset(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex)
     {
-        static bool firstFrame = true;
+        // the active pixels of the last frame become the budget base of this one, the new count starts at zero.
+        auto buffer = m_adaptiveSamplingMemGroup->GetBuffer(m_adaptiveSamplingBufferIdx);
+        auto offset = cmdBufferIndex * m_adaptiveSamplingStatsSize;
+        {
+            vkfw_core::gfx::PipelineBarrier barrier{GetDevice()};
+            buffer->AccessBarrierRange(false, offset, sizeof(AdaptiveSamplingStats), vk::AccessFlagBits2KHR::eTransferRead | vk::AccessFlagBits2KHR::eTransferWrite,
+                                       vk::PipelineStageFlagBits2KHR::eTransfer, barrier);
+            barrier.Record(cmdBuffer);
+        }
+        vk::BufferCopy copyRegion{offset + offsetof(AdaptiveSamplingStats, activePixels), offset + offsetof(AdaptiveSamplingStats, lastActivePixels), sizeof(std::uint32_t)};
+        cmdBuffer.GetHandle().copyBuffer(buffer->GetHandle(), buffer->GetHandle(), copyRegion);
+        cmdBuffer.GetHandle().fillBuffer(buffer->GetHandle(), offset + offsetof(AdaptiveSamplingStats, activePixels), sizeof(std::uint32_t), 0);
+        {
+            vkfw_core::gfx::PipelineBarrier barrier{GetDevice()};
+            buffer->AccessBarrierRange(false, offset, sizeof(AdaptiveSamplingStats), vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite,
+                                       vk::PipelineStageFlagBits2KHR::eRayTracingShader, barrier);
+            barrier.Record(cmdBuffer);
+        }
+    }
+
+    void RaytracingScene::FrameMove(float, float, bool cameraChanged, const RenderTarget* target)
+    {
+        TIMELINE_SCOPE("RaytracingScene::FrameMove");
         m_cameraProperties.viewInverse = glm::inverse(GetCamera()->GetViewMatrix());
         m_cameraProperties.projInverse = glm::inverse(GetCamera()->GetProjMatrix());
+        m_cameraProperties.prevViewProj = m_lastViewProj;
+        m_cameraProperties.prevCameraPosition = m_lastCameraPosition;
+        m_lastViewProj = GetCamera()->GetProjMatrix() * GetCamera()->GetViewMatrix();
+        m_lastCameraPosition = m_cameraProperties.viewInverse[3];
+        // spread angle of a pixel: atan(2 tan(fovY / 2) / height), tan(fovY / 2) is 1 / proj[1][1].
+        m_cameraProperties.pixelSpreadAngle = std::atan(2.0f / (std::abs(GetCamera()->GetProjMatrix()[1][1]) * static_cast<float>(std::max(m_traceSize.y, 1u))));
 
-        auto uboIndex = window->GetCurrentlyRenderedImageIndex();
+        auto uboIndex = target->GetCurrentlyRenderedImageIndex();
 
         if (m_lastMoveFrame == uboIndex) {
             m_lastMoveFrame = static_cast<std::size_t>(-1);
             m_cameraProperties.cameraMovedThisFrame = 0;
         }
 
-        if (window->GetCurrentlyRenderedImageIndex() == 0) { m_cameraProperties.frameId += 1; }
+        // every frame draws new samples, the AO integrator continues the accumulation of the previous frame.
+        m_cameraProperties.frameId += 1;
+        // the halves alternate per convergence image, so the path tracers accumulating in place cover all pixels.
+        m_cameraProperties.checkerboard = 0;
+        if (m_renderScale == RenderScale::Checkerboard) {
+            m_cameraProperties.checkerboard = 1 + m_checkerboardPhases[uboIndex];
+            m_checkerboardPhases[uboIndex] = 1 - m_checkerboardPhases[uboIndex];
+        }
+
+        if (m_guiChanged || (cameraChanged && !m_temporalReprojection)) {
+            m_cameraProperties.historyMode = static_cast<std::uint32_t>(HistoryMode::HistoryReset);
+        } else if (cameraChanged) {
+            m_cameraProperties.historyMode = static_cast<std::uint32_t>(HistoryMode::HistoryReproject);
+        } else {
+            m_cameraProperties.historyMode = static_cast<std::uint32_t>(HistoryMode::HistoryStatic);
+        }
 
         if (cameraChanged || m_guiChanged) {
             m_cameraProperties.cameraMovedThisFrame = 1;
@@ -352,41 +778,206 @@ namespace vkfw_app::scene::rt {
         const auto& transferQueue = GetDevice()->GetQueue(TRANSFER_QUEUE, 0);
         {
             QUEUE_REGION(transferQueue, "FrameMove");
-            std::array<vk::SemaphoreSubmitInfoKHR, 1> signalSemaphore = {vk::SemaphoreSubmitInfoKHR{window->GetDataAvailableSemaphore().GetHandle(), 0, vk::PipelineStageFlagBits2KHR::eTopOfPipe}};
+            std::array<vk::SemaphoreSubmitInfoKHR, 1> signalSemaphore = {vk::SemaphoreSubmitInfoKHR{target->GetDataAvailableSemaphore(), 0, vk::PipelineStageFlagBits2KHR::eTopOfPipe}};
             // dont wait on first frame
-            if (firstFrame) {
+            if (m_firstFrame) {
                 m_transferCommandBuffers[uboIndex].SubmitToQueue(transferQueue, std::span<vk::SemaphoreSubmitInfoKHR>{}, signalSemaphore);
-                firstFrame = false;
+                m_firstFrame = false;
             } else {
-                std::array<vk::SemaphoreSubmitInfoKHR, 1> waitSemaphore = {vk::SemaphoreSubmitInfoKHR{window->GetRenderingFinishedSemaphore().GetHandle(), 0, vk::PipelineStageFlagBits2KHR::eTransfer}};
+                std::array<vk::SemaphoreSubmitInfoKHR, 1> waitSemaphore = {vk::SemaphoreSubmitInfoKHR{target->GetRenderingFinishedSemaphore(), 0, vk::PipelineStageFlagBits2KHR::eTransfer}};
                 m_transferCommandBuffers[uboIndex].SubmitToQueue(transferQueue, waitSemaphore, signalSemaphore);
             }
 
         }
     }
 
-    void RaytracingScene::RenderScene(const vkfw_core::VKWindow*) {}
+    void RaytracingScene::RenderScene(const RenderTarget*) {}
+
+    SceneChange RaytracingScene::UpdateStreamedResources()
+    {
+        TIMELINE_SCOPE("RaytracingScene::UpdateStreamedResources");
+        // the classification finishes after the import.
+        auto isReady = [](const SceneMesh& sceneMesh) {
+            return sceneMesh.m_state == MeshState::Loading && sceneMesh.m_opacity.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+        };
+        auto numReady = std::count_if(m_sceneMeshes.begin(), m_sceneMeshes.end(), isReady);
+        if (numReady == 0) { return SceneChange::None; }
+        // all meshes that finished since the last rebuild are added in one batch, at most one rebuild per interval while others are still loading.
+        auto numLoading = std::count_if(m_sceneMeshes.begin(), m_sceneMeshes.end(), [](const SceneMesh& sceneMesh) { return sceneMesh.m_state == MeshState::Loading; });
+        if (numReady < numLoading && std::chrono::steady_clock::now() - m_lastStreamingRebuild < STREAMING_REBUILD_INTERVAL) { return SceneChange::None; }
+
+        bool meshesAdded = false;
+        for (auto& sceneMesh : m_sceneMeshes) {
+            if (!isReady(sceneMesh)) { continue; }
+            try {
+                sceneMesh.m_mesh.get();
+                sceneMesh.m_opacity.get();
+                sceneMesh.m_state = MeshState::Added;
+                meshesAdded = true;
+            } catch (const std::exception& e) {
+                spdlog::error("Could not import mesh: {}", e.what());
+                sceneMesh.m_state = MeshState::Failed;
+            }
+        }
+        if (!meshesAdded) { return SceneChange::None; }
+
+        // the old acceleration structure and descriptor sets may still be in use.
+        GetDevice()->GetHandle().waitIdle();
+        BuildAccelerationStructure();
+        m_lastStreamingRebuild = std::chrono::steady_clock::now();
+        // restart accumulation with the new geometry.
+        m_guiChanged = true;
+
+        const auto [numGeometryBuffers, numTextures] = GetGeometryDescriptorCounts();
+        if (numGeometryBuffers > m_geometryBufferCapacity || numTextures > m_textureCapacity) {
+            // new layouts need new pipelines.
+            InitializeDescriptorSets();
+            return SceneChange::Resize;
+        }
+        // the descriptor sets are filled by CreatePipeline if it did not run yet, otherwise only the command buffers referencing them are re-recorded.
+        if (!m_rayTracingConvergenceImages.empty()) { FillDescriptorSets(); }
+        return SceneChange::CommandStream;
+    }
+
+    void RaytracingScene::SetRayConeTextureLod(bool enabled)
+    {
+        m_cameraProperties.rayConeLod = enabled ? 1 : 0;
+        m_guiChanged = true;
+    }
+
+    void RaytracingScene::SetAdaptiveSampling(bool enabled)
+    {
+        m_cameraProperties.adaptiveSampling = enabled ? 1 : 0;
+        m_guiChanged = true;
+    }
 
-    bool RaytracingScene::RenderGUI([[maybe_unused]] const vkfw_core::VKWindow* window)
+    void RaytracingScene::SetLightSampling(bool enabled)
     {
+        m_cameraProperties.lightSampling = enabled ? 1 : 0;
+        m_guiChanged = true;
+    }
+
+    void RaytracingScene::SetSamplerType(SamplerType samplerType)
+    {
+        m_cameraProperties.samplerType = static_cast<std::uint32_t>(samplerType);
+        m_guiChanged = true;
+    }
+
+    void RaytracingScene::SetDenoiseIterations(std::uint32_t iterations)
+    {
+        // the filter does not change the accumulation, no restart needed.
+        m_denoiseIterations = std::min(iterations, static_cast<std::uint32_t>(DenoiseParameters::MaxDenoiseIterations));
+        if (m_denoiseIterations > 0) { m_denoiser->SetIterations(m_denoiseIterations); }
+    }
+
+    void RaytracingScene::SetTemporalReprojection(bool enabled)
+    {
+        // only decides what happens on the next camera change.
+        m_temporalReprojection = enabled;
+    }
+
+    void RaytracingScene::SetRenderScale(RenderScale renderScale)
+    {
+        m_renderScale = renderScale;
+        m_guiChanged = true;
+    }
+
+    void RaytracingScene::SetIntegrator(IntegratorType integrator)
+    {
+        m_requestedIntegratorType = integrator;
+        m_guiChanged = true;
+    }
+
+    void RaytracingScene::SetCompactVertices(bool enabled)
+    {
+        m_requestedCompactVertices = enabled;
+        m_guiChanged = true;
+    }
+
+    std::uint64_t RaytracingScene::GetTracedRays(std::size_t cmdBufferIndex) const { return m_integrator->GetTracedRays(cmdBufferIndex); }
+
+    bool RaytracingScene::IsFullyLoaded() const
+    {
+        return std::none_of(m_sceneMeshes.begin(), m_sceneMeshes.end(), [](const SceneMesh& sceneMesh) { return sceneMesh.m_state == MeshState::Loading; });
+    }
+
+    SceneChange RaytracingScene::RenderGUI([[maybe_unused]] const vkfw_core::VKWindow* window)
+    {
+        auto change = SceneChange::None;
         ImGui::SetNextWindowPos(ImVec2(5, 100), ImGuiCond_Always);
-        ImGui::SetNextWindowSize(ImVec2(220, 190), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(220, 400), ImGuiCond_Always);
         if (ImGui::Begin("Scene Control")) {
 
+            std::array<const char*, 4> integratorNames = {"Ambient Occlusion", "Path Tracing", "Path Tracing (Wavefront)", "Ambient Occlusion (Ray Query)"};
+            int integrator = static_cast<int>(m_requestedIntegratorType);
+            if (ImGui::Combo("Integrator", &integrator, integratorNames.data(), static_cast<int>(integratorNames.size()))) {
+                // the integrator owns pipelines and descriptor sets, it is switched like after a resize.
+                SetIntegrator(static_cast<IntegratorType>(integrator));
+                change = std::max(change, SceneChange::Resize);
+            }
+
             bool cosSample = m_cameraProperties.cosineSampled == 1;
             if (ImGui::Checkbox("Samples Cosine Weigthed", &cosSample)) {
-                // add camera changed here.
+                // parameters only go to the camera UBO, the accumulation is restarted like after a camera change.
                 m_guiChanged = true;
+                change = std::max(change, SceneChange::Parameters);
             }
             m_cameraProperties.cosineSampled = cosSample ? 1 : 0;
             if (ImGui::SliderFloat("Max. Range", &m_cameraProperties.maxRange, 0.1f, 10000.0f)) {
-                // add camera changed here.
                 m_guiChanged = true;
+                change = std::max(change, SceneChange::Parameters);
+            }
+            bool rayConeLod = m_cameraProperties.rayConeLod == 1;
+            if (ImGui::Checkbox("Ray Cone Texture LOD", &rayConeLod)) {
+                SetRayConeTextureLod(rayConeLod);
+                change = std::max(change, SceneChange::Parameters);
+            }
+            bool adaptiveSampling = m_cameraProperties.adaptiveSampling == 1;
+            if (ImGui::Checkbox("Adaptive Sampling", &adaptiveSampling)) {
+                SetAdaptiveSampling(adaptiveSampling);
+                change = std::max(change, SceneChange::Parameters);
+            }
+            if (ImGui::SliderFloat("Conv. Threshold", &m_cameraProperties.convergenceThreshold, 0.001f, 0.1f, "%.3f", ImGuiSliderFlags_Logarithmic)) {
+                m_guiChanged = true;
+                change = std::max(change, SceneChange::Parameters);
+            }
+            bool lightSampling = m_cameraProperties.lightSampling == 1;
+            if (ImGui::Checkbox("Light Sampling (NEE)", &lightSampling)) {
+                SetLightSampling(lightSampling);
+                change = std::max(change, SceneChange::Parameters);
+            }
+            std::array<const char*, 3> samplerNames = {"Random", "Sobol (Owen)", "Blue Noise"};
+            int samplerType = static_cast<int>(m_cameraProperties.samplerType);
+            if (ImGui::Combo("Sampler", &samplerType, samplerNames.data(), static_cast<int>(samplerNames.size()))) {
+                SetSamplerType(static_cast<SamplerType>(samplerType));
+                change = std::max(change, SceneChange::Parameters);
+            }
+            std::array<const char*, 4> renderScaleNames = {"100%", "67%", "50%", "Checkerboard"};
+            int renderScale = static_cast<int>(m_renderScale);
+            if (ImGui::Combo("Render Scale", &renderScale, renderScaleNames.data(), static_cast<int>(renderScaleNames.size()))) {
+                // the convergence images change their size (or pattern), they are recreated like after a resize.
+                SetRenderScale(static_cast<RenderScale>(renderScale));
+                change = std::max(change, SceneChange::Resize);
+            }
+            bool compactVertices = m_requestedCompactVertices;
+            if (ImGui::Checkbox("Compact Vertices", &compactVertices)) {
+                // the geometry is rebuilt in the other layout when the pipeline is recreated.
+                SetCompactVertices(compactVertices);
+                change = std::max(change, SceneChange::Resize);
+            }
+            bool temporalReprojection = m_temporalReprojection;
+            if (ImGui::Checkbox("Temporal Reprojection", &temporalReprojection)) { SetTemporalReprojection(temporalReprojection); }
+            int denoiseIterations = static_cast<int>(m_denoiseIterations);
+            if (ImGui::SliderInt("Denoise Iter.", &denoiseIterations, 0, static_cast<int>(DenoiseParameters::MaxDenoiseIterations))) {
+                // switching the denoiser on or off changes the composited image, otherwise only the recorded iterations change.
+                bool toggled = (denoiseIterations > 0) != (m_denoiseIterations > 0);
+                SetDenoiseIterations(static_cast<std::uint32_t>(denoiseIterations));
+                change = std::max(change, toggled ? SceneChange::Resize : SceneChange::CommandStream);
             }
         }
         ImGui::End();
 
-        return false;
+        return change;
     }
 
 }
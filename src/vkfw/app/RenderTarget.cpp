@@ -0,0 +1,36 @@
+/**
+ * @file   RenderTarget.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the window render target.
+ */
+
+#include "app/RenderTarget.h"
+
+#include <app/VKWindow.h>
+#include <gfx/vk/Framebuffer.h>
+#include <gfx/vk/wrappers/Semaphore.h>
+
+namespace vkfw_app {
+
+    glm::uvec2 WindowRenderTarget::GetSize() const { return m_window->GetFramebuffers()[0].GetSize(); }
+
+    std::size_t WindowRenderTarget::GetNumberOfFramebuffers() const { return m_window->GetFramebuffers().size(); }
+
+    std::size_t WindowRenderTarget::GetCurrentlyRenderedImageIndex() const { return m_window->GetCurrentlyRenderedImageIndex(); }
+
+    const vkfw_core::gfx::RenderPass& WindowRenderTarget::GetRenderPass() const { return m_window->GetRenderPass(); }
+
+    vk::Semaphore WindowRenderTarget::GetDataAvailableSemaphore() const { return m_window->GetDataAvailableSemaphore().GetHandle(); }
+
+    vk::Semaphore WindowRenderTarget::GetRenderingFinishedSemaphore() const { return m_window->GetRenderingFinishedSemaphore().GetHandle(); }
+
+    void WindowRenderTarget::BeginRenderPass(std::size_t cmdBufferIndex, std::span<vkfw_core::gfx::DescriptorSet*> descriptorSets,
+                                             std::span<vkfw_core::gfx::VertexInputResources*> vertexInputs)
+    {
+        m_window->BeginSwapchainRenderPass(cmdBufferIndex, descriptorSets, vertexInputs);
+    }
+
+    void WindowRenderTarget::EndRenderPass(std::size_t cmdBufferIndex) { m_window->EndSwapchainRenderPass(cmdBufferIndex); }
+}
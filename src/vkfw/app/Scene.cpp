@@ -11,15 +11,21 @@
 
 namespace vkfw_app::scene {
 
-    Scene::Scene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera,
-                 std::size_t t_num_framebuffers)
-        : m_device{t_device}, m_camera{t_camera}, m_num_framebuffers{t_num_framebuffers}
+    Scene::Scene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera, MeshCache* t_meshCache,
+                 TextureCache* t_textureCache, std::size_t t_num_framebuffers)
+        : m_device{t_device}, m_camera{t_camera}, m_meshCache{t_meshCache}, m_textureCache{t_textureCache}, m_num_framebuffers{t_num_framebuffers}
     {}
 
-    bool Scene::RenderGUI(const vkfw_core::VKWindow*)
+    MeshCache::MeshFuture Scene::RequestMesh(const std::string& meshFilename)
+    {
+        m_meshFilenames.insert(meshFilename);
+        return m_meshCache->RequestMesh(meshFilename);
+    }
+
+    SceneChange Scene::RenderGUI(const vkfw_core::VKWindow*)
     {
         static bool show_demo_window = true;
         ImGui::ShowDemoWindow(&show_demo_window);
-        return false;
+        return SceneChange::None;
     }
 }
@@ -7,23 +7,26 @@
  */
 
 #include "app/SimpleScene.h"
+#include "app/MeshCache.h"
+#include "app/TextureCache.h"
 
-#include <gfx/Texture2D.h>
 #include <gfx/camera/UserControlledCamera.h>
 #include <gfx/meshes/Mesh.h>
 #include <gfx/meshes/AssImpScene.h>
 #include <gfx/vk/QueuedDeviceTransfer.h>
 #include <gfx/vk/pipeline/GraphicsPipeline.h>
+#include <gfx/vk/wrappers/RenderPass.h>
 #include <app/VKWindow.h>
 #include <gfx/renderer/RenderList.h>
+#include "core/Timeline.h"
 
 #include <glm/gtc/matrix_inverse.hpp>
 
 namespace vkfw_app::scene::simple {
 
-    SimpleScene::SimpleScene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera,
-                             std::size_t t_num_framebuffers)
-        : Scene(t_device, t_camera, t_num_framebuffers)
+    SimpleScene::SimpleScene(vkfw_core::gfx::LogicalDevice* t_device, vkfw_core::gfx::UserControlledCamera* t_camera, MeshCache* t_meshCache,
+                             TextureCache* t_textureCache, std::size_t t_num_framebuffers)
+        : Scene(t_device, t_camera, t_meshCache, t_textureCache, t_num_framebuffers)
         , m_cameraMatrixDescriptorSetLayout{"SimpleSceneCameraDescriptorSetLayout"}
         , m_worldMatrixDescriptorSetLayout{"SimpleSceneWorldMatrixDescriptorSetLayout"}
         , m_imageSamplerDescriptorSetLayout{"SimpleSceneImageSamplerDescriptorSetLayout"}
@@ -53,18 +56,22 @@ namespace vkfw_app::scene::simple {
 
     SimpleScene::~SimpleScene() = default;
 
-    void SimpleScene::CreatePipeline(const glm::uvec2& screenSize, vkfw_core::VKWindow* window)
+    void SimpleScene::CreatePipeline(const glm::uvec2& screenSize, RenderTarget* target)
     {
-        // TODO: like this the shaders will be recompiled on each resize. [3/26/2017 Sebastian Maisch]
-        // maybe set viewport as dynamic...
-        m_demoPipeline = window->GetDevice().CreateGraphicsPipeline(
+        // viewport and scissor are dynamic state, so the pipelines are only created again for a new render pass.
+        if (m_demoPipeline && m_demoTransparentPipeline && m_pipelineRenderPass == target->GetRenderPass().GetHandle()) { return; }
+        m_pipelineRenderPass = target->GetRenderPass().GetHandle();
+
+        m_demoPipeline = GetDevice()->CreateGraphicsPipeline(
             std::vector<std::string>{"shader/mesh/mesh.vert", "shader/mesh/mesh.frag"}, screenSize, 1);
         m_demoPipeline->ResetVertexInput<mesh_sample::SimpleVertex>();
-        m_demoPipeline->CreatePipeline(true, window->GetRenderPass(), 0, m_pipelineLayout);
+        m_demoPipeline->GetDynamicStates() = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+        m_demoPipeline->CreatePipeline(true, target->GetRenderPass(), 0, m_pipelineLayout);
 
-        m_demoTransparentPipeline = window->GetDevice().CreateGraphicsPipeline(
+        m_demoTransparentPipeline = GetDevice()->CreateGraphicsPipeline(
             std::vector<std::string>{"shader/simple_transparent.vert", "shader/simple_transparent.frag"}, screenSize, 1);
         m_demoTransparentPipeline->ResetVertexInput<mesh_sample::SimpleVertex>();
+        m_demoTransparentPipeline->GetDynamicStates() = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
         m_demoTransparentPipeline->GetRasterizer().cullMode = vk::CullModeFlagBits::eNone;
         m_demoTransparentPipeline->GetColorBlendAttachment(0).blendEnable = VK_TRUE;
         m_demoTransparentPipeline->GetColorBlendAttachment(0).srcColorBlendFactor = vk::BlendFactor::eSrcAlpha;
@@ -74,10 +81,10 @@ namespace vkfw_app::scene::simple {
         m_demoTransparentPipeline->GetColorBlendAttachment(0).dstAlphaBlendFactor = vk::BlendFactor::eOneMinusSrcAlpha;
         m_demoTransparentPipeline->GetColorBlendAttachment(0).alphaBlendOp = vk::BlendOp::eAdd;
 
-        m_demoTransparentPipeline->CreatePipeline(true, window->GetRenderPass(), 0, m_pipelineLayout);
+        m_demoTransparentPipeline->CreatePipeline(true, target->GetRenderPass(), 0, m_pipelineLayout);
     }
 
-    void SimpleScene::RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, vkfw_core::VKWindow* window)
+    void SimpleScene::RenderScene(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, RenderTarget* target)
     {
         using UBOBinding = vkfw_core::gfx::RenderElement::UBOBinding;
         using DescSetBinding = vkfw_core::gfx::RenderElement::DescSetBinding;
@@ -97,15 +104,20 @@ namespace vkfw_app::scene::simple {
         std::vector<vkfw_core::gfx::VertexInputResources*> vertexInputs;
         renderList.AccessBarriers(descriptorSets, vertexInputs);
 
-        window->BeginSwapchainRenderPass(cmdBufferIndex, descriptorSets, vertexInputs);
+        const auto renderPassRegion = GPURegion(cmdBuffer, cmdBufferIndex, "RenderPass");
+        target->BeginRenderPass(cmdBufferIndex, descriptorSets, vertexInputs);
 
+        const auto size = target->GetSize();
+        cmdBuffer.GetHandle().setViewport(0, vk::Viewport{0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y), 0.0f, 1.0f});
+        cmdBuffer.GetHandle().setScissor(0, vk::Rect2D{vk::Offset2D{0, 0}, vk::Extent2D{size.x, size.y}});
         renderList.Render(cmdBuffer);
 
-        window->EndSwapchainRenderPass(cmdBufferIndex);
+        target->EndRenderPass(cmdBufferIndex);
     }
 
-    void SimpleScene::FrameMove(float time, float, bool, const vkfw_core::VKWindow* window)
+    void SimpleScene::FrameMove(float time, float, bool, const RenderTarget* target)
     {
+        TIMELINE_SCOPE("SimpleScene::FrameMove");
         mesh_sample::CameraUniformBufferObject camera_ubo;
         mesh::WorldUniformBufferObject world_ubo;
         world_ubo.model = glm::rotate(glm::mat4(1.0f), 0.3f * time * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
@@ -114,7 +126,7 @@ namespace vkfw_app::scene::simple {
         camera_ubo.view = GetCamera()->GetViewMatrix();
         camera_ubo.proj = GetCamera()->GetProjMatrix();
 
-        auto uboIndex = window->GetCurrentlyRenderedImageIndex();
+        auto uboIndex = target->GetCurrentlyRenderedImageIndex();
         m_cameraUBO.UpdateInstanceData(uboIndex, camera_ubo);
         m_worldUBO.UpdateInstanceData(uboIndex, world_ubo);
 
@@ -125,17 +137,20 @@ namespace vkfw_app::scene::simple {
         const auto& transferQueue = GetDevice()->GetQueue(TRANSFER_QUEUE, 0);
         {
             QUEUE_REGION(transferQueue, "FrameMove");
-            std::array<vk::SemaphoreSubmitInfoKHR, 1> transferSemaphore = {vk::SemaphoreSubmitInfoKHR{window->GetDataAvailableSemaphore().GetHandle(), 0, vk::PipelineStageFlagBits2KHR::eTopOfPipe}};
+            std::array<vk::SemaphoreSubmitInfoKHR, 1> transferSemaphore = {vk::SemaphoreSubmitInfoKHR{target->GetDataAvailableSemaphore(), 0, vk::PipelineStageFlagBits2KHR::eTopOfPipe}};
             m_transferCommandBuffers[uboIndex].SubmitToQueue(transferQueue, {}, transferSemaphore);
         }
     }
 
-    void SimpleScene::RenderScene(const vkfw_core::VKWindow*) {}
+    void SimpleScene::RenderScene(const RenderTarget*) {}
 
     void SimpleScene::InitializeScene()
     {
         // as long as the last transfer of texture layouts is done on this queue, we have to use the graphics queue here.
         vkfw_core::gfx::QueuedDeviceTransfer transfer{GetDevice(), GetDevice()->GetQueue(TRANSFER_QUEUE, 0)};
+        // start loading the texture and the mesh in parallel to setting up the buffers.
+        auto demoTexture = GetTextureCache()->RequestTexture("demo.jpg");
+        auto teapotMesh = RequestMesh("teapot/teapot.obj");
 
         auto numUBOBuffers = GetNumberOfFramebuffers();
 
@@ -169,15 +184,15 @@ namespace vkfw_app::scene::simple {
             m_worldUBO.AddUBOToBuffer(&m_memGroup, m_completeBufferIdx,
                                       uniformDataOffset + m_cameraUBO.GetCompleteSize(), initialWorldUBO);
 
-            m_demoTexture = GetDevice()->GetTextureManager()->GetResource("demo.jpg", true, true, m_memGroup,
-                                                                          std::vector<std::uint32_t>{{0, 1}});
+            m_demoTextureIdx = demoTexture.get()->AddToMemoryGroup(m_memGroup, "SimpleSceneDemoTexture", std::vector<std::uint32_t>{{0, 1}});
             vk::SamplerCreateInfo samplerCreateInfo{vk::SamplerCreateFlags(),
                                                     vk::Filter::eLinear,
                                                     vk::Filter::eLinear,
-                                                    vk::SamplerMipmapMode::eNearest,
+                                                    vk::SamplerMipmapMode::eLinear,
                                                     vk::SamplerAddressMode::eRepeat,
                                                     vk::SamplerAddressMode::eRepeat,
                                                     vk::SamplerAddressMode::eRepeat};
+            samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
             m_demoSampler.SetHandle(GetDevice()->GetHandle(), GetDevice()->GetHandle().createSamplerUnique(samplerCreateInfo));
 
             //////////////////////////////////////////////////////////////////////////
@@ -187,7 +202,7 @@ namespace vkfw_app::scene::simple {
             //////////////////////////////////////////////////////////////////////////
         }
 
-        m_meshInfo = std::make_shared<vkfw_core::gfx::AssImpScene>("teapot/teapot.obj", GetDevice());
+        m_meshInfo = teapotMesh.get();
         m_mesh = std::make_unique<vkfw_core::gfx::Mesh>(
             vkfw_core::gfx::Mesh::CreateWithInternalMemoryGroup<mesh_sample::SimpleVertex, SimpleMaterial>("SimpleSceneMesh", m_meshInfo, numUBOBuffers, GetDevice(), vk::MemoryPropertyFlags(), std::vector<std::uint32_t>{{0, 1}}));
         m_mesh->UploadMeshData(transfer);
@@ -221,7 +236,7 @@ namespace vkfw_app::scene::simple {
         {
             auto cmdBuffer = vkfw_core::gfx::CommandBuffer::beginSingleTimeSubmit(GetDevice(), "TransferImageLayoutsInitialCommandBuffer", "TransferImageLayoutsInitial", GetDevice()->GetCommandPool(GRAPHICS_QUEUE));
             vkfw_core::gfx::PipelineBarrier barrier{GetDevice()};
-            m_demoTexture->GetTexture().AccessBarrier(vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eFragmentShader, vk::ImageLayout::eShaderReadOnlyOptimal, barrier);
+            m_memGroup.GetTexture(m_demoTextureIdx)->AccessBarrier(vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eFragmentShader, vk::ImageLayout::eShaderReadOnlyOptimal, barrier);
             m_memGroup.GetBuffer(m_completeBufferIdx)->AccessBarrierRange(false, 0, staticBufferSize, vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eFragmentShader, barrier);
             // m_memGroup.GetBuffer(m_completeBufferIdx)->AccessBarrier(vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eFragmentShader, barrier);
             m_mesh->CreateBufferUseBarriers(vk::AccessFlagBits2KHR::eShaderRead, vk::PipelineStageFlagBits2KHR::eFragmentShader, barrier);
@@ -297,7 +312,7 @@ namespace vkfw_app::scene::simple {
             m_worldMatrixDescriptorSet.WriteBufferDescriptor(0, 0, worldUBOBufferRange, vk::AccessFlagBits2KHR::eShaderRead);
             m_worldMatrixDescriptorSet.FinalizeWrite(GetDevice());
 
-            std::array<vkfw_core::gfx::Texture*, 1> demoTextureArray = {&m_demoTexture->GetTexture()};
+            std::array<vkfw_core::gfx::Texture*, 1> demoTextureArray = {m_memGroup.GetTexture(m_demoTextureIdx)};
             m_imageSamplerDescriptorSet.InitializeWrites(GetDevice(), m_imageSamplerDescriptorSetLayout);
             m_imageSamplerDescriptorSet.WriteImageDescriptor(0, 0, demoTextureArray, m_demoSampler, vk::AccessFlagBits2KHR::eShaderRead, vk::ImageLayout::eShaderReadOnlyOptimal);
             m_imageSamplerDescriptorSet.FinalizeWrite(GetDevice());
@@ -0,0 +1,64 @@
+/**
+ * @file   StressScene.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the stress scene generator.
+ */
+
+#include "app/StressScene.h"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <random>
+
+namespace vkfw_app::scene::rt {
+
+    namespace {
+        /** The distance between instances in world units (teapot about 2.3 x 1.5, Sponza about 55 x 34 in the default scale). */
+        constexpr float TEAPOT_SPACING = 3.0f;
+        constexpr float SPONZA_SPACING = 60.0f;
+        constexpr float MIN_SCATTER_SCALE = 0.75f;
+        constexpr float MAX_SCATTER_SCALE = 1.25f;
+
+        /** Uniform float in [0, 1), std::mt19937 is specified exactly while the standard distributions are not. */
+        float NextFloat(std::mt19937& rng) { return static_cast<float>(rng() >> 8U) * (1.0f / 16777216.0f); }
+
+        void PlaceInstances(StressMesh mesh, std::size_t count, float spacing, StressLayout layout, std::mt19937& rng, std::vector<StressInstance>& instances)
+        {
+            if (count == 0) { return; }
+            const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+            const float extent = static_cast<float>(side) * spacing;
+            for (std::size_t i = 0; i < count; ++i) {
+                glm::vec3 position{0.0f};
+                float scale = 1.0f;
+                if (layout == StressLayout::Grid) {
+                    position.x = (static_cast<float>(i % side) + 0.5f) * spacing - 0.5f * extent;
+                    position.z = (static_cast<float>(i / side) + 0.5f) * spacing - 0.5f * extent;
+                } else {
+                    position.x = (NextFloat(rng) - 0.5f) * extent;
+                    position.z = (NextFloat(rng) - 0.5f) * extent;
+                    scale = MIN_SCATTER_SCALE + NextFloat(rng) * (MAX_SCATTER_SCALE - MIN_SCATTER_SCALE);
+                }
+                const float angle = NextFloat(rng) * glm::two_pi<float>();
+
+                auto worldMatrix = glm::translate(glm::mat4{1.0f}, position);
+                worldMatrix = glm::rotate(worldMatrix, angle, glm::vec3{0.0f, 1.0f, 0.0f});
+                worldMatrix = glm::scale(worldMatrix, glm::vec3{scale});
+                instances.emplace_back(StressInstance{mesh, worldMatrix});
+            }
+        }
+    }
+
+    std::vector<StressInstance> GenerateStressInstances(const StressSceneSettings& settings)
+    {
+        std::vector<StressInstance> instances;
+        instances.reserve(settings.m_numTeapots + settings.m_numSponzas);
+        std::mt19937 rng{settings.m_seed};
+        PlaceInstances(StressMesh::Teapot, settings.m_numTeapots, TEAPOT_SPACING, settings.m_layout, rng, instances);
+        PlaceInstances(StressMesh::Sponza, settings.m_numSponzas, SPONZA_SPACING, settings.m_layout, rng, instances);
+        return instances;
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file   TextureCache.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the texture cache.
+ */
+
+#include "app/TextureCache.h"
+#include "main.h"
+
+#include <core/resources/Resource.h>
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+namespace vkfw_app::scene {
+
+    namespace {
+        /** The directory (relative to the working directory) the precompiled textures are stored in. */
+        constexpr std::string_view TEXTURE_CACHE_DIRECTORY = "texture_cache";
+
+        std::shared_ptr<const gfx::CompressedTexture> LoadTexture(const std::string& textureFilename)
+        {
+            auto sourceFilename = std::filesystem::path{vkfw_core::Resource::FindResourceLocation(textureFilename)};
+            auto cacheFilename = TextureCache::GetCacheFilename(textureFilename);
+
+            std::error_code ec;
+            auto cacheTime = std::filesystem::last_write_time(cacheFilename, ec);
+            if (!ec && cacheTime >= std::filesystem::last_write_time(sourceFilename, ec) && !ec) {
+                if (auto texture = gfx::CompressedTexture::ReadKTX(cacheFilename)) { return texture; }
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> image{stbi_load(sourceFilename.string().c_str(), &width, &height, &channels, STBI_rgb_alpha),
+                                                                       &stbi_image_free};
+            if (!image) {
+                spdlog::error("Could not load texture {}: {}.", textureFilename, stbi_failure_reason());
+                throw std::runtime_error(fmt::format("Could not load texture {}.", textureFilename));
+            }
+
+            auto texture = gfx::CompressedTexture::Compress(TextureCache::GuessTextureRole(textureFilename), image.get(), static_cast<std::uint32_t>(width),
+                                                            static_cast<std::uint32_t>(height));
+            texture->WriteKTX(cacheFilename);
+            spdlog::info("Compressed texture {} ({}x{}, {} mip levels, {} KiB) in {:.1f} ms.", textureFilename, width, height, texture->GetNumberOfMipLevels(),
+                         texture->GetByteSize() / 1024, std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count());
+            return texture;
+        }
+    }
+
+    TextureCache::TextureFuture TextureCache::RequestTexture(const std::string& textureFilename)
+    {
+        std::scoped_lock lock{m_texturesMutex};
+        auto& texture = m_textures[textureFilename];
+        if (!texture.valid()) { texture = std::async(std::launch::async, [textureFilename]() { return LoadTexture(textureFilename); }).share(); }
+        return texture;
+    }
+
+    std::filesystem::path TextureCache::GetCacheFilename(const std::string& textureFilename)
+    {
+        return std::filesystem::path{TEXTURE_CACHE_DIRECTORY} / fmt::format("{}.ktx", textureFilename);
+    }
+
+    gfx::TextureRole TextureCache::GuessTextureRole(const std::string& textureFilename)
+    {
+        auto stem = std::filesystem::path{textureFilename}.stem().string();
+        std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        auto hasSuffix = [&stem](std::string_view suffix) { return stem.size() >= suffix.size() && stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0; };
+
+        if (hasSuffix("_ddn") || hasSuffix("_normal") || hasSuffix("_nrm")) { return gfx::TextureRole::Normal; }
+        if (hasSuffix("_bump") || hasSuffix("_spec") || hasSuffix("_mask")) { return gfx::TextureRole::Scalar; }
+        return gfx::TextureRole::Color;
+    }
+}
@@ -0,0 +1,179 @@
+/**
+ * @file   AsyncLogSink.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the asynchronous log sink.
+ */
+
+#include "core/AsyncLogSink.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace vkfw_app::core {
+
+    namespace {
+        std::uint64_t NextSinkId()
+        {
+            static std::atomic<std::uint64_t> nextId = 0;
+            return nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    AsyncLogSink::AsyncLogSink(std::vector<spdlog::sink_ptr> sinks) : m_id{NextSinkId()}, m_sinks{std::move(sinks)}
+    {
+        m_drainThread = std::thread{[this]() { DrainThread(); }};
+    }
+
+    AsyncLogSink::~AsyncLogSink()
+    {
+        {
+            std::scoped_lock lock{m_mutex};
+            m_stop = true;
+        }
+        m_drainCondition.notify_one();
+        m_drainThread.join();
+    }
+
+    AsyncLogSink::ThreadBuffer& AsyncLogSink::GetThreadBuffer()
+    {
+        struct ThreadBufferHolder
+        {
+            std::uint64_t m_sinkId = static_cast<std::uint64_t>(-1);
+            std::shared_ptr<ThreadBuffer> m_buffer;
+
+            ~ThreadBufferHolder()
+            {
+                if (m_buffer) { m_buffer->m_retired.store(true, std::memory_order_release); }
+            }
+        };
+        thread_local ThreadBufferHolder holder;
+
+        if (holder.m_sinkId != m_id) {
+            if (holder.m_buffer) { holder.m_buffer->m_retired.store(true, std::memory_order_release); }
+            auto buffer = std::make_shared<ThreadBuffer>();
+            {
+                std::scoped_lock lock{m_mutex};
+                m_threadBuffers.push_back(buffer);
+            }
+            holder.m_sinkId = m_id;
+            holder.m_buffer = std::move(buffer);
+        }
+        return *holder.m_buffer;
+    }
+
+    void AsyncLogSink::log(const spdlog::details::log_msg& msg)
+    {
+        Message message;
+        message.m_time = msg.time;
+        message.m_threadId = msg.thread_id;
+        message.m_level = msg.level;
+        message.m_loggerNameLength = static_cast<std::uint32_t>(msg.logger_name.size());
+        message.m_payloadLength = static_cast<std::uint32_t>(msg.payload.size());
+        auto textLength = msg.logger_name.size() + msg.payload.size();
+        char* text = message.m_text.data();
+        if (textLength > message.m_text.size()) {
+            message.m_spilledText = new char[textLength]; // NOLINT
+            text = message.m_spilledText;
+        }
+        std::memcpy(text, msg.logger_name.data(), msg.logger_name.size());
+        std::memcpy(text + msg.logger_name.size(), msg.payload.data(), msg.payload.size());
+
+        auto& buffer = GetThreadBuffer();
+        if (!buffer.m_overflowing.load(std::memory_order_acquire) && buffer.m_messages.TryPush(message)) {
+            // errors should show up immediately, filling buffers should be drained before they overflow.
+            if (msg.level >= spdlog::level::err || buffer.m_messages.Size() > MESSAGES_PER_THREAD / 2) { m_drainCondition.notify_one(); }
+            return;
+        }
+
+        // the ring buffer is full (or was full before and is not drained yet), the message waits in the overflow queue.
+        {
+            std::scoped_lock lock{buffer.m_overflowMutex};
+            buffer.m_overflow.push_back(message);
+            buffer.m_overflowing.store(true, std::memory_order_release);
+        }
+        m_drainCondition.notify_one();
+    }
+
+    void AsyncLogSink::flush()
+    {
+        std::unique_lock lock{m_mutex};
+        if (m_stop) { return; }
+        auto flush = ++m_requestedFlushes;
+        m_drainCondition.notify_one();
+        m_flushedCondition.wait(lock, [this, flush]() { return m_completedFlushes >= flush; });
+    }
+
+    void AsyncLogSink::DrainThread()
+    {
+        std::unique_lock lock{m_mutex};
+        while (true) {
+            m_drainCondition.wait_for(lock, DRAIN_INTERVAL, [this]() { return m_stop || m_requestedFlushes != m_completedFlushes; });
+            auto requestedFlushes = m_requestedFlushes;
+            auto flushSinks = requestedFlushes != m_completedFlushes || m_stop;
+            auto stop = m_stop;
+            lock.unlock();
+
+            Drain();
+            if (flushSinks) {
+                for (const auto& sink : m_sinks) { sink->flush(); }
+            }
+
+            lock.lock();
+            m_completedFlushes = requestedFlushes;
+            m_flushedCondition.notify_all();
+            if (stop) { break; }
+        }
+    }
+
+    void AsyncLogSink::Drain()
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            std::scoped_lock lock{m_mutex};
+            buffers = m_threadBuffers;
+        }
+
+        m_drainedMessages.clear();
+        for (const auto& buffer : buffers) {
+            while (auto message = buffer->m_messages.TryPop()) { m_drainedMessages.push_back(*message); }
+            // overflowed messages were logged after everything in the ring buffer.
+            if (buffer->m_overflowing.load(std::memory_order_acquire)) {
+                std::scoped_lock lock{buffer->m_overflowMutex};
+                m_drainedMessages.insert(m_drainedMessages.end(), buffer->m_overflow.begin(), buffer->m_overflow.end());
+                buffer->m_overflow.clear();
+                buffer->m_overflowing.store(false, std::memory_order_release);
+            }
+        }
+        // messages of different threads are interleaved by time.
+        std::stable_sort(m_drainedMessages.begin(), m_drainedMessages.end(), [](const Message& lhs, const Message& rhs) { return lhs.m_time < rhs.m_time; });
+        for (const auto& message : m_drainedMessages) {
+            const char* text = message.GetText();
+            spdlog::details::log_msg msg{message.m_time, spdlog::source_loc{}, spdlog::string_view_t{text, message.m_loggerNameLength}, message.m_level,
+                                         spdlog::string_view_t{text + message.m_loggerNameLength, message.m_payloadLength}};
+            msg.thread_id = message.m_threadId;
+            WriteToSinks(msg);
+            delete[] message.m_spilledText; // NOLINT
+        }
+
+        // buffers of exited threads are released once they are empty (the retired flag is set after the last message was pushed).
+        std::scoped_lock lock{m_mutex};
+        std::erase_if(m_threadBuffers, [](const std::shared_ptr<ThreadBuffer>& buffer) {
+            return buffer->m_retired.load(std::memory_order_acquire) && buffer->m_messages.Empty() && !buffer->m_overflowing.load(std::memory_order_acquire);
+        });
+    }
+
+    void AsyncLogSink::WriteToSinks(const spdlog::details::log_msg& msg)
+    {
+        for (const auto& sink : m_sinks) {
+            if (!sink->should_log(msg.level)) { continue; }
+            try {
+                sink->log(msg);
+            } catch (const std::exception& e) {
+                std::cerr << "Could not write log message: " << e.what() << std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file   Timeline.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the CPU/GPU timeline.
+ */
+
+#include "core/Timeline.h"
+#include "main.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <set>
+
+namespace vkfw_app::core {
+
+    namespace {
+        std::uint64_t SteadyClockNanoseconds()
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    }
+
+    Timeline& Timeline::Instance()
+    {
+        static Timeline timeline;
+        return timeline;
+    }
+
+    Timeline::Timeline() : m_epoch{SteadyClockNanoseconds()} {}
+
+    std::uint64_t Timeline::Now() const { return SteadyClockNanoseconds() - m_epoch; }
+
+    Timeline::ThreadBufferOwner::~ThreadBufferOwner()
+    {
+        if (m_buffer != nullptr) { Timeline::Instance().ReleaseThreadBuffer(m_buffer); }
+    }
+
+    Timeline::ThreadBuffer& Timeline::GetThreadBuffer()
+    {
+        thread_local ThreadBufferOwner owner;
+        if (owner.m_buffer == nullptr) {
+            std::scoped_lock lock{m_threadsMutex};
+            if (!m_freeThreadBuffers.empty()) {
+                // the previous producer has exited, the mutex orders its last push before our first one.
+                owner.m_buffer = m_freeThreadBuffers.back();
+                m_freeThreadBuffers.pop_back();
+            } else {
+                auto& buffer = m_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+                buffer->m_track = FIRST_THREAD_TRACK + static_cast<std::uint32_t>(m_threadBuffers.size() - 1);
+                owner.m_buffer = buffer.get();
+            }
+        }
+        return *owner.m_buffer;
+    }
+
+    void Timeline::ReleaseThreadBuffer(ThreadBuffer* buffer)
+    {
+        std::scoped_lock lock{m_threadsMutex};
+        m_freeThreadBuffers.push_back(buffer);
+    }
+
+    void Timeline::Record(const char* name, std::uint64_t begin, std::uint64_t end)
+    {
+        auto& buffer = GetThreadBuffer();
+        if (!buffer.m_events.TryPush(TimelineEvent{name, begin, end, buffer.m_track})) { m_droppedEvents.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    void Timeline::RecordOnTrack(std::uint32_t track, const char* name, std::uint64_t begin, std::uint64_t end)
+    {
+        auto& buffer = GetThreadBuffer();
+        if (!buffer.m_events.TryPush(TimelineEvent{name, begin, end, track})) { m_droppedEvents.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    void Timeline::Drain()
+    {
+        std::scoped_lock lock{m_threadsMutex};
+        for (auto& buffer : m_threadBuffers) {
+            while (auto event = buffer->m_events.TryPop()) { m_events.push_back(*event); }
+        }
+    }
+
+    void Timeline::WriteChromeTrace(const std::filesystem::path& filename)
+    {
+        Drain();
+
+        std::ofstream out{filename, std::ios::out | std::ios::trunc};
+        if (!out.is_open()) {
+            spdlog::error("Could not open timeline trace file {}.", filename.string());
+            return;
+        }
+
+        std::set<std::uint32_t> tracks;
+        for (const auto& event : m_events) { tracks.insert(event.m_track); }
+
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+        out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"vkfw\"}}";
+        for (auto track : tracks) {
+            auto trackName = track == GPU_TRACK ? std::string{"GPU"} : fmt::format("CPU Thread {}", track - FIRST_THREAD_TRACK + 1);
+            out << fmt::format(",\n{{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": {}, \"args\": {{\"name\": \"{}\"}}}}", track, trackName);
+        }
+        for (const auto& event : m_events) {
+            out << fmt::format(",\n{{\"name\": \"{}\", \"cat\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}", event.m_name,
+                               event.m_track == GPU_TRACK ? "gpu" : "cpu", event.m_track, static_cast<double>(event.m_begin) * 1e-3,
+                               static_cast<double>(event.m_end - std::min(event.m_begin, event.m_end)) * 1e-3);
+        }
+        out << "\n]}\n";
+
+        spdlog::info("Wrote {} timeline events to {} ({} dropped).", m_events.size(), filename.string(), GetDroppedEvents());
+    }
+}
@@ -14,6 +14,7 @@
 #include <gfx/vk/wrappers/DescriptorSet.h>
 #include <gfx/vk/UniformBufferObject.h>
 #include "materials/material_sample_host_interface.h"
+#include "rt/rt_sample_host_interface.h"
 
 namespace vkfw_app::gfx::rt {
 
@@ -35,6 +36,9 @@ namespace vkfw_app::gfx::rt {
         shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/skipAlpha.rahit"), 0);
 
         shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/ao/closesthit_mirror.rchit"), 1);
+
+        // ambient occlusion rays only need visibility, one occlusion hit group for each of the two material hit groups.
+        AddOcclusionShaders(shaders, static_cast<std::uint32_t>(scene::rt::OcclusionRays::AOOcclusionHitGroupOffset), 2);
         return shaders;
     }
 
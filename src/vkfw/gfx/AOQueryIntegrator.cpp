@@ -0,0 +1,54 @@
+/**
+ * @file   AOQueryIntegrator.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation the ambient occlusion integrator using ray queries.
+ */
+
+#include "gfx/AOQueryIntegrator.h"
+#include "gfx/PipelineCache.h"
+#include "main.h"
+#include <gfx/vk/LogicalDevice.h>
+#include <core/resources/ShaderManager.h>
+#include <gfx/vk/wrappers/CommandBuffer.h>
+#include <gfx/vk/wrappers/DescriptorSet.h>
+#include <gfx/vk/wrappers/PipelineLayout.h>
+#include <gfx/vk/UniformBufferObject.h>
+#include "materials/material_sample_host_interface.h"
+#include "rt/rt_sample_host_interface.h"
+
+namespace vkfw_app::gfx::rt {
+
+    namespace {
+        constexpr std::uint32_t WORKGROUP_SIZE = static_cast<std::uint32_t>(scene::rt::RayQueryParameters::RayQueryWorkgroupSize);
+    }
+
+    AOQueryIntegrator::AOQueryIntegrator(vkfw_core::gfx::LogicalDevice* device) : RTIntegrator{"Ambient Occlusion Ray Query Integrator", "AOQueryPipeline", device, 1}
+    {
+        // ray queries ignore the shader binding table, the mapping of the AOIntegrator avoids rebuilding the instances when switching.
+        materialSBTMapping().resize(static_cast<std::size_t>(materials::MaterialIdentifierApp::TotalMaterialCount), 0);
+        materialSBTMapping()[static_cast<std::size_t>(materials::MaterialIdentifierApp::MirrorMaterialType)] = 1;
+    }
+
+    AOQueryIntegrator::~AOQueryIntegrator() = default;
+
+    void AOQueryIntegrator::InitializePipeline(const vkfw_core::gfx::PipelineLayout& pipelineLayout)
+    {
+        m_pipelineLayout = &pipelineLayout;
+
+        vk::PipelineShaderStageCreateInfo shaderStageInfo;
+        GetDevice()->GetShaderManager()->GetResource("shader/rt/ao/ao_query.comp")->FillShaderStageInfo(shaderStageInfo);
+        vk::ComputePipelineCreateInfo pipelineCreateInfo{vk::PipelineCreateFlags{}, shaderStageInfo, m_pipelineLayout->GetHandle()};
+        m_pipeline = gfx::CreateComputePipeline(GetDevice(), GetPipelineCache(), pipelineCreateInfo, "ray query AO");
+    }
+
+    void AOQueryIntegrator::TraceRays(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const glm::u32vec4& rtGroups)
+    {
+        cmdBuffer.GetHandle().bindPipeline(vk::PipelineBindPoint::eCompute, *m_pipeline);
+        GetResourcesDescriptorSet().Bind(cmdBuffer, vk::PipelineBindPoint::eCompute, *m_pipelineLayout, 0, static_cast<std::uint32_t>(cmdBufferIndex * GetCameraUBO().GetInstanceSize()));
+        GetImageDescriptorSet(cmdBufferIndex).Bind(cmdBuffer, vk::PipelineBindPoint::eCompute, *m_pipelineLayout, 1);
+
+        cmdBuffer.GetHandle().dispatch((rtGroups.x + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, (rtGroups.y + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1);
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file   BlockCompression.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the block compression encoders.
+ */
+
+#include "gfx/BlockCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace vkfw_app::gfx {
+
+    namespace {
+        using Block = std::array<std::array<std::uint8_t, 4>, 16>;
+
+        std::uint16_t PackRGB565(int r, int g, int b)
+        {
+            return static_cast<std::uint16_t>(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+        }
+
+        std::array<int, 3> UnpackRGB565(std::uint16_t c)
+        {
+            auto r = (c >> 11) & 0x1F;
+            auto g = (c >> 5) & 0x3F;
+            auto b = c & 0x1F;
+            return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+        }
+
+        void EncodeColorBlock(const Block& block, std::byte* out)
+        {
+            std::array<int, 3> minColor = {255, 255, 255};
+            std::array<int, 3> maxColor = {0, 0, 0};
+            for (const auto& texel : block) {
+                for (std::size_t c = 0; c < 3; ++c) {
+                    minColor[c] = std::min(minColor[c], static_cast<int>(texel[c]));
+                    maxColor[c] = std::max(maxColor[c], static_cast<int>(texel[c]));
+                }
+            }
+            // inset the bounding box to reduce the error of the outer palette entries.
+            for (std::size_t c = 0; c < 3; ++c) {
+                auto inset = (maxColor[c] - minColor[c]) / 16;
+                minColor[c] += inset;
+                maxColor[c] -= inset;
+            }
+
+            auto color0 = PackRGB565(maxColor[0], maxColor[1], maxColor[2]);
+            auto color1 = PackRGB565(minColor[0], minColor[1], minColor[2]);
+            // color0 > color1 selects the four color mode.
+            if (color0 < color1) { std::swap(color0, color1); }
+
+            std::uint32_t indices = 0;
+            if (color0 != color1) {
+                auto c0 = UnpackRGB565(color0);
+                auto c1 = UnpackRGB565(color1);
+                std::array<std::array<int, 3>, 4> palette;
+                for (std::size_t c = 0; c < 3; ++c) {
+                    palette[0][c] = c0[c];
+                    palette[1][c] = c1[c];
+                    palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+                    palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+                }
+                for (std::size_t i = 0; i < block.size(); ++i) {
+                    std::uint32_t bestIndex = 0;
+                    int bestError = std::numeric_limits<int>::max();
+                    for (std::uint32_t p = 0; p < 4; ++p) {
+                        int error = 0;
+                        for (std::size_t c = 0; c < 3; ++c) {
+                            auto d = static_cast<int>(block[i][c]) - palette[p][c];
+                            error += d * d;
+                        }
+                        if (error < bestError) {
+                            bestError = error;
+                            bestIndex = p;
+                        }
+                    }
+                    indices |= bestIndex << (2 * i);
+                }
+            }
+
+            std::memcpy(out, &color0, 2);
+            std::memcpy(out + 2, &color1, 2);
+            std::memcpy(out + 4, &indices, 4);
+        }
+
+        void EncodeSingleChannelBlock(const Block& block, std::size_t channel, std::byte* out)
+        {
+            int minValue = 255;
+            int maxValue = 0;
+            for (const auto& texel : block) {
+                minValue = std::min(minValue, static_cast<int>(texel[channel]));
+                maxValue = std::max(maxValue, static_cast<int>(texel[channel]));
+            }
+
+            // value0 > value1 selects the eight value mode.
+            std::uint64_t bits = static_cast<std::uint64_t>(maxValue) | static_cast<std::uint64_t>(minValue) << 8;
+            if (maxValue != minValue) {
+                std::array<int, 8> palette = {maxValue, minValue};
+                for (int p = 1; p < 7; ++p) { palette[static_cast<std::size_t>(p + 1)] = ((7 - p) * maxValue + p * minValue) / 7; }
+                for (std::size_t i = 0; i < block.size(); ++i) {
+                    std::uint64_t bestIndex = 0;
+                    int bestError = std::numeric_limits<int>::max();
+                    for (std::size_t p = 0; p < palette.size(); ++p) {
+                        auto error = std::abs(static_cast<int>(block[i][channel]) - palette[p]);
+                        if (error < bestError) {
+                            bestError = error;
+                            bestIndex = p;
+                        }
+                    }
+                    bits |= bestIndex << (16 + 3 * i);
+                }
+            }
+            std::memcpy(out, &bits, 8);
+        }
+
+        Block FetchBlock(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, std::uint32_t blockX, std::uint32_t blockY)
+        {
+            Block block;
+            for (std::uint32_t y = 0; y < 4; ++y) {
+                for (std::uint32_t x = 0; x < 4; ++x) {
+                    auto px = std::min(blockX * 4 + x, width - 1);
+                    auto py = std::min(blockY * 4 + y, height - 1);
+                    std::memcpy(block[y * 4 + x].data(), rgba + 4 * (static_cast<std::size_t>(py) * width + px), 4);
+                }
+            }
+            return block;
+        }
+    }
+
+    std::vector<std::byte> CompressImage(BlockFormat format, const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height)
+    {
+        auto blocksX = std::max(1u, (width + 3) / 4);
+        auto blocksY = std::max(1u, (height + 3) / 4);
+        auto blockSize = GetBlockSize(format);
+        std::vector<std::byte> result(static_cast<std::size_t>(blocksX) * blocksY * blockSize);
+
+        for (std::uint32_t by = 0; by < blocksY; ++by) {
+            for (std::uint32_t bx = 0; bx < blocksX; ++bx) {
+                auto block = FetchBlock(rgba, width, height, bx, by);
+                auto* out = result.data() + (static_cast<std::size_t>(by) * blocksX + bx) * blockSize;
+                switch (format) {
+                case BlockFormat::BC1: EncodeColorBlock(block, out); break;
+                case BlockFormat::BC3:
+                    EncodeSingleChannelBlock(block, 3, out);
+                    EncodeColorBlock(block, out + 8);
+                    break;
+                case BlockFormat::BC4: EncodeSingleChannelBlock(block, 0, out); break;
+                case BlockFormat::BC5:
+                    EncodeSingleChannelBlock(block, 0, out);
+                    EncodeSingleChannelBlock(block, 1, out + 8);
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file   CompositingPipeline.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the fullscreen compositing pipeline.
+ */
+
+#include "gfx/CompositingPipeline.h"
+#include "gfx/PipelineCache.h"
+#include "main.h"
+#include <core/resources/ShaderManager.h>
+#include <gfx/vk/LogicalDevice.h>
+#include <gfx/vk/wrappers/CommandBuffer.h>
+#include <gfx/vk/wrappers/PipelineLayout.h>
+#include <gfx/vk/wrappers/RenderPass.h>
+
+#include <array>
+
+namespace vkfw_app::gfx {
+
+    namespace {
+        constexpr std::string_view FULLSCREEN_VERTEX_SHADER = "shader/rt/fullscreenTriangle.vert";
+    }
+
+    bool CompositingPipeline::CreatePipeline(std::string_view fragmentShader, const vkfw_core::gfx::RenderPass& renderPass, std::uint32_t subpass,
+                                             const vkfw_core::gfx::PipelineLayout& pipelineLayout, PipelineCache* pipelineCache)
+    {
+        if (m_pipeline && m_fragmentShader == fragmentShader && m_renderPass == renderPass.GetHandle() && m_subpass == subpass
+            && m_pipelineLayout == pipelineLayout.GetHandle()) {
+            return false;
+        }
+
+        std::array<vk::PipelineShaderStageCreateInfo, 2> shaderStages;
+        m_device->GetShaderManager()->GetResource(std::string{FULLSCREEN_VERTEX_SHADER})->FillShaderStageInfo(shaderStages[0]);
+        m_device->GetShaderManager()->GetResource(std::string{fragmentShader})->FillShaderStageInfo(shaderStages[1]);
+
+        vk::PipelineVertexInputStateCreateInfo vertexInputInfo;
+        vk::PipelineInputAssemblyStateCreateInfo inputAssemblyInfo{vk::PipelineInputAssemblyStateCreateFlags{}, vk::PrimitiveTopology::eTriangleList};
+        // the viewport and scissor are set when recording, the counts are still needed.
+        vk::PipelineViewportStateCreateInfo viewportInfo{vk::PipelineViewportStateCreateFlags{}, 1, nullptr, 1, nullptr};
+        vk::PipelineRasterizationStateCreateInfo rasterizationInfo{vk::PipelineRasterizationStateCreateFlags{}, VK_FALSE, VK_FALSE, vk::PolygonMode::eFill,
+                                                                   vk::CullModeFlagBits::eNone, vk::FrontFace::eCounterClockwise};
+        rasterizationInfo.lineWidth = 1.0f;
+        vk::PipelineMultisampleStateCreateInfo multisampleInfo{vk::PipelineMultisampleStateCreateFlags{}, vk::SampleCountFlagBits::e1};
+        vk::PipelineDepthStencilStateCreateInfo depthStencilInfo{vk::PipelineDepthStencilStateCreateFlags{}, VK_FALSE, VK_FALSE, vk::CompareOp::eAlways};
+        vk::PipelineColorBlendAttachmentState colorBlendAttachment;
+        colorBlendAttachment.colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
+        vk::PipelineColorBlendStateCreateInfo colorBlendInfo{vk::PipelineColorBlendStateCreateFlags{}, VK_FALSE, vk::LogicOp::eCopy, colorBlendAttachment};
+        std::array<vk::DynamicState, 2> dynamicStates{vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+        vk::PipelineDynamicStateCreateInfo dynamicStateInfo{vk::PipelineDynamicStateCreateFlags{}, dynamicStates};
+
+        vk::GraphicsPipelineCreateInfo pipelineCreateInfo{vk::PipelineCreateFlags{}, shaderStages,       &vertexInputInfo, &inputAssemblyInfo,
+                                                          nullptr,                   &viewportInfo,      &rasterizationInfo, &multisampleInfo,
+                                                          &depthStencilInfo,         &colorBlendInfo,    &dynamicStateInfo,  pipelineLayout.GetHandle(),
+                                                          renderPass.GetHandle(),    subpass};
+        m_pipeline = gfx::CreateGraphicsPipeline(m_device, pipelineCache, pipelineCreateInfo, fmt::format("compositing ({})", fragmentShader));
+
+        m_fragmentShader = fragmentShader;
+        m_renderPass = renderPass.GetHandle();
+        m_subpass = subpass;
+        m_pipelineLayout = pipelineLayout.GetHandle();
+        return true;
+    }
+
+    void CompositingPipeline::Render(vkfw_core::gfx::CommandBuffer& cmdBuffer, const glm::uvec2& size) const
+    {
+        vk::Viewport viewport{0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y), 0.0f, 1.0f};
+        vk::Rect2D scissor{vk::Offset2D{0, 0}, vk::Extent2D{size.x, size.y}};
+        cmdBuffer.GetHandle().bindPipeline(vk::PipelineBindPoint::eGraphics, *m_pipeline);
+        cmdBuffer.GetHandle().setViewport(0, viewport);
+        cmdBuffer.GetHandle().setScissor(0, scissor);
+        cmdBuffer.GetHandle().draw(3, 1, 0, 0);
+    }
+}
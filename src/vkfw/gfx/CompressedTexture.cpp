@@ -0,0 +1,300 @@
+/**
+ * @file   CompressedTexture.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the block compressed texture and its KTX container.
+ */
+
+#include "gfx/CompressedTexture.h"
+#include "main.h"
+
+#include <gfx/vk/memory/MemoryGroup.h>
+
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <utility>
+
+namespace vkfw_app::gfx {
+
+    namespace {
+        /** The KTX 1.1 file identifier. */
+        constexpr std::array<std::uint8_t, 12> KTX_IDENTIFIER = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+        constexpr std::uint32_t KTX_ENDIANNESS = 0x04030201;
+        /** The key of the cache version entry in the key/value data. */
+        constexpr std::string_view CACHE_VERSION_KEY = "vkfwCacheVersion";
+
+        struct KTXHeader
+        {
+            std::array<std::uint8_t, 12> m_identifier = KTX_IDENTIFIER;
+            std::uint32_t m_endianness = KTX_ENDIANNESS;
+            /** GL type and format are 0 for compressed textures. */
+            std::uint32_t m_glType = 0;
+            std::uint32_t m_glTypeSize = 1;
+            std::uint32_t m_glFormat = 0;
+            std::uint32_t m_glInternalFormat = 0;
+            std::uint32_t m_glBaseInternalFormat = 0;
+            std::uint32_t m_pixelWidth = 0;
+            std::uint32_t m_pixelHeight = 0;
+            std::uint32_t m_pixelDepth = 0;
+            std::uint32_t m_numberOfArrayElements = 0;
+            std::uint32_t m_numberOfFaces = 1;
+            std::uint32_t m_numberOfMipmapLevels = 0;
+            std::uint32_t m_bytesOfKeyValueData = 0;
+        };
+        static_assert(sizeof(KTXHeader) == 64, "KTX header has to be 64 bytes.");
+
+        // OpenGL internal formats used by KTX to identify the block formats.
+        constexpr std::uint32_t GL_COMPRESSED_RGB_S3TC_DXT1_EXT = 0x83F0;
+        constexpr std::uint32_t GL_COMPRESSED_RGBA_S3TC_DXT5_EXT = 0x83F3;
+        constexpr std::uint32_t GL_COMPRESSED_SRGB_S3TC_DXT1_EXT = 0x8C4C;
+        constexpr std::uint32_t GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT = 0x8C4F;
+        constexpr std::uint32_t GL_COMPRESSED_RED_RGTC1 = 0x8DBB;
+        constexpr std::uint32_t GL_COMPRESSED_RG_RGTC2 = 0x8DBD;
+        constexpr std::uint32_t GL_RED = 0x1903;
+        constexpr std::uint32_t GL_RGB = 0x1907;
+        constexpr std::uint32_t GL_RGBA = 0x1908;
+        constexpr std::uint32_t GL_RG = 0x8227;
+
+        std::uint32_t GetGLInternalFormat(BlockFormat format, bool sRGB)
+        {
+            switch (format) {
+            case BlockFormat::BC1: return sRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case BlockFormat::BC3: return sRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case BlockFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+            case BlockFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+            }
+            return 0;
+        }
+
+        std::uint32_t GetGLBaseInternalFormat(BlockFormat format)
+        {
+            switch (format) {
+            case BlockFormat::BC1: return GL_RGB;
+            case BlockFormat::BC3: return GL_RGBA;
+            case BlockFormat::BC4: return GL_RED;
+            case BlockFormat::BC5: return GL_RG;
+            }
+            return 0;
+        }
+
+        std::optional<std::pair<BlockFormat, bool>> FromGLInternalFormat(std::uint32_t glInternalFormat)
+        {
+            switch (glInternalFormat) {
+            case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: return std::make_pair(BlockFormat::BC1, false);
+            case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT: return std::make_pair(BlockFormat::BC1, true);
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: return std::make_pair(BlockFormat::BC3, false);
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT: return std::make_pair(BlockFormat::BC3, true);
+            case GL_COMPRESSED_RED_RGTC1: return std::make_pair(BlockFormat::BC4, false);
+            case GL_COMPRESSED_RG_RGTC2: return std::make_pair(BlockFormat::BC5, false);
+            default: return std::nullopt;
+            }
+        }
+
+        std::size_t GetMipLevelByteSize(BlockFormat format, const glm::uvec2& size)
+        {
+            return static_cast<std::size_t>((size.x + 3) / 4) * ((size.y + 3) / 4) * GetBlockSize(format);
+        }
+
+        glm::uvec2 GetMipLevelSize(const glm::uvec2& size, std::size_t level)
+        {
+            return glm::max(glm::uvec2{1}, glm::uvec2{size.x >> level, size.y >> level});
+        }
+
+        const std::array<float, 256>& GetSRGBToLinearTable()
+        {
+            static const auto table = []() {
+                std::array<float, 256> result = {};
+                for (std::size_t i = 0; i < result.size(); ++i) {
+                    auto c = static_cast<float>(i) / 255.0f;
+                    result[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return result;
+            }();
+            return table;
+        }
+
+        std::uint8_t LinearToSRGB(float c)
+        {
+            c = std::clamp(c, 0.0f, 1.0f);
+            auto s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            return static_cast<std::uint8_t>(s * 255.0f + 0.5f);
+        }
+
+        /** Box filters an RGBA8 image to the next mip level, color channels of sRGB images are filtered in linear space. */
+        std::vector<std::uint8_t> Downsample(TextureRole role, const std::vector<std::uint8_t>& rgba, const glm::uvec2& size, const glm::uvec2& nextSize)
+        {
+            const auto& toLinear = GetSRGBToLinearTable();
+            std::vector<std::uint8_t> result(static_cast<std::size_t>(nextSize.x) * nextSize.y * 4);
+            for (std::uint32_t y = 0; y < nextSize.y; ++y) {
+                for (std::uint32_t x = 0; x < nextSize.x; ++x) {
+                    std::array<float, 4> sum = {};
+                    for (std::uint32_t sy = 0; sy < 2; ++sy) {
+                        for (std::uint32_t sx = 0; sx < 2; ++sx) {
+                            auto px = std::min(2 * x + sx, size.x - 1);
+                            auto py = std::min(2 * y + sy, size.y - 1);
+                            const auto* texel = &rgba[4 * (static_cast<std::size_t>(py) * size.x + px)];
+                            for (std::size_t c = 0; c < 4; ++c) {
+                                sum[c] += role == TextureRole::Color && c < 3 ? toLinear[texel[c]] : static_cast<float>(texel[c]) / 255.0f;
+                            }
+                        }
+                    }
+
+                    auto* out = &result[4 * (static_cast<std::size_t>(y) * nextSize.x + x)];
+                    for (auto& s : sum) { s *= 0.25f; }
+                    if (role == TextureRole::Normal) {
+                        // averaged normals are shorter than unit length, renormalize to keep the shading stable on distant surfaces.
+                        auto n = glm::vec3{sum[0], sum[1], sum[2]} * 2.0f - 1.0f;
+                        n = glm::length(n) > 0.0f ? glm::normalize(n) : glm::vec3{0.0f, 0.0f, 1.0f};
+                        n = n * 0.5f + 0.5f;
+                        sum = {n.x, n.y, n.z, sum[3]};
+                    }
+                    for (std::size_t c = 0; c < 4; ++c) {
+                        out[c] = role == TextureRole::Color && c < 3 ? LinearToSRGB(sum[c]) : static_cast<std::uint8_t>(std::clamp(sum[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+                    }
+                }
+            }
+            return result;
+        }
+    }
+
+    std::unique_ptr<CompressedTexture> CompressedTexture::Compress(TextureRole role, const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height)
+    {
+        BlockFormat format = BlockFormat::BC1;
+        switch (role) {
+        case TextureRole::Color: {
+            auto hasAlpha = false;
+            for (std::size_t i = 3; i < static_cast<std::size_t>(width) * height * 4 && !hasAlpha; i += 4) { hasAlpha = rgba[i] != 255; }
+            format = hasAlpha ? BlockFormat::BC3 : BlockFormat::BC1;
+        } break;
+        case TextureRole::Normal: format = BlockFormat::BC5; break;
+        case TextureRole::Scalar: format = BlockFormat::BC4; break;
+        }
+
+        std::unique_ptr<CompressedTexture> result{new CompressedTexture{format, role == TextureRole::Color, glm::uvec2{width, height}}};
+        auto numMipLevels = static_cast<std::size_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+        result->m_mipLevels.reserve(numMipLevels);
+
+        std::vector<std::uint8_t> level{rgba, rgba + static_cast<std::size_t>(width) * height * 4};
+        for (std::size_t mip = 0; mip < numMipLevels; ++mip) {
+            auto size = GetMipLevelSize(result->m_size, mip);
+            if (mip > 0) { level = Downsample(role, level, GetMipLevelSize(result->m_size, mip - 1), size); }
+            result->m_mipLevels.emplace_back(CompressImage(format, level.data(), size.x, size.y));
+        }
+        return result;
+    }
+
+    std::unique_ptr<CompressedTexture> CompressedTexture::ReadKTX(const std::filesystem::path& filename)
+    {
+        std::ifstream in{filename, std::ios::in | std::ios::binary};
+        if (!in.is_open()) { return nullptr; }
+
+        KTXHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(KTXHeader)); // NOLINT
+        auto format = FromGLInternalFormat(header.m_glInternalFormat);
+        if (!in || header.m_identifier != KTX_IDENTIFIER || header.m_endianness != KTX_ENDIANNESS || !format || header.m_pixelDepth != 0
+            || header.m_numberOfFaces != 1 || header.m_numberOfArrayElements != 0 || header.m_numberOfMipmapLevels == 0) {
+            spdlog::warn("Ignoring unsupported or corrupt texture {}.", filename.string());
+            return nullptr;
+        }
+
+        std::string keyValueData(header.m_bytesOfKeyValueData, '\0');
+        in.read(keyValueData.data(), static_cast<std::streamsize>(keyValueData.size()));
+        auto versionEntry = fmt::format("{}{}{}", CACHE_VERSION_KEY, '\0', CACHE_VERSION);
+        if (!in || keyValueData.find(versionEntry) == std::string::npos) {
+            spdlog::info("Cached texture {} is outdated and will be rewritten.", filename.string());
+            return nullptr;
+        }
+
+        std::unique_ptr<CompressedTexture> result{new CompressedTexture{format->first, format->second, glm::uvec2{header.m_pixelWidth, header.m_pixelHeight}}};
+        result->m_mipLevels.resize(header.m_numberOfMipmapLevels);
+        for (std::size_t mip = 0; mip < result->m_mipLevels.size(); ++mip) {
+            std::uint32_t imageSize = 0;
+            in.read(reinterpret_cast<char*>(&imageSize), sizeof(std::uint32_t)); // NOLINT
+            if (!in || imageSize != GetMipLevelByteSize(result->m_format, GetMipLevelSize(result->m_size, mip))) {
+                spdlog::warn("Ignoring corrupt texture {}.", filename.string());
+                return nullptr;
+            }
+            result->m_mipLevels[mip].resize(imageSize);
+            // block sizes are multiples of 4, so there is no mip padding.
+            in.read(reinterpret_cast<char*>(result->m_mipLevels[mip].data()), imageSize); // NOLINT
+        }
+        if (!in) {
+            spdlog::warn("Ignoring truncated texture {}.", filename.string());
+            return nullptr;
+        }
+        return result;
+    }
+
+    void CompressedTexture::WriteKTX(const std::filesystem::path& filename) const
+    {
+        std::string keyValue = fmt::format("{}{}{}{}", CACHE_VERSION_KEY, '\0', CACHE_VERSION, '\0');
+        auto keyAndValueByteSize = static_cast<std::uint32_t>(keyValue.size());
+        keyValue.resize((keyValue.size() + 3) & ~std::size_t{3}, '\0');
+
+        KTXHeader header;
+        header.m_glInternalFormat = GetGLInternalFormat(m_format, m_sRGB);
+        header.m_glBaseInternalFormat = GetGLBaseInternalFormat(m_format);
+        header.m_pixelWidth = m_size.x;
+        header.m_pixelHeight = m_size.y;
+        header.m_numberOfMipmapLevels = GetNumberOfMipLevels();
+        header.m_bytesOfKeyValueData = static_cast<std::uint32_t>(sizeof(std::uint32_t) + keyValue.size());
+
+        std::filesystem::create_directories(filename.parent_path());
+        // write to a temporary file first, so a concurrent reader never reads a partial file.
+        auto tmpFilename = std::filesystem::path{filename}.concat(".tmp");
+        {
+            std::ofstream out{tmpFilename, std::ios::out | std::ios::binary | std::ios::trunc};
+            if (!out.is_open()) {
+                spdlog::error("Could not write texture {}.", filename.string());
+                return;
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(KTXHeader)); // NOLINT
+            out.write(reinterpret_cast<const char*>(&keyAndValueByteSize), sizeof(std::uint32_t)); // NOLINT
+            out.write(keyValue.data(), static_cast<std::streamsize>(keyValue.size()));
+            for (const auto& level : m_mipLevels) {
+                auto imageSize = static_cast<std::uint32_t>(level.size());
+                out.write(reinterpret_cast<const char*>(&imageSize), sizeof(std::uint32_t)); // NOLINT
+                out.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size())); // NOLINT
+            }
+        }
+        std::filesystem::rename(tmpFilename, filename);
+    }
+
+    unsigned int CompressedTexture::AddToMemoryGroup(vkfw_core::gfx::MemoryGroup& memGroup, std::string_view name, const std::vector<std::uint32_t>& queueFamilyIndices) const
+    {
+        auto textureDesc = vkfw_core::gfx::TextureDescriptor::SampleOnlyTextureDesc(static_cast<unsigned int>(GetBlockSize(m_format)), GetFormat());
+        auto textureIdx = memGroup.AddTextureToGroup(name, textureDesc, glm::u32vec4{m_size, 1, 1}, GetNumberOfMipLevels(), queueFamilyIndices);
+        for (std::size_t mip = 0; mip < m_mipLevels.size(); ++mip) {
+            auto size = GetMipLevelSize(m_size, mip);
+            memGroup.AddDataToTextureInGroup(textureIdx, vk::ImageAspectFlagBits::eColor, static_cast<std::uint32_t>(mip), 0, glm::u32vec3{size, 1},
+                                             m_mipLevels[mip].size(), m_mipLevels[mip].data());
+        }
+        return textureIdx;
+    }
+
+    vk::Format CompressedTexture::GetFormat() const
+    {
+        switch (m_format) {
+        case BlockFormat::BC1: return m_sRGB ? vk::Format::eBc1RgbSrgbBlock : vk::Format::eBc1RgbUnormBlock;
+        case BlockFormat::BC3: return m_sRGB ? vk::Format::eBc3SrgbBlock : vk::Format::eBc3UnormBlock;
+        case BlockFormat::BC4: return vk::Format::eBc4UnormBlock;
+        case BlockFormat::BC5: return vk::Format::eBc5UnormBlock;
+        }
+        return vk::Format::eUndefined;
+    }
+
+    std::size_t CompressedTexture::GetByteSize() const
+    {
+        std::size_t result = 0;
+        for (const auto& level : m_mipLevels) { result += level.size(); }
+        return result;
+    }
+}
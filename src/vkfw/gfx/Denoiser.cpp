@@ -0,0 +1,137 @@
+/**
+ * @file   Denoiser.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the a-trous denoiser.
+ */
+
+#include "gfx/Denoiser.h"
+#include "gfx/PipelineCache.h"
+#include "main.h"
+#include <core/resources/ShaderManager.h>
+#include <gfx/vk/LogicalDevice.h>
+#include <gfx/vk/wrappers/CommandBuffer.h>
+
+#include <algorithm>
+#include <array>
+
+namespace vkfw_app::gfx::rt {
+
+    namespace {
+        using DenoiseParameters = scene::rt::DenoiseParameters;
+
+        constexpr std::uint32_t WORKGROUP_SIZE = static_cast<std::uint32_t>(DenoiseParameters::DenoiseWorkgroupSize);
+        constexpr std::uint32_t MAX_ITERATIONS = static_cast<std::uint32_t>(DenoiseParameters::MaxDenoiseIterations);
+    }
+
+    Denoiser::Denoiser(vkfw_core::gfx::LogicalDevice* device)
+        : m_device{device}
+        , m_descriptorSetLayout{"DenoiseDescriptorSetLayout"}
+        , m_pipelineLayout{device->GetHandle(), "DenoisePipelineLayout", vk::UniquePipelineLayout{}}
+    {
+        using Bindings = scene::rt::DenoiseSetBindings;
+        using Texture = vkfw_core::gfx::Texture;
+
+        Texture::AddDescriptorLayoutBinding(m_descriptorSetLayout, vk::DescriptorType::eStorageImage, vk::ShaderStageFlagBits::eCompute, static_cast<uint32_t>(Bindings::DenoiseInput));
+        Texture::AddDescriptorLayoutBinding(m_descriptorSetLayout, vk::DescriptorType::eStorageImage, vk::ShaderStageFlagBits::eCompute, static_cast<uint32_t>(Bindings::DenoiseOutput));
+        Texture::AddDescriptorLayoutBinding(m_descriptorSetLayout, vk::DescriptorType::eStorageImage, vk::ShaderStageFlagBits::eCompute, static_cast<uint32_t>(Bindings::DenoiseGBuffer));
+        m_descriptorSetLayoutHandle = m_descriptorSetLayout.CreateDescriptorLayout(m_device);
+
+        vk::PushConstantRange pushConstantRange{vk::ShaderStageFlagBits::eCompute, 0, sizeof(scene::rt::DenoisePushConstants)};
+        vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo{vk::PipelineLayoutCreateFlags{}, m_descriptorSetLayoutHandle, pushConstantRange};
+        m_pipelineLayout.SetHandle(m_device->GetHandle(), m_device->GetHandle().createPipelineLayoutUnique(pipelineLayoutCreateInfo));
+    }
+
+    Denoiser::~Denoiser() = default;
+
+    void Denoiser::SetIterations(std::uint32_t iterations) { m_iterations = std::clamp(iterations, 1U, MAX_ITERATIONS); }
+
+    void Denoiser::InitializeResources(const glm::uvec2& screenSize, std::span<vkfw_core::gfx::DeviceTexture> convergenceImages,
+                                       std::span<vkfw_core::gfx::DeviceTexture> gBufferImages)
+    {
+        using Bindings = scene::rt::DenoiseSetBindings;
+        m_screenSize = screenSize;
+        const auto numFrames = convergenceImages.size();
+        // the old descriptor sets reference the old images and pool.
+        m_descriptorSets.clear();
+
+        vkfw_core::gfx::TextureDescriptor filterTexDesc{16, vk::Format::eR32G32B32A32Sfloat, vk::SampleCountFlagBits::e1};
+        filterTexDesc.m_imageTiling = vk::ImageTiling::eOptimal;
+        filterTexDesc.m_imageUsage = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
+        filterTexDesc.m_memoryProperties = vk::MemoryPropertyFlagBits::eDeviceLocal;
+        m_filterImages.clear();
+        m_filterImages.reserve(2 * numFrames);
+        for (std::size_t i = 0; i < 2 * numFrames; ++i) {
+            auto& image = m_filterImages.emplace_back(m_device, fmt::format("DenoiseFilterImage-{}-{}", i / 2, i % 2), filterTexDesc, vk::ImageLayout::eUndefined);
+            image.InitializeImage(glm::u32vec4{screenSize, 1, 1}, 1);
+        }
+
+        std::vector<vk::DescriptorPoolSize> descSetPoolSizes;
+        const auto numDescSets = NUM_FILTER_PASSES * numFrames;
+        m_descriptorSetLayout.AddDescriptorPoolSizes(descSetPoolSizes, numDescSets);
+        m_descriptorPool = vkfw_core::gfx::DescriptorSetLayout::CreateDescriptorPool(m_device, "DenoiseDescriptorPool", descSetPoolSizes, numDescSets);
+        std::vector<vk::DescriptorSetLayout> descSetLayouts(numDescSets, m_descriptorSetLayoutHandle);
+        vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{m_descriptorPool.GetHandle(), descSetLayouts};
+        auto descSetAllocateResults = m_device->GetHandle().allocateDescriptorSets(descriptorSetAllocateInfo);
+
+        m_descriptorSets.reserve(numDescSets);
+        for (std::size_t i = 0; i < numFrames; ++i) {
+            std::array<vkfw_core::gfx::Texture*, NUM_FILTER_PASSES> sources = {&convergenceImages[i], &convergenceImages[i], &m_filterImages[2 * i + 1], &m_filterImages[2 * i]};
+            std::array<vkfw_core::gfx::Texture*, NUM_FILTER_PASSES> targets = {&m_filterImages[2 * i], &m_filterImages[2 * i + 1], &m_filterImages[2 * i], &m_filterImages[2 * i + 1]};
+            for (std::size_t pass = 0; pass < NUM_FILTER_PASSES; ++pass) {
+                auto& descSet = m_descriptorSets.emplace_back(m_device, fmt::format("DenoiseDescriptorSet-{}-{}", i, pass), std::move(descSetAllocateResults[NUM_FILTER_PASSES * i + pass]));
+                descSet.InitializeWrites(m_device, m_descriptorSetLayout);
+                std::array<vkfw_core::gfx::Texture*, 1> source = {sources[pass]};
+                std::array<vkfw_core::gfx::Texture*, 1> target = {targets[pass]};
+                std::array<vkfw_core::gfx::Texture*, 1> gBuffer = {&gBufferImages[i]};
+                descSet.WriteImageDescriptor(static_cast<uint32_t>(Bindings::DenoiseInput), 0, source, vkfw_core::gfx::Sampler{}, vk::AccessFlagBits2KHR::eShaderRead,
+                                             vk::ImageLayout::eGeneral);
+                descSet.WriteImageDescriptor(static_cast<uint32_t>(Bindings::DenoiseOutput), 0, target, vkfw_core::gfx::Sampler{}, vk::AccessFlagBits2KHR::eShaderWrite,
+                                             vk::ImageLayout::eGeneral);
+                descSet.WriteImageDescriptor(static_cast<uint32_t>(Bindings::DenoiseGBuffer), 0, gBuffer, vkfw_core::gfx::Sampler{}, vk::AccessFlagBits2KHR::eShaderRead,
+                                             vk::ImageLayout::eGeneral);
+                descSet.FinalizeWrite(m_device);
+            }
+        }
+
+        // the pipeline layout is fixed, so the pipeline survives resizes.
+        if (m_pipeline) { return; }
+        vk::PipelineShaderStageCreateInfo shaderStageInfo;
+        m_device->GetShaderManager()->GetResource("shader/rt/denoise/atrous.comp")->FillShaderStageInfo(shaderStageInfo);
+        vk::ComputePipelineCreateInfo pipelineCreateInfo{vk::PipelineCreateFlags{}, shaderStageInfo, m_pipelineLayout.GetHandle()};
+        m_pipeline = gfx::CreateComputePipeline(m_device, m_pipelineCache, pipelineCreateInfo, "denoising");
+    }
+
+    vkfw_core::gfx::DescriptorSet& Denoiser::GetDescriptorSet(std::size_t cmdBufferIndex, FilterPass pass)
+    {
+        return m_descriptorSets[NUM_FILTER_PASSES * cmdBufferIndex + static_cast<std::size_t>(pass)];
+    }
+
+    void Denoiser::RecordDenoise(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex)
+    {
+        cmdBuffer.GetHandle().bindPipeline(vk::PipelineBindPoint::eCompute, *m_pipeline);
+        const glm::uvec2 groups = (m_screenSize + glm::uvec2{WORKGROUP_SIZE - 1}) / WORKGROUP_SIZE;
+        for (std::uint32_t iteration = 0; iteration < m_iterations; ++iteration) {
+            // iteration i writes the first image if the number of remaining iterations is odd, so the last one always ends there.
+            const bool toFirst = (m_iterations - iteration) % 2 == 1;
+            FilterPass pass = FilterPass::Count;
+            if (iteration == 0) {
+                pass = toFirst ? FilterPass::ConvergenceToFirst : FilterPass::ConvergenceToSecond;
+            } else {
+                pass = toFirst ? FilterPass::SecondToFirst : FilterPass::FirstToSecond;
+            }
+            // binding records the layout transitions and the dependency on the previous iteration.
+            GetDescriptorSet(cmdBufferIndex, pass).Bind(cmdBuffer, vk::PipelineBindPoint::eCompute, m_pipelineLayout, 0);
+
+            scene::rt::DenoisePushConstants pushConstants{};
+            pushConstants.stepWidth = 1 << iteration;
+            pushConstants.iteration = iteration;
+            pushConstants.flags = 0;
+            if (iteration == 0) { pushConstants.flags |= static_cast<std::uint32_t>(DenoiseParameters::DenoiseAccumulatedInputFlag); }
+            if (m_monochrome) { pushConstants.flags |= static_cast<std::uint32_t>(DenoiseParameters::DenoiseMonochromeFlag); }
+            cmdBuffer.GetHandle().pushConstants(m_pipelineLayout.GetHandle(), vk::ShaderStageFlagBits::eCompute, 0, sizeof(pushConstants), &pushConstants);
+            cmdBuffer.GetHandle().dispatch(groups.x, groups.y, 1);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * @file   GPUTimeline.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the GPU timestamp queries.
+ */
+
+#include "gfx/GPUTimeline.h"
+#include "core/Timeline.h"
+#include "main.h"
+
+#include <gfx/vk/LogicalDevice.h>
+#include <gfx/vk/wrappers/CommandBuffer.h>
+
+namespace vkfw_app::gfx {
+
+    /** Region index returned if no more regions are available. */
+    constexpr std::uint32_t INVALID_REGION = static_cast<std::uint32_t>(-1);
+
+    GPUTimeline::GPUTimeline(vkfw_core::gfx::LogicalDevice* device, std::size_t numCmdBuffers) : m_device{device}, m_cmdBufferQueries(numCmdBuffers)
+    {
+        vk::QueryPoolCreateInfo queryPoolInfo{vk::QueryPoolCreateFlags{}, vk::QueryType::eTimestamp, static_cast<std::uint32_t>(numCmdBuffers * 2 * MAX_REGIONS)};
+        m_queryPool = m_device->GetHandle().createQueryPoolUnique(queryPoolInfo);
+        m_timestampPeriod = static_cast<double>(m_device->GetPhysicalDevice().getProperties().limits.timestampPeriod);
+    }
+
+    void GPUTimeline::ResetQueries(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex)
+    {
+        auto& queries = m_cmdBufferQueries[cmdBufferIndex];
+        queries.m_regions.clear();
+        queries.m_pending = false;
+        cmdBuffer.GetHandle().resetQueryPool(*m_queryPool, QueryIndex(cmdBufferIndex, 0, false), 2 * MAX_REGIONS);
+    }
+
+    std::uint32_t GPUTimeline::BeginRegion(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const char* name)
+    {
+        auto& queries = m_cmdBufferQueries[cmdBufferIndex];
+        if (!core::Timeline::Instance().IsEnabled()) { return INVALID_REGION; }
+        if (queries.m_regions.size() >= MAX_REGIONS) {
+            spdlog::warn("Too many GPU timeline regions in command buffer {}, ignoring region {}.", cmdBufferIndex, name);
+            return INVALID_REGION;
+        }
+
+        auto region = static_cast<std::uint32_t>(queries.m_regions.size());
+        queries.m_regions.push_back(Region{name, false});
+        cmdBuffer.GetHandle().writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *m_queryPool, QueryIndex(cmdBufferIndex, region, false));
+        return region;
+    }
+
+    void GPUTimeline::EndRegion(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, std::uint32_t region)
+    {
+        if (region == INVALID_REGION) { return; }
+        m_cmdBufferQueries[cmdBufferIndex].m_regions[region].m_closed = true;
+        cmdBuffer.GetHandle().writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *m_queryPool, QueryIndex(cmdBufferIndex, region, true));
+    }
+
+    void GPUTimeline::MarkSubmitted(std::size_t cmdBufferIndex)
+    {
+        auto& queries = m_cmdBufferQueries[cmdBufferIndex];
+        if (queries.m_regions.empty()) { return; }
+        queries.m_submitTime = core::Timeline::Instance().Now();
+        queries.m_pending = true;
+    }
+
+    void GPUTimeline::CollectResults(std::size_t cmdBufferIndex)
+    {
+        auto& queries = m_cmdBufferQueries[cmdBufferIndex];
+        if (!queries.m_pending || !core::Timeline::Instance().IsEnabled()) { return; }
+
+        auto numQueries = static_cast<std::uint32_t>(2 * queries.m_regions.size());
+        std::vector<std::uint64_t> timestamps(numQueries, 0);
+        auto r = m_device->GetHandle().getQueryPoolResults(*m_queryPool, QueryIndex(cmdBufferIndex, 0, false), numQueries, timestamps.size() * sizeof(std::uint64_t),
+                                                           timestamps.data(), sizeof(std::uint64_t), vk::QueryResultFlagBits::e64);
+        // results may not be available yet (e.g., the frame is still in flight), keep them pending.
+        if (r != vk::Result::eSuccess) { return; }
+        queries.m_pending = false;
+
+        // GPU and CPU clocks are not calibrated, the first region of the frame is placed at the submit time.
+        auto gpuBase = timestamps[0];
+        auto toTimeline = [this, gpuBase, submitTime = queries.m_submitTime](std::uint64_t ticks) {
+            return submitTime + static_cast<std::uint64_t>(static_cast<double>(ticks - std::min(ticks, gpuBase)) * m_timestampPeriod);
+        };
+        for (std::uint32_t region = 0; region < queries.m_regions.size(); ++region) {
+            if (!queries.m_regions[region].m_closed) { continue; }
+            core::Timeline::Instance().RecordOnTrack(core::Timeline::GPU_TRACK, queries.m_regions[region].m_name, toTimeline(timestamps[2 * region]),
+                                                     toTimeline(timestamps[2 * region + 1]));
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * @file   LightSampler.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the emissive triangle sampler.
+ */
+
+#include "gfx/LightSampler.h"
+#include "main.h"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace vkfw_app::gfx {
+
+    namespace {
+        float Luminance(const glm::vec3& color) { return glm::dot(color, glm::vec3{0.2126f, 0.7152f, 0.0722f}); }
+    }
+
+    LightSampler::LightSampler(std::span<const EmissiveTriangle> triangles)
+    {
+        std::vector<float> power;
+        power.reserve(triangles.size());
+        m_lightTriangles.reserve(triangles.size());
+        for (const auto& triangle : triangles) {
+            scene::rt::LightTriangle light{};
+            light.v0 = triangle.m_vertices[0];
+            light.v1 = triangle.m_vertices[1];
+            light.v2 = triangle.m_vertices[2];
+            light.area = 0.5f * glm::length(glm::cross(light.v1 - light.v0, light.v2 - light.v0));
+            light.Le = triangle.m_Le;
+            m_lightTriangles.push_back(light);
+            power.push_back(std::max(Luminance(triangle.m_Le), 0.0f) * light.area);
+        }
+
+        auto totalPower = std::accumulate(power.begin(), power.end(), 0.0f);
+        if (totalPower <= 0.0f) {
+            spdlog::info("Scene does not contain any emissive triangles, light sampling is disabled.");
+            m_lightTriangles.assign(1, scene::rt::LightTriangle{});
+            m_aliasTable.assign(1, scene::rt::LightAliasEntry{1.0f, 0});
+            return;
+        }
+        m_numLightTriangles = static_cast<std::uint32_t>(m_lightTriangles.size());
+
+        // Vose's alias method: every bucket holds the average probability, split between its own triangle and one alias.
+        auto n = m_lightTriangles.size();
+        std::vector<float> scaled(n);
+        std::vector<std::uint32_t> small;
+        std::vector<std::uint32_t> large;
+        for (std::size_t i = 0; i < n; ++i) {
+            m_lightTriangles[i].selectionPdf = power[i] / totalPower;
+            scaled[i] = m_lightTriangles[i].selectionPdf * static_cast<float>(n);
+            (scaled[i] < 1.0f ? small : large).push_back(static_cast<std::uint32_t>(i));
+        }
+
+        m_aliasTable.resize(n);
+        while (!small.empty() && !large.empty()) {
+            auto s = small.back();
+            small.pop_back();
+            auto l = large.back();
+            m_aliasTable[s] = scene::rt::LightAliasEntry{scaled[s], l};
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0f;
+            if (scaled[l] < 1.0f) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // the remaining buckets are full up to rounding errors.
+        for (auto i : large) { m_aliasTable[i] = scene::rt::LightAliasEntry{1.0f, i}; }
+        for (auto i : small) { m_aliasTable[i] = scene::rt::LightAliasEntry{1.0f, i}; }
+
+        spdlog::info("Light sampler built over {} emissive triangles (total power {}).", n, totalPower);
+    }
+}
@@ -18,4 +18,15 @@ namespace vkfw_app::gfx {
     }
 
     std::unique_ptr<vkfw_core::gfx::MaterialInfo> MirrorMaterialInfo::copy() { return std::make_unique<MirrorMaterialInfo>(*this); }
+
+    std::size_t EmissiveMaterialInfo::GetGPUSize() { return sizeof(materials::EmissiveMaterial); }
+
+    void EmissiveMaterialInfo::FillGPUInfo(const EmissiveMaterialInfo& info, std::span<std::uint8_t>& gpuInfo, [[maybe_unused]] std::uint32_t firstTextureIndex)
+    {
+        auto mat = reinterpret_cast<materials::EmissiveMaterial*>(gpuInfo.data());
+        mat->Le = info.m_Le;
+        mat->firstLightTriangle = info.m_firstLightTriangle;
+    }
+
+    std::unique_ptr<vkfw_core::gfx::MaterialInfo> EmissiveMaterialInfo::copy() { return std::make_unique<EmissiveMaterialInfo>(*this); }
 }
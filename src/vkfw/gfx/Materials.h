@@ -37,4 +37,26 @@ namespace vkfw_app::gfx {
         MirrorMaterialInfo(std::string_view name, std::uint32_t materialId) : MaterialInfo(name, materialId) {}
     };
 
+    struct EmissiveMaterialInfo : public vkfw_core::gfx::MaterialInfo
+    {
+        static constexpr std::uint32_t MATERIAL_ID = static_cast<std::uint32_t>(materials::MaterialIdentifierApp::EmissiveMaterialType);
+
+        EmissiveMaterialInfo() : MaterialInfo("EmissiveMaterial", MATERIAL_ID) {}
+        EmissiveMaterialInfo(std::string_view name) : MaterialInfo(name, MATERIAL_ID) {}
+
+        /** Holds the emitted radiance. */
+        glm::vec3 m_Le = glm::vec3{1.0f};
+        /** The first entry of the geometry in the light triangles (set by the scene when building the light sampler). */
+        std::uint32_t m_firstLightTriangle = 0;
+
+        static std::size_t GetGPUSize();
+        static void FillGPUInfo(const EmissiveMaterialInfo& info, std::span<std::uint8_t>& gpuInfo, std::uint32_t firstTextureIndex);
+        std::unique_ptr<MaterialInfo> copy() override;
+
+        template<class Archive> void serialize(Archive& ar, [[maybe_unused]] const std::uint32_t version) // NOLINT
+        {
+            ar(cereal::base_class<MaterialInfo>(this), cereal::make_nvp("Le", m_Le));
+        }
+    };
+
 }
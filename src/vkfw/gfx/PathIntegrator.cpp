@@ -14,40 +14,311 @@
 #include <gfx/vk/wrappers/CommandBuffer.h>
 #include <gfx/vk/wrappers/DescriptorSet.h>
 #include "materials/material_sample_host_interface.h"
+#include "rt/path/path_host_interface.h"
+
+#include <glm/vec4.hpp>
+
+#include <cstddef>
 
 namespace vkfw_app::gfx::rt {
 
-    PathIntegrator::PathIntegrator(vkfw_core::gfx::LogicalDevice* device)
-        : RTIntegrator{"Path Tracing Integrator", "PathTracingPipeline", device, 1}
+    namespace {
+        using PathTracingCounters = scene::rt::PathTracingCounters;
+        using TraceRaysIndirectCommand = scene::rt::TraceRaysIndirectCommand;
+
+        static_assert(sizeof(TraceRaysIndirectCommand) == sizeof(vk::TraceRaysIndirectCommandKHR), "Queue counters have to match the indirect trace command.");
+        static_assert(sizeof(scene::rt::PathRay) == 56 && sizeof(scene::rt::PathHit) == 24 && sizeof(scene::rt::ShadowRay) == 48,
+                      "Queue elements have to match the scalar block layout of the shaders.");
+
+        constexpr std::size_t NUM_MATERIAL_BINS = static_cast<std::size_t>(scene::rt::PathMaterialBins::MaterialBinCount);
+        constexpr std::uint32_t MAX_PATH_DEPTH = static_cast<std::uint32_t>(scene::rt::PathTracingParameters::MaxPathDepth);
+        /** Counters copied to the host per command buffer (extensionRays and shadowRays). */
+        constexpr std::size_t NUM_READBACK_COUNTERS = 2;
+
+        std::size_t RayQueueCounterOffset(std::size_t queue) { return offsetof(PathTracingCounters, rayQueues) + queue * sizeof(TraceRaysIndirectCommand); }
+        std::size_t HitQueueCounterOffset(scene::rt::PathMaterialBins bin)
+        {
+            return offsetof(PathTracingCounters, hitQueues) + static_cast<std::size_t>(bin) * sizeof(TraceRaysIndirectCommand);
+        }
+
+        /** The stages only communicate through the queue buffers, so global memory barriers are sufficient. */
+        void RecordGlobalBarrier(vkfw_core::gfx::CommandBuffer& cmdBuffer, vk::PipelineStageFlags2KHR srcStages, vk::AccessFlags2KHR srcAccess,
+                                 vk::PipelineStageFlags2KHR dstStages, vk::AccessFlags2KHR dstAccess)
+        {
+            vk::MemoryBarrier2KHR barrier{srcStages, srcAccess, dstStages, dstAccess};
+            cmdBuffer.GetHandle().pipelineBarrier2KHR(vk::DependencyInfoKHR{vk::DependencyFlags{}, barrier});
+        }
+
+        constexpr vk::PipelineStageFlags2KHR QUEUE_STAGES = vk::PipelineStageFlagBits2KHR::eRayTracingShader | vk::PipelineStageFlagBits2KHR::eDrawIndirect;
+        constexpr vk::AccessFlags2KHR QUEUE_ACCESS = vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite | vk::AccessFlagBits2KHR::eIndirectCommandRead;
+    }
+
+    PathIntegrator::PathIntegrator(vkfw_core::gfx::LogicalDevice* device, Mode mode)
+        : RTIntegrator{mode == Mode::Wavefront ? "Wavefront Path Tracing Integrator" : "Path Tracing Integrator", "PathTracingPipeline", device, 1}
+        , m_mode{mode}
+        , m_pathDescriptorSetLayout{"PathTracingDescriptorSetLayout"}
+        , m_pathDescriptorSet{device, "PathTracingDescriptorSet", vk::DescriptorSet{}}
+        , m_generatePipeline{device, "WavefrontGeneratePipeline", {}}
+        , m_extendPipeline{device, "WavefrontExtendPipeline", {}}
+        , m_shadePhongPipeline{device, "WavefrontShadePhongPipeline", {}}
+        , m_shadeMirrorPipeline{device, "WavefrontShadeMirrorPipeline", {}}
+        , m_shadowPipeline{device, "WavefrontShadowPipeline", {}}
+        , m_accumulatePipeline{device, "WavefrontAccumulatePipeline", {}}
     {
+        using PathBindings = scene::rt::PathSetBindings;
+
         materialSBTMapping().resize(static_cast<std::size_t>(materials::MaterialIdentifierApp::TotalMaterialCount), 0);
         materialSBTMapping()[static_cast<std::size_t>(materials::MaterialIdentifierApp::MirrorMaterialType)] = 1;
+        materialSBTMapping()[static_cast<std::size_t>(materials::MaterialIdentifierApp::EmissiveMaterialType)] = 2;
+
+        // the megakernel only needs the ray counters.
+        m_pathDescriptorSetLayout.AddBinding(static_cast<uint32_t>(PathBindings::PathCounters), vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eRaygenKHR);
+        if (m_mode == Mode::Wavefront) {
+            m_pathDescriptorSetLayout.AddBinding(static_cast<uint32_t>(PathBindings::RayQueues), vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eRaygenKHR);
+            m_pathDescriptorSetLayout.AddBinding(static_cast<uint32_t>(PathBindings::HitQueues), vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eRaygenKHR);
+            m_pathDescriptorSetLayout.AddBinding(static_cast<uint32_t>(PathBindings::ShadowQueue), vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eRaygenKHR);
+            m_pathDescriptorSetLayout.AddBinding(static_cast<uint32_t>(PathBindings::PathRadiance), vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eRaygenKHR);
+        }
+        m_pathDescriptorSetLayoutHandle = m_pathDescriptorSetLayout.CreateDescriptorLayout(GetDevice());
     }
 
     PathIntegrator::~PathIntegrator() = default;
 
     std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> PathIntegrator::GetShaders() const
     {
-        // TODO: use correct shaders.
         std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> shaders;
-        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/ao/ao.rgen"), 0);
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/path/pathtrace.rgen"), 0);
         shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/ao/miss.rmiss"), 0);
 
-        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/ao/closesthit.rchit"), 0);
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/path/closesthit.rchit"), 0);
         shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/skipAlpha.rahit"), 0);
 
-        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/ao/closesthit_mirror.rchit"), 1);
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/path/closesthit_mirror.rchit"), 1);
+
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/path/closesthit_emissive.rchit"), 2);
         return shaders;
     }
 
-    void PathIntegrator::TraceRays(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const glm::u32vec4& rtGroups)
+    std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> PathIntegrator::GetTracingStageShaders(std::string_view raygenShader) const
     {
-        auto& sbtDeviceAddressRegions = GetPipeline().GetSBTDeviceAddresses();
+        // all materials use the same hit shader, it only records the hit for the shade stages.
+        std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> shaders;
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource(std::string{raygenShader}), 0);
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/ao/miss.rmiss"), 0);
 
-        GetPipeline().BindPipeline(cmdBuffer);
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/path/wf_hit.rchit"), 0);
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/skipAlpha.rahit"), 0);
+
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/path/wf_hit.rchit"), 1);
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/path/wf_hit.rchit"), 2);
+        return shaders;
+    }
+
+    void PathIntegrator::InitializeResources(const glm::uvec2& screenSize, std::size_t numCmdBuffers)
+    {
+        using PathBindings = scene::rt::PathSetBindings;
+
+        m_queueCapacity = screenSize.x * screenSize.y;
+        m_queueMemGroup = std::make_unique<vkfw_core::gfx::MemoryGroup>(GetDevice(), "PathTracingMemoryGroup", vk::MemoryPropertyFlags());
+        const auto storageUsage = vk::BufferUsageFlagBits::eStorageBuffer;
+        m_countersBufferIdx = m_queueMemGroup->AddBufferToGroup("PathTracingCounters",
+                                                                storageUsage | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress
+                                                                    | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
+                                                                sizeof(PathTracingCounters), std::vector<std::uint32_t>{{0, 1}});
+        if (m_mode == Mode::Wavefront) {
+            m_rayQueuesBufferIdx = m_queueMemGroup->AddBufferToGroup("WavefrontRayQueues", storageUsage, 2 * m_queueCapacity * sizeof(scene::rt::PathRay),
+                                                                     std::vector<std::uint32_t>{{0, 1}});
+            m_hitQueuesBufferIdx = m_queueMemGroup->AddBufferToGroup("WavefrontHitQueues", storageUsage, NUM_MATERIAL_BINS * m_queueCapacity * sizeof(scene::rt::PathHit),
+                                                                     std::vector<std::uint32_t>{{0, 1}});
+            // up to two shadow rays per pixel (sky and emitter), each writes its own radiance entry.
+            m_shadowQueueBufferIdx = m_queueMemGroup->AddBufferToGroup("WavefrontShadowQueue", storageUsage, 2 * m_queueCapacity * sizeof(scene::rt::ShadowRay),
+                                                                       std::vector<std::uint32_t>{{0, 1}});
+            m_radianceBufferIdx = m_queueMemGroup->AddBufferToGroup("WavefrontRadiance", storageUsage, 2 * m_queueCapacity * sizeof(glm::vec4), std::vector<std::uint32_t>{{0, 1}});
+        }
+        m_queueMemGroup->FinalizeDeviceGroup();
+        m_countersAddress = GetDevice()->GetHandle().getBufferAddress(vk::BufferDeviceAddressInfo{m_queueMemGroup->GetBuffer(m_countersBufferIdx)->GetHandle()});
+
+        std::vector<vk::DescriptorPoolSize> descSetPoolSizes;
+        m_pathDescriptorSetLayout.AddDescriptorPoolSizes(descSetPoolSizes, 1);
+        m_descriptorPool = vkfw_core::gfx::DescriptorSetLayout::CreateDescriptorPool(GetDevice(), "PathTracingDescriptorPool", descSetPoolSizes, 1);
+        vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{m_descriptorPool.GetHandle(), m_pathDescriptorSetLayoutHandle};
+        auto descSetAllocateResults = GetDevice()->GetHandle().allocateDescriptorSets(descriptorSetAllocateInfo);
+        m_pathDescriptorSet.SetHandle(GetDevice()->GetHandle(), std::move(descSetAllocateResults[0]));
+
+        m_pathDescriptorSet.InitializeWrites(GetDevice(), m_pathDescriptorSetLayout);
+        auto writeBuffer = [this](PathBindings binding, unsigned int bufferIdx) {
+            std::array<vkfw_core::gfx::BufferRange, 1> bufferRange;
+            bufferRange[0].m_buffer = m_queueMemGroup->GetBuffer(bufferIdx);
+            bufferRange[0].m_offset = 0;
+            bufferRange[0].m_range = VK_WHOLE_SIZE;
+            m_pathDescriptorSet.WriteBufferDescriptor(static_cast<uint32_t>(binding), 0, bufferRange, vk::AccessFlagBits2KHR::eShaderRead | vk::AccessFlagBits2KHR::eShaderWrite);
+        };
+        writeBuffer(PathBindings::PathCounters, m_countersBufferIdx);
+        if (m_mode == Mode::Wavefront) {
+            writeBuffer(PathBindings::RayQueues, m_rayQueuesBufferIdx);
+            writeBuffer(PathBindings::HitQueues, m_hitQueuesBufferIdx);
+            writeBuffer(PathBindings::ShadowQueue, m_shadowQueueBufferIdx);
+            writeBuffer(PathBindings::PathRadiance, m_radianceBufferIdx);
+        }
+        m_pathDescriptorSet.FinalizeWrite(GetDevice());
+
+        // the ray statistics are read back by the host (e.g., the benchmark) after the frame finished.
+        m_readbackData = nullptr;
+        m_readbackMemory.reset();
+        m_readbackBuffer = GetDevice()->GetHandle().createBufferUnique(vk::BufferCreateInfo{
+            vk::BufferCreateFlags{}, numCmdBuffers * NUM_READBACK_COUNTERS * sizeof(std::uint32_t), vk::BufferUsageFlagBits::eTransferDst, vk::SharingMode::eExclusive});
+        auto memoryRequirements = GetDevice()->GetHandle().getBufferMemoryRequirements(*m_readbackBuffer);
+        auto memoryProperties = GetDevice()->GetPhysicalDevice().getMemoryProperties();
+        const auto hostVisible = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+        std::uint32_t memoryType = 0;
+        while (memoryType < memoryProperties.memoryTypeCount
+               && ((memoryRequirements.memoryTypeBits & (1U << memoryType)) == 0 || (memoryProperties.memoryTypes[memoryType].propertyFlags & hostVisible) != hostVisible)) {
+            ++memoryType;
+        }
+        if (memoryType == memoryProperties.memoryTypeCount) {
+            spdlog::error("Could not find host visible memory for the path tracing statistics.");
+            throw std::runtime_error("Could not find host visible memory for the path tracing statistics.");
+        }
+        m_readbackMemory = GetDevice()->GetHandle().allocateMemoryUnique(vk::MemoryAllocateInfo{memoryRequirements.size, memoryType});
+        GetDevice()->GetHandle().bindBufferMemory(*m_readbackBuffer, *m_readbackMemory, 0);
+        auto* readbackData = static_cast<std::uint32_t*>(GetDevice()->GetHandle().mapMemory(*m_readbackMemory, 0, VK_WHOLE_SIZE));
+        std::fill_n(readbackData, numCmdBuffers * NUM_READBACK_COUNTERS, 0U);
+        m_readbackData = readbackData;
+    }
+
+    std::uint64_t PathIntegrator::GetTracedRays(std::size_t cmdBufferIndex) const
+    {
+        if (m_readbackData == nullptr) { return 0; }
+        return static_cast<std::uint64_t>(m_readbackData[NUM_READBACK_COUNTERS * cmdBufferIndex]) + m_readbackData[NUM_READBACK_COUNTERS * cmdBufferIndex + 1];
+    }
+
+    void PathIntegrator::InitializePipeline(const vkfw_core::gfx::PipelineLayout& pipelineLayout)
+    {
+        RTIntegrator::InitializePipeline(pipelineLayout);
+        if (m_mode != Mode::Wavefront) { return; }
+
+        auto createStage = [&pipelineLayout](vkfw_core::gfx::RayTracingPipeline& pipeline, std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> shaders) {
+            pipeline.ResetShaders(std::move(shaders));
+            pipeline.CreatePipeline(1, pipelineLayout);
+        };
+        // stages without tracing only consist of a ray generation shader.
+        auto raygenOnly = [this](std::string_view raygenShader) {
+            std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo> shaders;
+            shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource(std::string{raygenShader}), 0);
+            return shaders;
+        };
+
+        createStage(m_generatePipeline, raygenOnly("shader/rt/path/wf_generate.rgen"));
+        createStage(m_extendPipeline, GetTracingStageShaders("shader/rt/path/wf_extend.rgen"));
+        createStage(m_shadePhongPipeline, raygenOnly("shader/rt/path/wf_shade_phong.rgen"));
+        createStage(m_shadeMirrorPipeline, raygenOnly("shader/rt/path/wf_shade_mirror.rgen"));
+        createStage(m_shadowPipeline, GetTracingStageShaders("shader/rt/path/wf_shadow.rgen"));
+        createStage(m_accumulatePipeline, raygenOnly("shader/rt/path/wf_accumulate.rgen"));
+    }
+
+    void PathIntegrator::BindDescriptorSets(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex)
+    {
+        // all stages share the pipeline layout, the sets stay bound when switching pipelines.
         GetResourcesDescriptorSet().Bind(cmdBuffer, vk::PipelineBindPoint::eRayTracingKHR, GetPipelineLayout(), 0, static_cast<std::uint32_t>(cmdBufferIndex * GetCameraUBO().GetInstanceSize()));
         GetImageDescriptorSet(cmdBufferIndex).Bind(cmdBuffer, vk::PipelineBindPoint::eRayTracingKHR, GetPipelineLayout(), 1);
+        m_pathDescriptorSet.Bind(cmdBuffer, vk::PipelineBindPoint::eRayTracingKHR, GetPipelineLayout(), 2);
+    }
+
+    void PathIntegrator::RecordCounterUpdate(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t offset, std::size_t size, const void* data)
+    {
+        cmdBuffer.GetHandle().updateBuffer(m_queueMemGroup->GetBuffer(m_countersBufferIdx)->GetHandle(), offset, size, data);
+    }
+
+    void PathIntegrator::TraceStageIndirect(vkfw_core::gfx::CommandBuffer& cmdBuffer, vkfw_core::gfx::RayTracingPipeline& pipeline, std::size_t counterOffset)
+    {
+        auto& sbtDeviceAddressRegions = pipeline.GetSBTDeviceAddresses();
+        pipeline.BindPipeline(cmdBuffer);
+        cmdBuffer.GetHandle().traceRaysIndirectKHR(sbtDeviceAddressRegions[0], sbtDeviceAddressRegions[1], sbtDeviceAddressRegions[2], sbtDeviceAddressRegions[3],
+                                                   m_countersAddress + counterOffset);
+    }
+
+    void PathIntegrator::TraceRays(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex, const glm::u32vec4& rtGroups)
+    {
+        GetPipeline().BindPipeline(cmdBuffer);
+        BindDescriptorSets(cmdBuffer, cmdBufferIndex);
 
-        cmdBuffer.GetHandle().traceRaysKHR(sbtDeviceAddressRegions[0], sbtDeviceAddressRegions[1], sbtDeviceAddressRegions[2], sbtDeviceAddressRegions[3], rtGroups.x, rtGroups.y, rtGroups.z);
+        // all queues start empty, the generate stage appends the camera rays of the traced pixels to the first ray queue.
+        PathTracingCounters counters{};
+        counters.rayQueues[0] = TraceRaysIndirectCommand{0, 1, 1};
+        counters.rayQueues[1] = TraceRaysIndirectCommand{0, 1, 1};
+        for (auto& hitQueue : counters.hitQueues) { hitQueue = TraceRaysIndirectCommand{0, 1, 1}; }
+        counters.shadowQueue = TraceRaysIndirectCommand{0, 1, 1};
+        counters.queueCapacity = m_queueCapacity;
+        counters.imageWidth = rtGroups.x;
+        RecordGlobalBarrier(cmdBuffer, QUEUE_STAGES | vk::PipelineStageFlagBits2KHR::eTransfer, QUEUE_ACCESS | vk::AccessFlagBits2KHR::eTransferRead,
+                            vk::PipelineStageFlagBits2KHR::eTransfer, vk::AccessFlagBits2KHR::eTransferWrite);
+        RecordCounterUpdate(cmdBuffer, 0, sizeof(PathTracingCounters), &counters);
+        RecordGlobalBarrier(cmdBuffer, vk::PipelineStageFlagBits2KHR::eTransfer, vk::AccessFlagBits2KHR::eTransferWrite, QUEUE_STAGES, QUEUE_ACCESS);
+
+        if (m_mode == Mode::Wavefront) {
+            TraceWavefront(cmdBuffer, rtGroups);
+        } else {
+            auto& sbtDeviceAddressRegions = GetPipeline().GetSBTDeviceAddresses();
+            cmdBuffer.GetHandle().traceRaysKHR(sbtDeviceAddressRegions[0], sbtDeviceAddressRegions[1], sbtDeviceAddressRegions[2], sbtDeviceAddressRegions[3], rtGroups.x, rtGroups.y, rtGroups.z);
+        }
+
+        RecordReadback(cmdBuffer, cmdBufferIndex);
+    }
+
+    void PathIntegrator::TraceWavefront(vkfw_core::gfx::CommandBuffer& cmdBuffer, const glm::u32vec4& rtGroups)
+    {
+        {
+            auto& sbtDeviceAddressRegions = m_generatePipeline.GetSBTDeviceAddresses();
+            m_generatePipeline.BindPipeline(cmdBuffer);
+            cmdBuffer.GetHandle().traceRaysKHR(sbtDeviceAddressRegions[0], sbtDeviceAddressRegions[1], sbtDeviceAddressRegions[2], sbtDeviceAddressRegions[3], rtGroups.x, rtGroups.y, 1);
+        }
+
+        for (std::uint32_t bounce = 0; bounce < MAX_PATH_DEPTH; ++bounce) {
+            auto currentQueue = bounce % 2;
+            auto nextQueue = 1 - currentQueue;
+
+            // the queues filled in this bounce were read by the previous one.
+            PathTracingCounters counters{};
+            counters.rayQueues[nextQueue] = TraceRaysIndirectCommand{0, 1, 1};
+            for (auto& hitQueue : counters.hitQueues) { hitQueue = TraceRaysIndirectCommand{0, 1, 1}; }
+            counters.shadowQueue = TraceRaysIndirectCommand{0, 1, 1};
+            counters.currentRayQueue = currentQueue;
+            counters.bounce = bounce;
+            const auto* countersData = reinterpret_cast<const std::byte*>(&counters);
+            const auto bounceBegin = offsetof(PathTracingCounters, hitQueues);
+            const auto bounceEnd = offsetof(PathTracingCounters, queueCapacity);
+
+            RecordGlobalBarrier(cmdBuffer, QUEUE_STAGES, QUEUE_ACCESS, vk::PipelineStageFlagBits2KHR::eTransfer, vk::AccessFlagBits2KHR::eTransferWrite);
+            RecordCounterUpdate(cmdBuffer, RayQueueCounterOffset(nextQueue), sizeof(TraceRaysIndirectCommand), countersData + RayQueueCounterOffset(nextQueue));
+            RecordCounterUpdate(cmdBuffer, bounceBegin, bounceEnd - bounceBegin, countersData + bounceBegin);
+            RecordGlobalBarrier(cmdBuffer, vk::PipelineStageFlagBits2KHR::eTransfer, vk::AccessFlagBits2KHR::eTransferWrite, QUEUE_STAGES, QUEUE_ACCESS);
+
+            TraceStageIndirect(cmdBuffer, m_extendPipeline, RayQueueCounterOffset(currentQueue));
+            RecordGlobalBarrier(cmdBuffer, QUEUE_STAGES, QUEUE_ACCESS, QUEUE_STAGES, QUEUE_ACCESS);
+
+            // every material bin is shaded by its own coherent pass, both append to the same queues.
+            TraceStageIndirect(cmdBuffer, m_shadePhongPipeline, HitQueueCounterOffset(scene::rt::PathMaterialBins::PhongBin));
+            TraceStageIndirect(cmdBuffer, m_shadeMirrorPipeline, HitQueueCounterOffset(scene::rt::PathMaterialBins::MirrorBin));
+            RecordGlobalBarrier(cmdBuffer, QUEUE_STAGES, QUEUE_ACCESS, QUEUE_STAGES, QUEUE_ACCESS);
+
+            TraceStageIndirect(cmdBuffer, m_shadowPipeline, offsetof(PathTracingCounters, shadowQueue));
+        }
+
+        RecordGlobalBarrier(cmdBuffer, QUEUE_STAGES, QUEUE_ACCESS, QUEUE_STAGES, QUEUE_ACCESS);
+        auto& sbtDeviceAddressRegions = m_accumulatePipeline.GetSBTDeviceAddresses();
+        m_accumulatePipeline.BindPipeline(cmdBuffer);
+        cmdBuffer.GetHandle().traceRaysKHR(sbtDeviceAddressRegions[0], sbtDeviceAddressRegions[1], sbtDeviceAddressRegions[2], sbtDeviceAddressRegions[3], rtGroups.x, rtGroups.y, 1);
+    }
+
+    void PathIntegrator::RecordReadback(vkfw_core::gfx::CommandBuffer& cmdBuffer, std::size_t cmdBufferIndex)
+    {
+        RecordGlobalBarrier(cmdBuffer, vk::PipelineStageFlagBits2KHR::eRayTracingShader, vk::AccessFlagBits2KHR::eShaderWrite, vk::PipelineStageFlagBits2KHR::eTransfer,
+                            vk::AccessFlagBits2KHR::eTransferRead);
+        static_assert(offsetof(PathTracingCounters, shadowRays) == offsetof(PathTracingCounters, extensionRays) + sizeof(std::uint32_t));
+        vk::BufferCopy copyRegion{offsetof(PathTracingCounters, extensionRays), cmdBufferIndex * NUM_READBACK_COUNTERS * sizeof(std::uint32_t),
+                                  NUM_READBACK_COUNTERS * sizeof(std::uint32_t)};
+        cmdBuffer.GetHandle().copyBuffer(m_queueMemGroup->GetBuffer(m_countersBufferIdx)->GetHandle(), *m_readbackBuffer, copyRegion);
+        RecordGlobalBarrier(cmdBuffer, vk::PipelineStageFlagBits2KHR::eTransfer, vk::AccessFlagBits2KHR::eTransferWrite, vk::PipelineStageFlagBits2KHR::eHost,
+                            vk::AccessFlagBits2KHR::eHostRead);
     }
 }
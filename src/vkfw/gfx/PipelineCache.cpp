@@ -0,0 +1,155 @@
+/**
+ * @file   PipelineCache.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the persistent pipeline cache.
+ */
+
+#include "gfx/PipelineCache.h"
+#include "core/Timeline.h"
+#include "main.h"
+
+#include <gfx/vk/LogicalDevice.h>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace vkfw_app::gfx {
+
+    namespace {
+        constexpr std::string_view PIPELINE_CACHE_DIRECTORY = "pipeline_cache";
+        /** The size of VkPipelineCacheHeaderVersionOne (header size, version, vendor, device and the cache UUID). */
+        constexpr std::size_t HEADER_SIZE = 4 * sizeof(std::uint32_t) + VK_UUID_SIZE;
+
+        /** Checks the header against the device, the driver should reject foreign data but not all of them do. */
+        bool IsCompatible(const std::vector<char>& data, const vk::PhysicalDeviceProperties& properties)
+        {
+            if (data.size() < HEADER_SIZE) { return false; }
+            std::array<std::uint32_t, 4> header = {};
+            std::memcpy(header.data(), data.data(), sizeof(header));
+            return header[0] >= HEADER_SIZE && header[1] == static_cast<std::uint32_t>(vk::PipelineCacheHeaderVersion::eOne) && header[2] == properties.vendorID
+                   && header[3] == properties.deviceID && std::memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+        }
+    }
+
+    PipelineCache::PipelineCache(vkfw_core::gfx::LogicalDevice* device) : m_device{device}
+    {
+        const auto properties = m_device->GetPhysicalDevice().getProperties();
+        std::string uuid;
+        for (auto byte : properties.pipelineCacheUUID) { uuid += fmt::format("{:02x}", byte); }
+        m_filename = std::filesystem::path{PIPELINE_CACHE_DIRECTORY} / fmt::format("{:04x}_{:04x}_{}.bin", properties.vendorID, properties.deviceID, uuid);
+
+        std::vector<char> data;
+        if (std::ifstream in{m_filename, std::ios::in | std::ios::binary}; in.is_open()) {
+            data.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+            if (!IsCompatible(data, properties)) {
+                spdlog::warn("Ignoring incompatible pipeline cache {}.", m_filename.string());
+                data.clear();
+            }
+        }
+
+        vk::PipelineCacheCreateInfo cacheCreateInfo{vk::PipelineCacheCreateFlags{}, data.size(), data.data()};
+        m_pipelineCache = m_device->GetHandle().createPipelineCacheUnique(cacheCreateInfo);
+        spdlog::info("Pipeline cache {} ({} KiB loaded).", m_filename.string(), data.size() / 1024);
+    }
+
+    PipelineCache::~PipelineCache()
+    {
+        try {
+            Save();
+        } catch (const std::exception& e) {
+            spdlog::error("Could not save pipeline cache: {}", e.what());
+        }
+    }
+
+    vk::UniquePipeline PipelineCache::CreateComputePipeline(const vk::ComputePipelineCreateInfo& createInfo, std::string_view name)
+    {
+        TIMELINE_SCOPE("PipelineCache::CreateComputePipeline");
+        return CreatePipeline([this, &createInfo](vk::PipelineCache cache) { return m_device->GetHandle().createComputePipelineUnique(cache, createInfo); }, name);
+    }
+
+    vk::UniquePipeline PipelineCache::CreateGraphicsPipeline(const vk::GraphicsPipelineCreateInfo& createInfo, std::string_view name)
+    {
+        TIMELINE_SCOPE("PipelineCache::CreateGraphicsPipeline");
+        return CreatePipeline([this, &createInfo](vk::PipelineCache cache) { return m_device->GetHandle().createGraphicsPipelineUnique(cache, createInfo); }, name);
+    }
+
+    vk::UniquePipeline PipelineCache::CreatePipeline(const std::function<vk::ResultValue<vk::UniquePipeline>(vk::PipelineCache)>& create, std::string_view name)
+    {
+        const auto sizeBefore = GetDataSize();
+        auto start = std::chrono::steady_clock::now();
+        auto pipelineResult = create(*m_pipelineCache);
+        const auto creationTime = std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count();
+        if (pipelineResult.result != vk::Result::eSuccess) {
+            spdlog::error("Could not create {} pipeline: {}.", name, pipelineResult.result);
+            throw std::runtime_error(fmt::format("Could not create {} pipeline.", name));
+        }
+
+        const bool hit = GetDataSize() == sizeBefore;
+        (hit ? m_hits : m_misses) += 1;
+        m_creationTime += creationTime;
+        spdlog::info("Created {} pipeline in {:.2f} ms (pipeline cache {}).", name, creationTime, hit ? "hit" : "miss");
+        return std::move(pipelineResult.value);
+    }
+
+    void PipelineCache::Save() const
+    {
+        auto data = m_device->GetHandle().getPipelineCacheData(*m_pipelineCache);
+        std::filesystem::create_directories(m_filename.parent_path());
+        // write to a temporary file first, so an interrupted write never leaves a truncated cache behind.
+        auto tmpFilename = std::filesystem::path{m_filename}.concat(".tmp");
+        {
+            std::ofstream out{tmpFilename, std::ios::out | std::ios::binary | std::ios::trunc};
+            if (!out.is_open()) {
+                spdlog::error("Could not write pipeline cache {}.", m_filename.string());
+                return;
+            }
+            out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())); // NOLINT
+        }
+        std::filesystem::rename(tmpFilename, m_filename);
+        spdlog::info("Saved pipeline cache {} ({} KiB): {} hits, {} misses, {:.1f} ms pipeline creation.", m_filename.string(), data.size() / 1024, m_hits, m_misses,
+                     m_creationTime);
+    }
+
+    std::size_t PipelineCache::GetDataSize() const
+    {
+        std::size_t dataSize = 0;
+        if (auto r = m_device->GetHandle().getPipelineCacheData(*m_pipelineCache, &dataSize, nullptr); r != vk::Result::eSuccess) {
+            spdlog::error("Could not query pipeline cache size: {}.", r);
+            throw std::runtime_error("Could not query pipeline cache size.");
+        }
+        return dataSize;
+    }
+
+    vk::UniquePipeline CreateComputePipeline(vkfw_core::gfx::LogicalDevice* device, PipelineCache* pipelineCache, const vk::ComputePipelineCreateInfo& createInfo,
+                                             std::string_view name)
+    {
+        if (pipelineCache != nullptr) { return pipelineCache->CreateComputePipeline(createInfo, name); }
+
+        auto pipelineResult = device->GetHandle().createComputePipelineUnique(vk::PipelineCache{}, createInfo);
+        if (pipelineResult.result != vk::Result::eSuccess) {
+            spdlog::error("Could not create {} pipeline: {}.", name, pipelineResult.result);
+            throw std::runtime_error(fmt::format("Could not create {} pipeline.", name));
+        }
+        return std::move(pipelineResult.value);
+    }
+
+    vk::UniquePipeline CreateGraphicsPipeline(vkfw_core::gfx::LogicalDevice* device, PipelineCache* pipelineCache, const vk::GraphicsPipelineCreateInfo& createInfo,
+                                              std::string_view name)
+    {
+        if (pipelineCache != nullptr) { return pipelineCache->CreateGraphicsPipeline(createInfo, name); }
+
+        auto pipelineResult = device->GetHandle().createGraphicsPipelineUnique(vk::PipelineCache{}, createInfo);
+        if (pipelineResult.result != vk::Result::eSuccess) {
+            spdlog::error("Could not create {} pipeline: {}.", name, pipelineResult.result);
+            throw std::runtime_error(fmt::format("Could not create {} pipeline.", name));
+        }
+        return std::move(pipelineResult.value);
+    }
+}
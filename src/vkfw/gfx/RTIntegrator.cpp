@@ -13,6 +13,7 @@
 #include <gfx/vk/UniformBufferObject.h>
 #include <gfx/vk/wrappers/CommandBuffer.h>
 #include <gfx/vk/wrappers/DescriptorSet.h>
+#include "rt/rt_sample_host_interface.h"
 
 namespace vkfw_app::gfx::rt {
     RTIntegrator::RTIntegrator(std::string_view integratorName, std::string_view pipelineName, vkfw_core::gfx::LogicalDevice* device, std::uint32_t maxRecursionDepth)
@@ -30,6 +31,15 @@ namespace vkfw_app::gfx::rt {
         GetPipeline().CreatePipeline(m_maxRecursionDepth, GetPipelineLayout());
     }
 
+    void RTIntegrator::AddOcclusionShaders(std::vector<vkfw_core::gfx::RayTracingPipeline::RTShaderInfo>& shaders, std::uint32_t hitGroupOffset,
+                                           std::uint32_t numMaterialHitGroups) const
+    {
+        shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/occlusion.rmiss"), static_cast<std::uint32_t>(scene::rt::OcclusionRays::OcclusionMissIndex));
+        for (std::uint32_t i = 0; i < numMaterialHitGroups; ++i) {
+            shaders.emplace_back(GetDevice()->GetShaderManager()->GetResource("shader/rt/occlusionAlpha.rahit"), hitGroupOffset + i);
+        }
+    }
+
     void RTIntegrator::InitializeMisc(const vkfw_core::gfx::UniformBufferObject& cameraUBO, vkfw_core::gfx::DescriptorSet& rtResourcesDescriptorSet, std::vector<vkfw_core::gfx::DescriptorSet>& convergenceImageDescriptorSets)
     {
         m_cameraUBO = &cameraUBO;
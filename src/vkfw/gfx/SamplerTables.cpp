@@ -0,0 +1,155 @@
+/**
+ * @file   SamplerTables.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the sampler tables.
+ */
+
+#include "gfx/SamplerTables.h"
+#include "main.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace vkfw_app::gfx {
+
+    namespace {
+        using SamplerTableLayout = scene::rt::SamplerTableLayout;
+
+        constexpr std::size_t SOBOL_DIMENSIONS = static_cast<std::size_t>(SamplerTableLayout::SobolDimensions);
+        constexpr std::size_t SOBOL_BITS = static_cast<std::size_t>(SamplerTableLayout::SobolBits);
+        constexpr std::size_t BLUE_NOISE_SIZE = static_cast<std::size_t>(SamplerTableLayout::BlueNoiseSize);
+        constexpr std::size_t BLUE_NOISE_PIXELS = BLUE_NOISE_SIZE * BLUE_NOISE_SIZE;
+        constexpr std::size_t BLUE_NOISE_OFFSET = static_cast<std::size_t>(SamplerTableLayout::BlueNoiseOffset);
+        /** Standard deviation of the energy filter, 1.5 is the value recommended by Ulichney. */
+        constexpr float BLUE_NOISE_SIGMA = 1.5f;
+        /** Ratio of pixels set in the initial binary pattern. */
+        constexpr std::size_t BLUE_NOISE_INITIAL_DIVISOR = 10;
+
+        static_assert(SOBOL_DIMENSIONS * SOBOL_BITS == BLUE_NOISE_OFFSET, "The blue noise tile has to follow the Sobol direction numbers.");
+        static_assert(BLUE_NOISE_PIXELS <= 0x10000, "Two blue noise ranks are packed into 16 bits each.");
+
+        /** A binary pattern on the torus and its energy (the pattern filtered by a Gaussian) for the void and cluster method. */
+        class BinaryPattern
+        {
+        public:
+            explicit BinaryPattern(const std::vector<float>& kernel) : m_kernel{&kernel}, m_pattern(BLUE_NOISE_PIXELS, 0), m_energy(BLUE_NOISE_PIXELS, 0.0f) {}
+
+            void Set(std::size_t pixel, bool value)
+            {
+                m_pattern[pixel] = value ? 1 : 0;
+                const auto sign = value ? 1.0f : -1.0f;
+                const auto px = pixel % BLUE_NOISE_SIZE;
+                const auto py = pixel / BLUE_NOISE_SIZE;
+                for (std::size_t y = 0; y < BLUE_NOISE_SIZE; ++y) {
+                    const auto dy = (y + BLUE_NOISE_SIZE - py) % BLUE_NOISE_SIZE;
+                    for (std::size_t x = 0; x < BLUE_NOISE_SIZE; ++x) {
+                        const auto dx = (x + BLUE_NOISE_SIZE - px) % BLUE_NOISE_SIZE;
+                        m_energy[y * BLUE_NOISE_SIZE + x] += sign * (*m_kernel)[dy * BLUE_NOISE_SIZE + dx];
+                    }
+                }
+            }
+
+            [[nodiscard]] bool IsSet(std::size_t pixel) const { return m_pattern[pixel] != 0; }
+
+            /** The set pixel with the highest energy. */
+            [[nodiscard]] std::size_t TightestCluster() const { return FindExtremum(true, [](float a, float b) { return a > b; }); }
+            /** The unset pixel with the lowest energy, this is also the tightest cluster of unset pixels when most pixels are set. */
+            [[nodiscard]] std::size_t LargestVoid() const { return FindExtremum(false, [](float a, float b) { return a < b; }); }
+
+        private:
+            template<typename Compare> std::size_t FindExtremum(bool set, Compare compare) const
+            {
+                std::size_t result = BLUE_NOISE_PIXELS;
+                for (std::size_t i = 0; i < BLUE_NOISE_PIXELS; ++i) {
+                    if (IsSet(i) == set && (result == BLUE_NOISE_PIXELS || compare(m_energy[i], m_energy[result]))) { result = i; }
+                }
+                return result;
+            }
+
+            /** The filter for all toroidal offsets. */
+            const std::vector<float>* m_kernel;
+            /** The binary pattern. */
+            std::vector<std::uint8_t> m_pattern;
+            /** The filtered pattern. */
+            std::vector<float> m_energy;
+        };
+
+        std::vector<float> CreateEnergyKernel()
+        {
+            std::vector<float> kernel(BLUE_NOISE_PIXELS);
+            for (std::size_t y = 0; y < BLUE_NOISE_SIZE; ++y) {
+                for (std::size_t x = 0; x < BLUE_NOISE_SIZE; ++x) {
+                    const auto dx = static_cast<float>(std::min(x, BLUE_NOISE_SIZE - x));
+                    const auto dy = static_cast<float>(std::min(y, BLUE_NOISE_SIZE - y));
+                    kernel[y * BLUE_NOISE_SIZE + x] = std::exp(-(dx * dx + dy * dy) / (2.0f * BLUE_NOISE_SIGMA * BLUE_NOISE_SIGMA));
+                }
+            }
+            return kernel;
+        }
+    }
+
+    std::vector<std::uint32_t> CreateSobolDirections()
+    {
+        std::vector<std::uint32_t> directions(SOBOL_DIMENSIONS * SOBOL_BITS);
+        // the first dimension is the van der Corput sequence, the second uses the primitive polynomial x + 1 (s = 1, a = 0, m_1 = 1).
+        for (std::size_t i = 0; i < SOBOL_BITS; ++i) { directions[i] = 1U << (SOBOL_BITS - 1 - i); }
+        directions[SOBOL_BITS] = 1U << (SOBOL_BITS - 1);
+        for (std::size_t i = 1; i < SOBOL_BITS; ++i) { directions[SOBOL_BITS + i] = directions[SOBOL_BITS + i - 1] ^ (directions[SOBOL_BITS + i - 1] >> 1); }
+        return directions;
+    }
+
+    std::vector<std::uint32_t> CreateBlueNoise(std::uint32_t seed)
+    {
+        const auto kernel = CreateEnergyKernel();
+        std::mt19937 rng{seed};
+
+        // initial binary pattern: random pixels, relaxed by moving the tightest cluster to the largest void until it is stable.
+        BinaryPattern prototype{kernel};
+        std::vector<std::size_t> pixels(BLUE_NOISE_PIXELS);
+        std::iota(pixels.begin(), pixels.end(), std::size_t{0});
+        std::shuffle(pixels.begin(), pixels.end(), rng);
+        const auto numInitial = BLUE_NOISE_PIXELS / BLUE_NOISE_INITIAL_DIVISOR;
+        for (std::size_t i = 0; i < numInitial; ++i) { prototype.Set(pixels[i], true); }
+        for (;;) {
+            const auto cluster = prototype.TightestCluster();
+            prototype.Set(cluster, false);
+            const auto largestVoid = prototype.LargestVoid();
+            prototype.Set(largestVoid, true);
+            if (largestVoid == cluster) { break; }
+        }
+
+        std::vector<std::uint32_t> ranks(BLUE_NOISE_PIXELS);
+        // phase 1: ranks of the initial pattern by removing its tightest clusters.
+        {
+            auto pattern = prototype;
+            for (auto rank = numInitial; rank > 0; --rank) {
+                const auto cluster = pattern.TightestCluster();
+                pattern.Set(cluster, false);
+                ranks[cluster] = static_cast<std::uint32_t>(rank - 1);
+            }
+        }
+        // phase 2 and 3: fill the largest voids, past half of the pixels this removes the tightest clusters of unset pixels.
+        for (auto rank = numInitial; rank < BLUE_NOISE_PIXELS; ++rank) {
+            const auto largestVoid = prototype.LargestVoid();
+            prototype.Set(largestVoid, true);
+            ranks[largestVoid] = static_cast<std::uint32_t>(rank);
+        }
+        return ranks;
+    }
+
+    std::vector<std::uint32_t> CreateSamplerTables()
+    {
+        auto tables = CreateSobolDirections();
+        tables.resize(BLUE_NOISE_OFFSET + BLUE_NOISE_PIXELS);
+
+        // two independent channels for 2D samples.
+        const auto blueNoiseX = CreateBlueNoise(0x5eed0001U);
+        const auto blueNoiseY = CreateBlueNoise(0x5eed0002U);
+        for (std::size_t i = 0; i < BLUE_NOISE_PIXELS; ++i) { tables[BLUE_NOISE_OFFSET + i] = blueNoiseX[i] | (blueNoiseY[i] << 16U); }
+        return tables;
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * @file   TriangleOpacity.cpp
+ * @author Sebastian Maisch <sebastian.maisch@googlemail.com>
+ * @date   2026.10.17
+ *
+ * @brief  Implementation of the triangle opacity classification.
+ */
+
+#include "gfx/TriangleOpacity.h"
+#include "main.h"
+#include "gfx/Material.h"
+#include "gfx/meshes/MeshInfo.h"
+
+#include <core/resources/Resource.h>
+
+#include <stb_image.h>
+
+#include <glm/common.hpp>
+
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <memory>
+
+namespace vkfw_app::gfx {
+
+    namespace {
+        using OpacityClass = scene::rt::TriangleOpacityClass;
+
+        constexpr std::uint32_t OPAQUE_CLASS = static_cast<std::uint32_t>(OpacityClass::TriangleOpaque);
+        constexpr std::uint32_t TRANSPARENT_CLASS = static_cast<std::uint32_t>(OpacityClass::TriangleTransparent);
+        constexpr std::uint32_t MIXED_CLASS = static_cast<std::uint32_t>(OpacityClass::TriangleMixed);
+        constexpr std::uint32_t OPACITY_BITS = static_cast<std::uint32_t>(OpacityClass::TriangleOpacityBits);
+        constexpr std::uint32_t TRIANGLES_PER_WORD = static_cast<std::uint32_t>(OpacityClass::TrianglesPerOpacityWord);
+        /** Texels below this alpha may become 0 by block compression, they are neither opaque nor transparent. */
+        constexpr std::uint8_t MIN_OPAQUE_ALPHA = 16;
+        /** Triangles with a footprint larger than this many copies of the texture (heavy tiling) get the class of the whole texture. */
+        constexpr float MAX_FOOTPRINT_TILES = 4.0f;
+
+        std::uint32_t ClassifyAlpha(std::uint8_t alpha)
+        {
+            if (alpha == 0) { return TRANSPARENT_CLASS; }
+            return alpha >= MIN_OPAQUE_ALPHA ? OPAQUE_CLASS : MIXED_CLASS;
+        }
+
+        std::uint32_t CombineClasses(std::uint32_t a, std::uint32_t b) { return a == b ? a : MIXED_CLASS; }
+
+        std::unique_ptr<AlphaMask> LoadAlphaMask(const std::string& textureFilename)
+        {
+            auto filename = std::filesystem::path{vkfw_core::Resource::FindResourceLocation(textureFilename)};
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> image{stbi_load(filename.string().c_str(), &width, &height, &channels, STBI_rgb_alpha), &stbi_image_free};
+            if (!image) {
+                // the alpha test in the any hit shaders stays correct without a classification.
+                spdlog::warn("Could not load texture {} for opacity classification: {}.", textureFilename, stbi_failure_reason());
+                return nullptr;
+            }
+
+            std::vector<std::uint8_t> alpha(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+            for (std::size_t i = 0; i < alpha.size(); ++i) { alpha[i] = image.get()[4 * i + 3]; }
+            return std::make_unique<AlphaMask>(CreateAlphaMask(width, height, std::move(alpha)));
+        }
+    }
+
+    AlphaMask CreateAlphaMask(std::int64_t width, std::int64_t height, std::vector<std::uint8_t> alpha)
+    {
+        AlphaMask mask;
+        mask.m_width = width;
+        mask.m_height = height;
+        mask.m_alpha = std::move(alpha);
+        mask.m_textureClass = mask.m_alpha.empty() ? MIXED_CLASS : ClassifyAlpha(mask.m_alpha[0]);
+        for (auto texelAlpha : mask.m_alpha) {
+            mask.m_textureClass = CombineClasses(mask.m_textureClass, ClassifyAlpha(texelAlpha));
+            if (mask.m_textureClass == MIXED_CLASS) { break; }
+        }
+        return mask;
+    }
+
+    std::uint32_t ClassifyTriangle(const AlphaMask& mask, const std::array<glm::vec2, 3>& texCoords)
+    {
+        if (mask.m_textureClass != MIXED_CLASS) { return mask.m_textureClass; }
+
+        // texel space with the texel centers at integer coordinates.
+        const glm::vec2 size{static_cast<float>(mask.m_width), static_cast<float>(mask.m_height)};
+        std::array<glm::vec2, 3> p;
+        for (std::size_t i = 0; i < 3; ++i) { p[i] = texCoords[i] * size - 0.5f; }
+        auto minP = glm::min(glm::min(p[0], p[1]), p[2]);
+        auto maxP = glm::max(glm::max(p[0], p[1]), p[2]);
+        if ((maxP.x - minP.x + 2.0f) * (maxP.y - minP.y + 2.0f) > MAX_FOOTPRINT_TILES * size.x * size.y) { return mask.m_textureClass; }
+
+        auto cross = [](const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; };
+        const float orientation = cross(p[1] - p[0], p[2] - p[0]) < 0.0f ? -1.0f : 1.0f;
+        // conservative edge tests: a texel counts if the square reaching one texel around its center (half a texel of its own
+        // extent, half a texel of the bilinear filter) overlaps the triangle. Degenerate triangles touch a strip around their line.
+        auto touches = [&p, &cross, orientation](const glm::vec2& q) {
+            for (std::size_t i = 0; i < 3; ++i) {
+                auto edge = p[(i + 1) % 3] - p[i];
+                if (orientation * cross(edge, q - p[i]) + std::abs(edge.x) + std::abs(edge.y) < 0.0f) { return false; }
+            }
+            return true;
+        };
+
+        std::uint32_t result = 0;
+        bool first = true;
+        const auto y0 = static_cast<std::int64_t>(std::floor(minP.y)) - 1;
+        const auto y1 = static_cast<std::int64_t>(std::ceil(maxP.y)) + 1;
+        const auto x0 = static_cast<std::int64_t>(std::floor(minP.x)) - 1;
+        const auto x1 = static_cast<std::int64_t>(std::ceil(maxP.x)) + 1;
+        for (auto y = y0; y <= y1; ++y) {
+            for (auto x = x0; x <= x1; ++x) {
+                if (!touches(glm::vec2{static_cast<float>(x), static_cast<float>(y)})) { continue; }
+                auto texelClass = ClassifyAlpha(mask.GetWrapped(x, y));
+                result = first ? texelClass : CombineClasses(result, texelClass);
+                first = false;
+                if (result == MIXED_CLASS) { return result; }
+            }
+        }
+        return first ? MIXED_CLASS : result;
+    }
+
+    TriangleOpacity ClassifyTriangleOpacity(const vkfw_core::gfx::MeshInfo& mesh)
+    {
+        const auto& indices = mesh.GetIndices();
+        const std::size_t numTriangles = indices.size() / 3;
+
+        TriangleOpacity result;
+        result.m_classes.resize((numTriangles + TRIANGLES_PER_WORD - 1) / TRIANGLES_PER_WORD, 0);
+        auto setClass = [&result](std::size_t triangle, std::uint32_t opacityClass) {
+            result.m_classes[triangle / TRIANGLES_PER_WORD] |= opacityClass << (OPACITY_BITS * (triangle % TRIANGLES_PER_WORD));
+            result.m_counts[opacityClass] += 1;
+        };
+
+        // sub meshes often share their textures.
+        std::map<std::string, std::unique_ptr<AlphaMask>> alphaMasks;
+        for (const auto& subMesh : mesh.GetSubMeshes()) {
+            const std::size_t firstTriangle = subMesh.GetIndexOffset() / 3;
+            const std::size_t subMeshTriangles = subMesh.GetNumberOfIndices() / 3;
+
+            const AlphaMask* mask = nullptr;
+            bool alphaTested = false;
+            const auto* material = mesh.GetMaterial(subMesh.GetMaterialID());
+            if (material != nullptr && material->m_materialIdentifier == vkfw_core::gfx::PhongBumpMaterialInfo::MATERIAL_ID && !mesh.GetTexCoords().empty()) {
+                const auto& diffuseTexture = static_cast<const vkfw_core::gfx::PhongBumpMaterialInfo*>(material)->m_diffuseTextureFilename;
+                alphaTested = !diffuseTexture.empty();
+                if (alphaTested) {
+                    auto& alphaMask = alphaMasks[diffuseTexture];
+                    if (!alphaMask) { alphaMask = LoadAlphaMask(diffuseTexture); }
+                    mask = alphaMask.get();
+                }
+            }
+
+            for (std::size_t triangle = firstTriangle; triangle < firstTriangle + subMeshTriangles; ++triangle) {
+                if (!alphaTested) {
+                    setClass(triangle, OPAQUE_CLASS);
+                } else if (mask == nullptr) {
+                    setClass(triangle, MIXED_CLASS);
+                } else {
+                    const auto& texCoords = mesh.GetTexCoords()[0];
+                    setClass(triangle, ClassifyTriangle(*mask, {texCoords[indices[3 * triangle]], texCoords[indices[3 * triangle + 1]], texCoords[indices[3 * triangle + 2]]}));
+                }
+            }
+        }
+        return result;
+    }
+}
@@ -11,6 +11,11 @@
 #include "rt/rt_sample_host_interface.h"
 #include "gfx/meshes/MeshInfo.h"
 
+#include <glm/common.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <cmath>
+
 namespace mesh_sample {
 
     vk::VertexInputBindingDescription SimpleVertex::m_bindingDescription{0, sizeof(SimpleVertex), vk::VertexInputRate::eVertex};
@@ -42,4 +47,37 @@ namespace vkfw_app::scene::rt {
     {
     }
 
+    namespace {
+        /** Octahedral encoding of a unit vector, decoded by decodeOctahedralNormal in the shaders. */
+        std::uint32_t EncodeOctahedralNormal(const glm::vec3& normal)
+        {
+            auto l1Norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+            if (l1Norm == 0.0f) { return glm::packSnorm2x16(glm::vec2{0.0f}); }
+            auto n = normal / l1Norm;
+            glm::vec2 encoded{n.x, n.y};
+            if (n.z < 0.0f) {
+                encoded = (1.0f - glm::abs(glm::vec2{n.y, n.x})) * glm::vec2{n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f};
+            }
+            return glm::packSnorm2x16(encoded);
+        }
+    }
+
+    vk::VertexInputBindingDescription CompactRayTracingVertex::m_bindingDescription{0, sizeof(CompactRayTracingVertex), vk::VertexInputRate::eVertex};
+    std::array<vk::VertexInputAttributeDescription, 3> CompactRayTracingVertex::m_attributeDescriptions{
+        {{0, 0, vk::Format::eR32G32B32Sfloat, offsetof(CompactRayTracingVertex, position)},
+         {1, 0, vk::Format::eR16G16Snorm, offsetof(CompactRayTracingVertex, normal)},
+         {2, 0, vk::Format::eR16G16Sfloat, offsetof(CompactRayTracingVertex, texCoords)}}};
+
+    CompactRayTracingVertex::CompactRayTracingVertex(const vkfw_core::gfx::MeshInfo* mi, std::size_t index)
+        : position{mi->GetVertices()[index]}
+        , normal{EncodeOctahedralNormal(mi->GetNormals()[index])}
+        , texCoords{glm::packHalf2x16(mi->GetTexCoords()[0][index])}
+    {
+    }
+
+    CompactRayTracingVertex::CompactRayTracingVertex(const RayTracingVertex& vertex)
+        : position{vertex.position}, normal{EncodeOctahedralNormal(vertex.normal)}, texCoords{glm::packHalf2x16(vertex.texCoords)}
+    {
+    }
+
 }
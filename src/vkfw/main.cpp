@@ -9,17 +9,28 @@
 #include "main.h"
 #include "app_constants.h"
 #include "app/FWApplication.h"
+#include "app/HeadlessBenchmark.h"
+#include "core/Timeline.h"
+#include "core/AsyncLogSink.h"
 
 #include <core/spdlog/sinks/filesink.h>
 #include <spdlog/sinks/basic_file_sink.h>
-#include <spdlog/async.h>
 #include <spdlog/sinks/msvc_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
 
-int main(int /* argc */, const char** /* argv */)
+int main(int argc, const char** argv)
 {
+    vkfw_app::BenchmarkSettings benchmarkSettings;
+    bool runBenchmark = false;
+    try {
+        runBenchmark = vkfw_app::BenchmarkSettings::ParseCommandLine(argc, argv, benchmarkSettings);
+    } catch (const std::exception& ex) {
+        std::cerr << "Could not parse command line: " << ex.what() << std::endl;
+        return 1;
+    }
+
     try {
         constexpr std::string_view directory = "";
         constexpr std::string_view name = vkfw_app::logFileName;
@@ -43,8 +54,9 @@ int main(int /* argc */, const char** /* argv */)
             file_sink->set_level(spdlog::level::trace);
         }
 
-        spdlog::sinks_init_list sink_list = {file_sink, console_sink, devenv_sink};
-        auto logger = std::make_shared<spdlog::logger>(vkfw_app::logTag.data(), sink_list.begin(), sink_list.end());
+        // the sinks block on I/O, they are only written by the background thread of the asynchronous sink.
+        auto async_sink = std::make_shared<vkfw_app::core::AsyncLogSink>(std::vector<spdlog::sink_ptr>{file_sink, console_sink, devenv_sink});
+        auto logger = std::make_shared<spdlog::logger>(vkfw_app::logTag.data(), async_sink);
 
         spdlog::set_default_logger(logger);
         spdlog::flush_on(spdlog::level::err);
@@ -62,6 +74,25 @@ int main(int /* argc */, const char** /* argv */)
         return 0;
     }
 
+    auto& timeline = vkfw_app::core::Timeline::Instance();
+    timeline.SetEnabled(!benchmarkSettings.m_traceFile.empty());
+
+    if (runBenchmark) {
+        try {
+            vkfw_app::HeadlessBenchmark benchmark{benchmarkSettings};
+            spdlog::debug("Starting headless benchmark.");
+            benchmark.Run();
+            spdlog::debug("Headless benchmark ended.");
+            if (timeline.IsEnabled()) { timeline.WriteChromeTrace(benchmarkSettings.m_traceFile); }
+        } catch (const std::exception& e) {
+            spdlog::critical("Could not run headless benchmark: {}\nExiting.", e.what());
+            spdlog::shutdown();
+            return 1;
+        }
+        spdlog::shutdown();
+        return 0;
+    }
+
     vkfw_app::FWApplication app;
 
     spdlog::debug("Starting main loop.");
@@ -78,6 +109,9 @@ int main(int /* argc */, const char** /* argv */)
     }
     app.EndRun();
     spdlog::debug("Main loop ended.");
+    if (timeline.IsEnabled()) { timeline.WriteChromeTrace(benchmarkSettings.m_traceFile); }
 
+    // stops the background thread of the log after writing all buffered messages.
+    spdlog::shutdown();
     return 0;
 }
@@ -0,0 +1,139 @@
+#include <catch2/catch.hpp>
+
+#include "core/AsyncLogSink.h"
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using vkfw_app::core::AsyncLogSink;
+
+namespace {
+  /** Records the logger names and payloads of all messages it receives. */
+  class CollectingSink : public spdlog::sinks::base_sink<std::mutex>
+  {
+  public:
+    std::vector<std::string> GetPayloads()
+    {
+      std::scoped_lock lock{mutex_};
+      return m_payloads;
+    }
+
+    std::vector<std::string> GetLoggerNames()
+    {
+      std::scoped_lock lock{mutex_};
+      return m_loggerNames;
+    }
+
+    std::size_t GetFlushes()
+    {
+      std::scoped_lock lock{mutex_};
+      return m_flushes;
+    }
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override
+    {
+      m_loggerNames.emplace_back(msg.logger_name.data(), msg.logger_name.size());
+      m_payloads.emplace_back(msg.payload.data(), msg.payload.size());
+    }
+
+    void flush_() override { m_flushes += 1; }
+
+  private:
+    std::vector<std::string> m_loggerNames;
+    std::vector<std::string> m_payloads;
+    std::size_t m_flushes = 0;
+  };
+
+  std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name, const std::shared_ptr<AsyncLogSink>& sink)
+  {
+    auto logger = std::make_shared<spdlog::logger>(name, sink);
+    logger->set_level(spdlog::level::trace);
+    return logger;
+  }
+}
+
+TEST_CASE("AsyncLogSink keeps the order of the messages of a thread", "[async_log_sink]")
+{
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<AsyncLogSink>(std::vector<spdlog::sink_ptr>{target});
+  auto logger = CreateLogger("order", sink);
+
+  // more messages than a ring buffer holds, so the overflow queue is used.
+  constexpr std::size_t numMessages = 4 * AsyncLogSink::MESSAGES_PER_THREAD;
+  for (std::size_t i = 0; i < numMessages; ++i) { logger->info("{}", i); }
+  sink->flush();
+
+  auto payloads = target->GetPayloads();
+  REQUIRE(payloads.size() == numMessages);
+  for (std::size_t i = 0; i < numMessages; ++i) { REQUIRE(payloads[i] == std::to_string(i)); }
+}
+
+TEST_CASE("AsyncLogSink loses no messages of concurrent threads", "[async_log_sink]")
+{
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<AsyncLogSink>(std::vector<spdlog::sink_ptr>{target});
+  auto logger = CreateLogger("threads", sink);
+
+  constexpr std::size_t numThreads = 4;
+  constexpr std::size_t numMessages = 2 * AsyncLogSink::MESSAGES_PER_THREAD;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&logger, t]() {
+      for (std::size_t i = 0; i < numMessages; ++i) { logger->info("{} {}", t, i); }
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+  sink->flush();
+
+  auto payloads = target->GetPayloads();
+  REQUIRE(payloads.size() == numThreads * numMessages);
+  std::vector<std::size_t> nextMessage(numThreads, 0);
+  for (const auto& payload : payloads) {
+    auto separator = payload.find(' ');
+    auto thread = std::stoul(payload.substr(0, separator));
+    REQUIRE(payload.substr(separator + 1) == std::to_string(nextMessage[thread]));
+    nextMessage[thread] += 1;
+  }
+}
+
+TEST_CASE("AsyncLogSink writes and flushes all messages on destruction", "[async_log_sink]")
+{
+  auto target = std::make_shared<CollectingSink>();
+  {
+    auto sink = std::make_shared<AsyncLogSink>(std::vector<spdlog::sink_ptr>{target});
+    auto logger = CreateLogger("destruct", sink);
+    for (int i = 0; i < 100; ++i) { logger->warn("{}", i); }
+  }
+
+  REQUIRE(target->GetPayloads().size() == 100);
+  REQUIRE(target->GetFlushes() >= 1);
+}
+
+TEST_CASE("AsyncLogSink does not shorten long messages", "[async_log_sink]")
+{
+  auto target = std::make_shared<CollectingSink>();
+  auto sink = std::make_shared<AsyncLogSink>(std::vector<spdlog::sink_ptr>{target});
+  const std::string loggerName(64, 'n');
+  auto logger = CreateLogger(loggerName, sink);
+
+  // sizes around the end of the text that fits into a slot together with the logger name.
+  std::vector<std::string> messages;
+  for (std::size_t size : {0, 100, 150, 151, 152, 153, 154, 256, 10000}) {
+    std::string message;
+    for (std::size_t i = 0; i < size; ++i) { message += static_cast<char>('a' + i % 26); }
+    messages.push_back(message);
+  }
+  for (const auto& message : messages) { logger->error("{}", message); }
+  sink->flush();
+
+  REQUIRE(target->GetPayloads() == messages);
+  for (const auto& name : target->GetLoggerNames()) { REQUIRE(name == loggerName); }
+}
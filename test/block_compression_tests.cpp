@@ -0,0 +1,176 @@
+#include <catch2/catch.hpp>
+
+#include "gfx/BlockCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using vkfw_app::gfx::BlockFormat;
+using vkfw_app::gfx::CompressImage;
+
+namespace {
+  constexpr std::uint32_t IMAGE_SIZE = 32;
+
+  // reference decoders following the format specification, independent of the encoder.
+  std::array<int, 3> Unpack565(std::uint16_t c)
+  {
+    int r = (c >> 11) & 0x1F;
+    int g = (c >> 5) & 0x3F;
+    int b = c & 0x1F;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+  }
+
+  std::array<std::array<int, 3>, 16> DecodeBC1Block(const std::byte* block)
+  {
+    std::uint16_t color0 = 0;
+    std::uint16_t color1 = 0;
+    std::uint32_t indices = 0;
+    std::memcpy(&color0, block, 2);
+    std::memcpy(&color1, block + 2, 2);
+    std::memcpy(&indices, block + 4, 4);
+    auto c0 = Unpack565(color0);
+    auto c1 = Unpack565(color1);
+    std::array<std::array<int, 3>, 4> palette{c0, c1};
+    for (std::size_t c = 0; c < 3; ++c) {
+      if (color0 > color1) {
+        palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+        palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+      } else {
+        palette[2][c] = (c0[c] + c1[c]) / 2;
+        palette[3][c] = 0;
+      }
+    }
+    std::array<std::array<int, 3>, 16> texels{};
+    for (std::size_t i = 0; i < 16; ++i) { texels[i] = palette[(indices >> (2 * i)) & 0x3]; }
+    return texels;
+  }
+
+  std::array<int, 16> DecodeBC4Block(const std::byte* block)
+  {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, block, 8);
+    int value0 = static_cast<int>(bits & 0xFF);
+    int value1 = static_cast<int>((bits >> 8) & 0xFF);
+    std::array<int, 8> palette{value0, value1};
+    if (value0 > value1) {
+      for (int i = 2; i < 8; ++i) { palette[static_cast<std::size_t>(i)] = ((8 - i) * value0 + (i - 1) * value1) / 7; }
+    } else {
+      for (int i = 2; i < 6; ++i) { palette[static_cast<std::size_t>(i)] = ((6 - i) * value0 + (i - 1) * value1) / 5; }
+      palette[6] = 0;
+      palette[7] = 255;
+    }
+    std::array<int, 16> texels{};
+    for (std::size_t i = 0; i < 16; ++i) { texels[i] = palette[(bits >> (16 + 3 * i)) & 0x7]; }
+    return texels;
+  }
+
+  /** Returns the largest absolute error of a channel over the image. */
+  template<class DecodeTexel>
+  int MaxError(const std::vector<std::uint8_t>& rgba, std::size_t channel, std::size_t blockSize, const std::vector<std::byte>& compressed, DecodeTexel decode)
+  {
+    const std::uint32_t blocksX = IMAGE_SIZE / 4;
+    int maxError = 0;
+    for (std::uint32_t y = 0; y < IMAGE_SIZE; ++y) {
+      for (std::uint32_t x = 0; x < IMAGE_SIZE; ++x) {
+        const auto* block = compressed.data() + ((y / 4) * blocksX + x / 4) * blockSize;
+        auto decoded = decode(block, (y % 4) * 4 + x % 4);
+        maxError = std::max(maxError, std::abs(decoded - static_cast<int>(rgba[4 * (y * IMAGE_SIZE + x) + channel])));
+      }
+    }
+    return maxError;
+  }
+
+  /** A smooth image: a different linear ramp per channel. */
+  std::vector<std::uint8_t> CreateGradientImage()
+  {
+    std::vector<std::uint8_t> rgba(4 * IMAGE_SIZE * IMAGE_SIZE);
+    for (std::uint32_t y = 0; y < IMAGE_SIZE; ++y) {
+      for (std::uint32_t x = 0; x < IMAGE_SIZE; ++x) {
+        auto* texel = &rgba[4 * (y * IMAGE_SIZE + x)];
+        texel[0] = static_cast<std::uint8_t>(x * 8);
+        texel[1] = static_cast<std::uint8_t>(y * 8);
+        texel[2] = static_cast<std::uint8_t>(255 - x * 4);
+        texel[3] = static_cast<std::uint8_t>((x + y) * 4);
+      }
+    }
+    return rgba;
+  }
+
+  std::vector<std::uint8_t> CreateConstantImage(std::array<std::uint8_t, 4> color)
+  {
+    std::vector<std::uint8_t> rgba(4 * IMAGE_SIZE * IMAGE_SIZE);
+    for (std::size_t i = 0; i < rgba.size(); i += 4) { std::memcpy(&rgba[i], color.data(), 4); }
+    return rgba;
+  }
+
+  int MaxBC1Error(const std::vector<std::uint8_t>& rgba)
+  {
+    auto compressed = CompressImage(BlockFormat::BC1, rgba.data(), IMAGE_SIZE, IMAGE_SIZE);
+    REQUIRE(compressed.size() == (IMAGE_SIZE / 4) * (IMAGE_SIZE / 4) * 8);
+    int maxError = 0;
+    for (std::size_t c = 0; c < 3; ++c) {
+      maxError = std::max(maxError, MaxError(rgba, c, 8, compressed, [c](const std::byte* block, std::size_t i) { return DecodeBC1Block(block)[i][c]; }));
+    }
+    return maxError;
+  }
+
+  int MaxBC4Error(const std::vector<std::uint8_t>& rgba)
+  {
+    auto compressed = CompressImage(BlockFormat::BC4, rgba.data(), IMAGE_SIZE, IMAGE_SIZE);
+    REQUIRE(compressed.size() == (IMAGE_SIZE / 4) * (IMAGE_SIZE / 4) * 8);
+    return MaxError(rgba, 0, 8, compressed, [](const std::byte* block, std::size_t i) { return DecodeBC4Block(block)[i]; });
+  }
+
+  int MaxBC5Error(const std::vector<std::uint8_t>& rgba)
+  {
+    auto compressed = CompressImage(BlockFormat::BC5, rgba.data(), IMAGE_SIZE, IMAGE_SIZE);
+    REQUIRE(compressed.size() == (IMAGE_SIZE / 4) * (IMAGE_SIZE / 4) * 16);
+    return std::max(MaxError(rgba, 0, 16, compressed, [](const std::byte* block, std::size_t i) { return DecodeBC4Block(block)[i]; }),
+                    MaxError(rgba, 1, 16, compressed, [](const std::byte* block, std::size_t i) { return DecodeBC4Block(block + 8)[i]; }));
+  }
+}
+
+TEST_CASE("BC1 stays within the RGB565 quantization error for constant blocks", "[block_compression]")
+{
+  REQUIRE(MaxBC1Error(CreateConstantImage({200, 100, 50, 255})) <= 4);
+  REQUIRE(MaxBC1Error(CreateConstantImage({0, 0, 0, 255})) == 0);
+  REQUIRE(MaxBC1Error(CreateConstantImage({255, 255, 255, 255})) == 0);
+}
+
+TEST_CASE("BC1 error is bounded for smooth gradients", "[block_compression]")
+{
+  std::vector<std::uint8_t> grayRamp(4 * IMAGE_SIZE * IMAGE_SIZE);
+  for (std::uint32_t i = 0; i < IMAGE_SIZE * IMAGE_SIZE; ++i) {
+    auto value = static_cast<std::uint8_t>((i % IMAGE_SIZE) * 8);
+    grayRamp[4 * i] = grayRamp[4 * i + 1] = grayRamp[4 * i + 2] = value;
+    grayRamp[4 * i + 3] = 255;
+  }
+  REQUIRE(MaxBC1Error(grayRamp) <= 8);
+  // the bounding box diagonal cannot follow channels that change along different axes.
+  REQUIRE(MaxBC1Error(CreateGradientImage()) <= 20);
+}
+
+TEST_CASE("BC4 is exact for constant blocks and bounded for gradients", "[block_compression]")
+{
+  REQUIRE(MaxBC4Error(CreateConstantImage({137, 0, 0, 255})) == 0);
+  // the red ramp spans 24 values per block, eight palette entries leave at most half a step.
+  REQUIRE(MaxBC4Error(CreateGradientImage()) <= 3);
+}
+
+TEST_CASE("BC5 encodes red and green independently", "[block_compression]")
+{
+  REQUIRE(MaxBC5Error(CreateConstantImage({17, 230, 0, 255})) == 0);
+  REQUIRE(MaxBC5Error(CreateGradientImage()) <= 3);
+}
+
+TEST_CASE("Block compression clamps partial blocks at the image border", "[block_compression]")
+{
+  const std::array<std::uint8_t, 4 * 3> rgba{10, 20, 30, 255, 10, 20, 30, 255, 10, 20, 30, 255};
+  auto compressed = CompressImage(BlockFormat::BC4, rgba.data(), 3, 1);
+  REQUIRE(compressed.size() == 8);
+  for (auto value : DecodeBC4Block(compressed.data())) { REQUIRE(value == 10); }
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+
+#include "gfx/LightSampler.h"
+
+#include <cstdint>
+#include <vector>
+
+using vkfw_app::gfx::EmissiveTriangle;
+using vkfw_app::gfx::LightSampler;
+
+namespace {
+  /** A right triangle with the given leg length (area legLength^2 / 2). */
+  EmissiveTriangle CreateTriangle(float legLength, const glm::vec3& Le)
+  {
+    return EmissiveTriangle{{glm::vec3{0.0f}, glm::vec3{legLength, 0.0f, 0.0f}, glm::vec3{0.0f, legLength, 0.0f}}, Le};
+  }
+
+  /** The probability of every triangle being selected: a uniform bucket, then the bucket or its alias. */
+  std::vector<double> SelectionProbabilities(const LightSampler& sampler)
+  {
+    const auto& aliasTable = sampler.GetAliasTable();
+    const auto n = static_cast<double>(aliasTable.size());
+    std::vector<double> probabilities(aliasTable.size(), 0.0);
+    for (std::size_t i = 0; i < aliasTable.size(); ++i) {
+      probabilities[i] += static_cast<double>(aliasTable[i].probability) / n;
+      probabilities[aliasTable[i].alias] += (1.0 - static_cast<double>(aliasTable[i].probability)) / n;
+    }
+    return probabilities;
+  }
+}
+
+TEST_CASE("LightSampler alias table selects triangles proportional to their power", "[light_sampler]")
+{
+  const glm::vec3 white{1.0f};
+  // powers 2, 8, 0.5, 18 and 0 (luminance times area).
+  const std::vector<EmissiveTriangle> triangles{CreateTriangle(2.0f, white), CreateTriangle(4.0f, white), CreateTriangle(1.0f, white),
+                                                CreateTriangle(6.0f, white), CreateTriangle(3.0f, glm::vec3{0.0f})};
+  const std::vector<double> powers{2.0, 8.0, 0.5, 18.0, 0.0};
+  const double totalPower = 28.5;
+
+  LightSampler sampler{triangles};
+  REQUIRE(sampler.GetNumLightTriangles() == triangles.size());
+  REQUIRE(sampler.GetLightTriangles().size() == triangles.size());
+  REQUIRE(sampler.GetAliasTable().size() == triangles.size());
+
+  const auto probabilities = SelectionProbabilities(sampler);
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    REQUIRE(sampler.GetAliasTable()[i].alias < triangles.size());
+    REQUIRE(sampler.GetAliasTable()[i].probability >= 0.0f);
+    REQUIRE(sampler.GetAliasTable()[i].probability <= 1.0f + 1e-6f);
+    REQUIRE(probabilities[i] == Approx(powers[i] / totalPower).margin(1e-6));
+    // the shaders divide by the pdf stored with the triangle, it has to match the table.
+    REQUIRE(sampler.GetLightTriangles()[i].selectionPdf == Approx(probabilities[i]).margin(1e-6));
+  }
+  REQUIRE(sampler.GetLightTriangles()[1].area == Approx(8.0f));
+}
+
+TEST_CASE("LightSampler alias table is uniform for equal powers", "[light_sampler]")
+{
+  const std::vector<EmissiveTriangle> triangles(7, CreateTriangle(1.0f, glm::vec3{2.0f, 1.0f, 0.5f}));
+  LightSampler sampler{triangles};
+  for (auto probability : SelectionProbabilities(sampler)) { REQUIRE(probability == Approx(1.0 / 7.0).margin(1e-6)); }
+}
+
+TEST_CASE("LightSampler without emitters disables light sampling", "[light_sampler]")
+{
+  const std::vector<EmissiveTriangle> triangles{CreateTriangle(1.0f, glm::vec3{0.0f})};
+  LightSampler sampler{triangles};
+  REQUIRE(sampler.GetNumLightTriangles() == 0);
+  // the buffers still need one entry each for the descriptors.
+  REQUIRE(sampler.GetLightTriangles().size() == 1);
+  REQUIRE(sampler.GetAliasTable().size() == 1);
+
+  LightSampler emptySampler{std::vector<EmissiveTriangle>{}};
+  REQUIRE(emptySampler.GetNumLightTriangles() == 0);
+  REQUIRE(emptySampler.GetAliasTable().size() == 1);
+}
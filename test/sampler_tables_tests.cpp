@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include "gfx/SamplerTables.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <set>
+#include <vector>
+
+using SamplerTableLayout = vkfw_app::scene::rt::SamplerTableLayout;
+
+namespace {
+  constexpr std::uint32_t SOBOL_BITS = static_cast<std::uint32_t>(SamplerTableLayout::SobolBits);
+
+  std::uint32_t ReverseBits(std::uint32_t x)
+  {
+    std::uint32_t result = 0;
+    for (std::uint32_t i = 0; i < 32; ++i, x >>= 1) { result = (result << 1) | (x & 1); }
+    return result;
+  }
+
+  // CPU copies of sobol() and nestedUniformScramble() in resources/shader/rt/sampleGenerator.glsl.
+  std::uint32_t Sobol(const std::vector<std::uint32_t>& directions, std::uint32_t index, std::uint32_t dim)
+  {
+    std::uint32_t x = 0;
+    for (std::uint32_t bit = 0; index != 0; ++bit, index >>= 1) {
+      if ((index & 1) != 0) { x ^= directions[dim * SOBOL_BITS + bit]; }
+    }
+    return x;
+  }
+
+  std::uint32_t NestedUniformScramble(std::uint32_t x, std::uint32_t seed)
+  {
+    x = ReverseBits(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return ReverseBits(x);
+  }
+
+  struct Point
+  {
+    std::uint32_t x;
+    std::uint32_t y;
+  };
+
+  std::vector<Point> OwenScrambledSobol(const std::vector<std::uint32_t>& directions, std::uint32_t count, std::uint32_t seed)
+  {
+    std::vector<Point> points;
+    for (std::uint32_t i = 0; i < count; ++i) {
+      auto index = NestedUniformScramble(i, seed);
+      points.push_back(Point{NestedUniformScramble(Sobol(directions, index, 0), seed ^ 0x9e3779b9u),
+                             NestedUniformScramble(Sobol(directions, index, 1), seed ^ 0x7f4a7c15u)});
+    }
+    return points;
+  }
+
+  /** Checks that every elementary interval of area 1 / points.size() contains exactly one point ((0, m, 2)-net). */
+  bool IsNet(const std::vector<Point>& points, std::uint32_t m)
+  {
+    for (std::uint32_t a = 0; a <= m; ++a) {
+      std::set<std::pair<std::uint32_t, std::uint32_t>> intervals;
+      for (const auto& p : points) {
+        auto ix = a == 0 ? 0 : p.x >> (32 - a);
+        auto iy = a == m ? 0 : p.y >> (32 - (m - a));
+        if (!intervals.emplace(ix, iy).second) { return false; }
+      }
+    }
+    return true;
+  }
+}
+
+TEST_CASE("Sobol direction numbers are deterministic and form (0, m, 2)-nets", "[sampler_tables]")
+{
+  const auto directions = vkfw_app::gfx::CreateSobolDirections();
+  REQUIRE(directions.size() == static_cast<std::size_t>(SamplerTableLayout::SobolDimensions) * SOBOL_BITS);
+  REQUIRE(directions == vkfw_app::gfx::CreateSobolDirections());
+
+  for (std::uint32_t m = 1; m <= 10; ++m) {
+    std::vector<Point> points;
+    for (std::uint32_t i = 0; i < (1u << m); ++i) { points.push_back(Point{Sobol(directions, i, 0), Sobol(directions, i, 1)}); }
+    REQUIRE(IsNet(points, m));
+  }
+}
+
+TEST_CASE("Owen scrambling is deterministic per seed and keeps the net property", "[sampler_tables]")
+{
+  const auto directions = vkfw_app::gfx::CreateSobolDirections();
+  constexpr std::uint32_t m = 8;
+
+  for (std::uint32_t seed : {0u, 1u, 0xdeadbeefu}) {
+    const auto points = OwenScrambledSobol(directions, 1u << m, seed);
+    const auto again = OwenScrambledSobol(directions, 1u << m, seed);
+    REQUIRE(std::equal(points.begin(), points.end(), again.begin(), [](const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; }));
+    for (std::uint32_t k = 1; k <= m; ++k) { REQUIRE(IsNet(std::vector<Point>(points.begin(), points.begin() + (1u << k)), k)); }
+  }
+
+  const auto seed0 = OwenScrambledSobol(directions, 16, 0);
+  const auto seed1 = OwenScrambledSobol(directions, 16, 1);
+  REQUIRE_FALSE(std::equal(seed0.begin(), seed0.end(), seed1.begin(), [](const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; }));
+}
+
+TEST_CASE("Blue noise masks are deterministic permutations of the ranks", "[sampler_tables]")
+{
+  constexpr std::size_t numPixels = static_cast<std::size_t>(SamplerTableLayout::BlueNoiseSize) * static_cast<std::size_t>(SamplerTableLayout::BlueNoiseSize);
+  const auto mask = vkfw_app::gfx::CreateBlueNoise(42);
+  REQUIRE(mask.size() == numPixels);
+  REQUIRE(mask == vkfw_app::gfx::CreateBlueNoise(42));
+  REQUIRE(mask != vkfw_app::gfx::CreateBlueNoise(43));
+
+  std::vector<std::uint32_t> ranks(numPixels);
+  std::iota(ranks.begin(), ranks.end(), 0u);
+  REQUIRE(std::is_permutation(mask.begin(), mask.end(), ranks.begin()));
+}
@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+
+#include "core/SPSCRingBuffer.h"
+
+#include <cstdint>
+#include <thread>
+
+using vkfw_app::core::SPSCRingBuffer;
+
+TEST_CASE("SPSCRingBuffer keeps FIFO order and rejects elements when full", "[spsc_ring_buffer]")
+{
+  SPSCRingBuffer<int, 4> buffer;
+  REQUIRE(buffer.Empty());
+  REQUIRE_FALSE(buffer.TryPop().has_value());
+
+  for (int i = 0; i < 4; ++i) { REQUIRE(buffer.TryPush(i)); }
+  REQUIRE(buffer.Size() == 4);
+  REQUIRE_FALSE(buffer.TryPush(4));
+
+  for (int i = 0; i < 4; ++i) {
+    auto element = buffer.TryPop();
+    REQUIRE(element.has_value());
+    REQUIRE(*element == i);
+  }
+  REQUIRE(buffer.Empty());
+}
+
+TEST_CASE("SPSCRingBuffer wraps around", "[spsc_ring_buffer]")
+{
+  SPSCRingBuffer<int, 4> buffer;
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(buffer.TryPush(i));
+    REQUIRE(buffer.TryPush(i + 100));
+    REQUIRE(*buffer.TryPop() == i);
+    REQUIRE(*buffer.TryPop() == i + 100);
+  }
+  REQUIRE(buffer.Empty());
+}
+
+TEST_CASE("SPSCRingBuffer transfers all elements between two threads in order", "[spsc_ring_buffer]")
+{
+  constexpr std::uint64_t count = 100000;
+  SPSCRingBuffer<std::uint64_t, 64> buffer;
+
+  std::thread producer{[&buffer]() {
+    for (std::uint64_t i = 0; i < count; ++i) {
+      while (!buffer.TryPush(i)) { std::this_thread::yield(); }
+    }
+  }};
+
+  std::uint64_t expected = 0;
+  bool inOrder = true;
+  while (expected < count) {
+    if (auto element = buffer.TryPop()) {
+      inOrder = inOrder && *element == expected;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  REQUIRE(inOrder);
+  REQUIRE(buffer.Empty());
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+
+#include "app/StressScene.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+using vkfw_app::scene::rt::GenerateStressInstances;
+using vkfw_app::scene::rt::StressInstance;
+using vkfw_app::scene::rt::StressLayout;
+using vkfw_app::scene::rt::StressMesh;
+using vkfw_app::scene::rt::StressSceneSettings;
+
+namespace {
+  StressSceneSettings CreateSettings(StressLayout layout, std::uint32_t seed)
+  {
+    StressSceneSettings settings;
+    settings.m_numTeapots = 1000;
+    settings.m_numSponzas = 10;
+    settings.m_layout = layout;
+    settings.m_seed = seed;
+    return settings;
+  }
+
+  bool AreEqual(const std::vector<StressInstance>& a, const std::vector<StressInstance>& b)
+  {
+    if (a.size() != b.size()) { return false; }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      if (a[i].m_mesh != b[i].m_mesh || a[i].m_worldMatrix != b[i].m_worldMatrix) { return false; }
+    }
+    return true;
+  }
+}
+
+TEST_CASE("Stress scenes are deterministic", "[stress_scene]")
+{
+  for (auto layout : {StressLayout::Grid, StressLayout::Scatter}) {
+    const auto first = GenerateStressInstances(CreateSettings(layout, 42));
+    const auto second = GenerateStressInstances(CreateSettings(layout, 42));
+    REQUIRE(first.size() == 1010);
+    REQUIRE(AreEqual(first, second));
+    REQUIRE_FALSE(AreEqual(first, GenerateStressInstances(CreateSettings(layout, 43))));
+  }
+}
+
+TEST_CASE("Stress scenes place the teapots before the Sponza instances", "[stress_scene]")
+{
+  const auto instances = GenerateStressInstances(CreateSettings(StressLayout::Grid, 1));
+  REQUIRE(instances.size() == 1010);
+  for (std::size_t i = 0; i < instances.size(); ++i) { REQUIRE(instances[i].m_mesh == (i < 1000 ? StressMesh::Teapot : StressMesh::Sponza)); }
+
+  StressSceneSettings empty;
+  REQUIRE(GenerateStressInstances(empty).empty());
+}
+
+TEST_CASE("Grid stress scenes give every instance its own cell", "[stress_scene]")
+{
+  const auto instances = GenerateStressInstances(CreateSettings(StressLayout::Grid, 1));
+  std::set<std::pair<float, float>> positions;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    const auto& translation = instances[i].m_worldMatrix[3];
+    REQUIRE(translation.y == 0.0f);
+    positions.emplace(translation.x, translation.z);
+  }
+  REQUIRE(positions.size() == 1000);
+}
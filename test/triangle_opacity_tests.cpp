@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include "gfx/TriangleOpacity.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using vkfw_app::gfx::AlphaMask;
+using vkfw_app::gfx::ClassifyTriangle;
+using vkfw_app::gfx::CreateAlphaMask;
+using OpacityClass = vkfw_app::scene::rt::TriangleOpacityClass;
+
+namespace {
+  constexpr std::int64_t MASK_SIZE = 16;
+  constexpr auto OPAQUE_CLASS = static_cast<std::uint32_t>(OpacityClass::TriangleOpaque);
+  constexpr auto TRANSPARENT_CLASS = static_cast<std::uint32_t>(OpacityClass::TriangleTransparent);
+  constexpr auto MIXED_CLASS = static_cast<std::uint32_t>(OpacityClass::TriangleMixed);
+
+  /** A MASK_SIZE x MASK_SIZE mask with the columns left of splitColumn set to leftAlpha and the others to rightAlpha. */
+  AlphaMask CreateSplitMask(std::int64_t splitColumn, std::uint8_t leftAlpha, std::uint8_t rightAlpha)
+  {
+    std::vector<std::uint8_t> alpha(static_cast<std::size_t>(MASK_SIZE * MASK_SIZE));
+    for (std::int64_t y = 0; y < MASK_SIZE; ++y) {
+      for (std::int64_t x = 0; x < MASK_SIZE; ++x) { alpha[static_cast<std::size_t>(y * MASK_SIZE + x)] = x < splitColumn ? leftAlpha : rightAlpha; }
+    }
+    return CreateAlphaMask(MASK_SIZE, MASK_SIZE, std::move(alpha));
+  }
+
+  /** A triangle given in texel space (texel centers at integer coordinates) converted to texture coordinates. */
+  std::array<glm::vec2, 3> TexelTriangle(float x0, float y0, float x1, float y1)
+  {
+    auto toUV = [](float x, float y) { return glm::vec2{(x + 0.5f) / static_cast<float>(MASK_SIZE), (y + 0.5f) / static_cast<float>(MASK_SIZE)}; };
+    return {toUV(x0, y0), toUV(x1, y0), toUV(x0, y1)};
+  }
+}
+
+TEST_CASE("Alpha masks are classified as a whole", "[triangle_opacity]")
+{
+  REQUIRE(CreateSplitMask(MASK_SIZE, 255, 255).m_textureClass == OPAQUE_CLASS);
+  REQUIRE(CreateSplitMask(MASK_SIZE, 0, 0).m_textureClass == TRANSPARENT_CLASS);
+  REQUIRE(CreateSplitMask(MASK_SIZE / 2, 255, 0).m_textureClass == MIXED_CLASS);
+  // alpha that block compression may round to 0 is neither opaque nor transparent.
+  REQUIRE(CreateSplitMask(MASK_SIZE, 8, 8).m_textureClass == MIXED_CLASS);
+}
+
+TEST_CASE("Triangles on uniform masks get the class of the mask", "[triangle_opacity]")
+{
+  const auto opaqueMask = CreateSplitMask(MASK_SIZE, 255, 255);
+  const auto transparentMask = CreateSplitMask(MASK_SIZE, 0, 0);
+  for (const auto& triangle : {TexelTriangle(2.0f, 2.0f, 5.0f, 5.0f), TexelTriangle(-40.0f, -40.0f, 90.0f, 90.0f), TexelTriangle(7.0f, 7.0f, 7.0f, 7.0f)}) {
+    REQUIRE(ClassifyTriangle(opaqueMask, triangle) == OPAQUE_CLASS);
+    REQUIRE(ClassifyTriangle(transparentMask, triangle) == TRANSPARENT_CLASS);
+  }
+}
+
+TEST_CASE("Triangles are classified by the texels of their footprint", "[triangle_opacity]")
+{
+  // columns 0 to 7 opaque, 8 to 15 transparent.
+  const auto mask = CreateSplitMask(MASK_SIZE / 2, 255, 0);
+
+  SECTION("footprints inside one half")
+  {
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(2.0f, 2.0f, 5.0f, 5.0f)) == OPAQUE_CLASS);
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(10.0f, 2.0f, 13.0f, 5.0f)) == TRANSPARENT_CLASS);
+  }
+
+  SECTION("footprints crossing the edge")
+  {
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(4.0f, 4.0f, 11.0f, 11.0f)) == MIXED_CLASS);
+  }
+
+  SECTION("the bilinear filter reaches one texel beyond the footprint")
+  {
+    // the footprints stay within the area of opaque (or transparent) texels, the filter also reads the neighbouring column.
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(5.0f, 2.0f, 7.2f, 5.0f)) == MIXED_CLASS);
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(7.8f, 2.0f, 12.0f, 5.0f)) == MIXED_CLASS);
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(9.0f, 2.0f, 12.0f, 5.0f)) == TRANSPARENT_CLASS);
+  }
+
+  SECTION("degenerate triangles")
+  {
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(3.0f, 3.0f, 3.0f, 3.0f)) == OPAQUE_CLASS);
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(7.5f, 3.0f, 7.5f, 3.0f)) == MIXED_CLASS);
+  }
+
+  SECTION("texture coordinates wrap around")
+  {
+    const auto shift = static_cast<float>(MASK_SIZE);
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(2.0f + shift, 2.0f - shift, 5.0f + shift, 5.0f - shift)) == OPAQUE_CLASS);
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(10.0f - shift, 2.0f, 13.0f - shift, 5.0f)) == TRANSPARENT_CLASS);
+    // column 0 is next to the transparent column 15.
+    REQUIRE(ClassifyTriangle(mask, TexelTriangle(0.0f, 2.0f, 2.0f, 5.0f)) == MIXED_CLASS);
+  }
+}
+
+TEST_CASE("Heavily tiled triangles get the class of the whole mask", "[triangle_opacity]")
+{
+  const auto mask = CreateSplitMask(MASK_SIZE / 2, 255, 0);
+  const auto tiles = 4.0f * static_cast<float>(MASK_SIZE);
+  REQUIRE(ClassifyTriangle(mask, TexelTriangle(2.0f, 2.0f, 2.0f + tiles, 2.0f + tiles)) == MIXED_CLASS);
+}